@@ -8,6 +8,7 @@
  * 
  */
 
+#include <cmath>
 #include "Backend/AnalysisTypes.hpp"
 
 namespace GeneralDeriver::Backend {
@@ -25,6 +26,12 @@ namespace GeneralDeriver::Backend {
             return Precedence::neg;
         case Syntax::AstOpType::power:
             return Precedence::power;
+        case Syntax::AstOpType::sin:
+        case Syntax::AstOpType::cos:
+        case Syntax::AstOpType::exp:
+        case Syntax::AstOpType::ln:
+        case Syntax::AstOpType::sqrt:
+            return Precedence::call;
         case Syntax::AstOpType::none:
         default:
             return Precedence::identity;
@@ -74,6 +81,41 @@ namespace GeneralDeriver::Backend {
         return {lhs.getScalarOptional().value() - rhs.getScalarOptional().value()};
     }
 
+    FoldResult operator*(const FoldResult& lhs, const FoldResult& rhs) {
+        auto left_tag = lhs.getFoldType();
+        auto right_tag = rhs.getFoldType();
+
+        if (left_tag == FoldType::invalid || right_tag == FoldType::invalid) {
+            return {};
+        }
+
+        if (left_tag == FoldType::symbolic || right_tag == FoldType::symbolic) {
+            return {SymbolicOpt {}};
+        }
+
+        return {lhs.getScalarOptional().value() * rhs.getScalarOptional().value()};
+    }
+
+    /// @note Division by a folded 0 is undefined for every x, even with a symbolic dividend.
+    FoldResult operator/(const FoldResult& lhs, const FoldResult& rhs) {
+        auto left_tag = lhs.getFoldType();
+        auto right_tag = rhs.getFoldType();
+
+        if (left_tag == FoldType::invalid || right_tag == FoldType::invalid) {
+            return {};
+        }
+
+        if (right_tag == FoldType::number && rhs.getScalarOptional().value() == 0.0) {
+            return {};
+        }
+
+        if (left_tag == FoldType::symbolic || right_tag == FoldType::symbolic) {
+            return {SymbolicOpt {}};
+        }
+
+        return {lhs.getScalarOptional().value() / rhs.getScalarOptional().value()};
+    }
+
     FoldResult doNegate(const FoldResult& target) {
         switch (target.getFoldType()) {
             case FoldType::number:
@@ -107,9 +149,47 @@ namespace GeneralDeriver::Backend {
         return {std::pow(base, exp)};
     }
 
+    FoldResult doFunction(Syntax::AstOpType op, const FoldResult& target) {
+        if (target.getFoldType() != FoldType::number) {
+            return (target.getFoldType() == FoldType::symbolic) ? FoldResult {SymbolicOpt {}} : FoldResult {};
+        }
+
+        auto arg = target.getScalarOptional().value();
+        double result = 0.0;
+
+        switch (op) {
+            case Syntax::AstOpType::sin:
+                result = std::sin(arg);
+                break;
+            case Syntax::AstOpType::cos:
+                result = std::cos(arg);
+                break;
+            case Syntax::AstOpType::exp:
+                result = std::exp(arg);
+                break;
+            case Syntax::AstOpType::ln:
+                result = std::log(arg);
+                break;
+            case Syntax::AstOpType::sqrt:
+                result = std::sqrt(arg);
+                break;
+            default:
+                return {};
+        }
+
+        /// @note ln of non-positives, sqrt of negatives and overflowing exp all leave the real numbers.
+        if (!std::isfinite(result)) {
+            return {};
+        }
+
+        return {result};
+    }
+
     FoldResult computeOp(Syntax::AstOpType op, const FoldResult& target) {
         if (op == Syntax::AstOpType::neg) {
             return doNegate(target);
+        } else if (Syntax::isFunctionOp(op)) {
+            return doFunction(op, target);
         }
 
         return {};
@@ -121,6 +201,10 @@ namespace GeneralDeriver::Backend {
                 return lhs + rhs;
             case Syntax::AstOpType::sub:
                 return lhs - rhs;
+            case Syntax::AstOpType::mul:
+                return lhs * rhs;
+            case Syntax::AstOpType::div:
+                return lhs / rhs;
             case Syntax::AstOpType::power:
                 return doPower(lhs, rhs);
             default:
@@ -14,77 +14,90 @@
 #include "Syntax/IAstNode.hpp"
 
 namespace GeneralDeriver::Backend {
-    AstValidator::AstValidator()
-    : values {}, ops {} {}
+    using Syntax::AstNodeType;
 
-    AstValidator::OpStatus AstValidator::doStackOp() {
-        if (ops.empty()) {
-            return OpStatus::done;
-        }
-
-        Syntax::AstOpType operation = ops.top();
-        ops.pop();
+    AstValidator::AstValidator() {}
 
-        FoldResult top = values.top();
-        values.pop();
+    FoldResult AstValidator::checkNode(const Syntax::IAstNode& node) const {
+        switch (node.getType()) {
+        case AstNodeType::unary: {
+            const auto& unary = static_cast<const Syntax::Unary&>(node);
 
-        if (operation == Syntax::AstOpType::neg) {
-            values.push(computeOp(operation, top));
-            return OpStatus::ok;
+            return computeOp(unary.getOp(), checkNode(*unary.getInnerPtr()));
         }
+        case AstNodeType::binary: {
+            const auto& binary = static_cast<const Syntax::Binary&>(node);
+            FoldResult lhs = checkNode(*binary.getLeft());
 
-        FoldResult under_top = values.top();
-        values.pop();
+            if (lhs.getFoldType() == FoldType::invalid) {
+                return lhs;
+            }
 
-        values.push(computeOp(operation, top, under_top));
-
-        return (values.top().getFoldType() != FoldType::invalid)
-            ? OpStatus::ok
-            : OpStatus::failed;
+            return computeOp(binary.getOp(), lhs, checkNode(*binary.getRight()));
+        }
+        case AstNodeType::literal:
+            if (const auto* constant = dynamic_cast<const Syntax::Constant*>(&node); constant != nullptr) {
+                return {constant->getValue()};
+            }
+
+            return {SymbolicOpt {}};
+        default:
+            return {};
+        }
     }
 
-    std::any AstValidator::visitConstant(const Syntax::Constant& node) {
-        values.push({node.getValue()});
-        return {OpStatus::ok};
-    }
+    FoldResult AstValidator::foldNode(std::unique_ptr<Syntax::IAstNode>& slot) {
+        switch (slot->getType()) {
+        case AstNodeType::unary: {
+            auto& unary = static_cast<Syntax::Unary&>(*slot);
+            FoldResult inner = foldNode(unary.getInnerPtr());
+            FoldResult folded = computeOp(unary.getOp(), inner);
 
-    std::any AstValidator::visitVarStub([[maybe_unused]] const Syntax::VarStub& node) {
-        values.push({SymbolicOpt {}});
-        return {OpStatus::ok};
-    }
+            if (folded.getFoldType() == FoldType::symbolic) {
+                rewriteConstant(unary.getInnerPtr(), inner);
+            }
 
-    std::any AstValidator::visitUnary(const Syntax::Unary& node) {
-        ops.push(node.getOp());
+            return folded;
+        }
+        case AstNodeType::binary: {
+            auto& binary = static_cast<Syntax::Binary&>(*slot);
+            FoldResult lhs = foldNode(binary.getLeft());
 
-        node.getInnerPtr()->acceptVisitor(*this);
+            if (lhs.getFoldType() == FoldType::invalid) {
+                return lhs;
+            }
 
-        return doStackOp();
-    }
+            FoldResult rhs = foldNode(binary.getRight());
+            FoldResult folded = computeOp(binary.getOp(), lhs, rhs);
+
+            if (folded.getFoldType() == FoldType::symbolic) {
+                rewriteConstant(binary.getLeft(), lhs);
+                rewriteConstant(binary.getRight(), rhs);
+            }
 
-    /// @note This visits operands in proper order given the power expression `base^power` must simplify power first & the stack is LIFO. Thus, visiting right then left will correctly give `(op_power, base, power)` in the later `doStackOp` call. However, commutative operations are ok to evaluate either way.
-    std::any AstValidator::visitBinary(const Syntax::Binary& node) {
-        auto op = node.getOp();
-        ops.push(op);
-
-        if (op == Syntax::AstOpType::power) {
-            node.getRight()->acceptVisitor(*this);
-            node.getLeft()->acceptVisitor(*this);
-        } else {
-            node.getLeft()->acceptVisitor(*this);
-            node.getRight()->acceptVisitor(*this);
+            return folded;
         }
+        default:
+            return checkNode(*slot);
+        }
+    }
 
-        return doStackOp();
+    void AstValidator::rewriteConstant(std::unique_ptr<Syntax::IAstNode>& slot, const FoldResult& folded) {
+        if (folded.getFoldType() == FoldType::number && slot->getType() != AstNodeType::literal) {
+            slot = std::make_unique<Syntax::Constant>(folded.getScalarOptional().value());
+        }
     }
 
-    bool AstValidator::validateAst(const std::unique_ptr<Syntax::IAstNode>& root) {
-        return std::any_cast<AstValidator::OpStatus>(root->acceptVisitor(*this)) != AstValidator::OpStatus::failed;
+    bool AstValidator::validateAst(const std::unique_ptr<Syntax::IAstNode>& root) const {
+        return checkNode(*root).getFoldType() != FoldType::invalid;
     }
 
-    void AstValidator::clearState() {
-        std::stack<Syntax::AstOpType> temp;
-        ops.swap(temp);
-        std::stack<FoldResult> temp_2;
-        values.swap(temp_2);
+    bool AstValidator::foldAst(std::unique_ptr<Syntax::IAstNode>& root) {
+        FoldResult folded = foldNode(root);
+        rewriteConstant(root, folded);
+
+        return folded.getFoldType() != FoldType::invalid;
     }
-}
\ No newline at end of file
+
+    void AstValidator::clearState() {}
+}
@@ -0,0 +1,930 @@
+/**
+ * @file EGraphOptimizer.cpp
+ * @author DrkWithT
+ * @brief Implements equality saturation over function models with cost-based extraction.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <optional>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+#include "Backend/EGraphOptimizer.hpp"
+#include "Models/Composite.hpp"
+#include "Models/Constant.hpp"
+#include "Models/Identity.hpp"
+#include "Models/IntPower.hpp"
+#include "Models/PolyAlgebra.hpp"
+#include "Models/Polynomial.hpp"
+#include "Models/RationalFunction.hpp"
+#include "Models/Variable.hpp"
+
+namespace GeneralDeriver::Backend {
+    using Models::FunctionAny;
+    using Models::IFunction;
+    using Models::FuncType;
+    using Models::PolynomialTerm;
+    using ClassId = std::uint32_t;
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::int32_t max_merged_exponent = 1024;
+    static constexpr double factor_tolerance = 1e-12;
+    static constexpr double min_node_cost = 1e-9; // keeps every op strictly costlier than its operands, so extraction never picks a cycle
+
+    enum class ENodeOp : std::uint8_t {
+        constant,   // payload: value bits
+        variable,   // payload: slot
+        polynomial, // payload: polynomial pool index
+        opaque,     // payload: opaque leaf pool index
+        add,
+        sub,
+        mul,
+        div,
+        power,
+        int_power,  // payload: exponent
+        neg,
+        sin,
+        cos,
+        exp,
+        ln,
+        sqrt
+    };
+
+    struct ENode {
+        ENodeOp op;
+        ClassId lhs;
+        ClassId rhs;
+        std::int64_t payload;
+
+        [[nodiscard]] bool operator==(const ENode& other) const = default;
+    };
+
+    struct ENodeHash {
+        [[nodiscard]] std::size_t operator()(const ENode& node) const {
+            std::size_t seed = static_cast<std::size_t>(node.op);
+
+            for (std::size_t part : {static_cast<std::size_t>(node.lhs), static_cast<std::size_t>(node.rhs), static_cast<std::size_t>(node.payload)}) {
+                seed ^= part + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+            }
+
+            return seed;
+        }
+    };
+
+    [[nodiscard]] static bool isLeafOp(ENodeOp op) {
+        return op == ENodeOp::constant || op == ENodeOp::variable || op == ENodeOp::polynomial || op == ENodeOp::opaque;
+    }
+
+    [[nodiscard]] static bool isBinaryOp(ENodeOp op) {
+        return op == ENodeOp::add || op == ENodeOp::sub || op == ENodeOp::mul || op == ENodeOp::div || op == ENodeOp::power;
+    }
+
+    [[nodiscard]] static std::optional<ENodeOp> getENodeOp(Syntax::AstOpType op) {
+        switch (op) {
+        case Syntax::AstOpType::add:
+            return ENodeOp::add;
+        case Syntax::AstOpType::sub:
+            return ENodeOp::sub;
+        case Syntax::AstOpType::mul:
+            return ENodeOp::mul;
+        case Syntax::AstOpType::div:
+            return ENodeOp::div;
+        case Syntax::AstOpType::power:
+            return ENodeOp::power;
+        case Syntax::AstOpType::neg:
+            return ENodeOp::neg;
+        case Syntax::AstOpType::sin:
+            return ENodeOp::sin;
+        case Syntax::AstOpType::cos:
+            return ENodeOp::cos;
+        case Syntax::AstOpType::exp:
+            return ENodeOp::exp;
+        case Syntax::AstOpType::ln:
+            return ENodeOp::ln;
+        case Syntax::AstOpType::sqrt:
+            return ENodeOp::sqrt;
+        default:
+            return {};
+        }
+    }
+
+    [[nodiscard]] static Syntax::AstOpType getAstOp(ENodeOp op) {
+        switch (op) {
+        case ENodeOp::add:
+            return Syntax::AstOpType::add;
+        case ENodeOp::sub:
+            return Syntax::AstOpType::sub;
+        case ENodeOp::mul:
+            return Syntax::AstOpType::mul;
+        case ENodeOp::div:
+            return Syntax::AstOpType::div;
+        case ENodeOp::power:
+            return Syntax::AstOpType::power;
+        case ENodeOp::neg:
+            return Syntax::AstOpType::neg;
+        case ENodeOp::sin:
+            return Syntax::AstOpType::sin;
+        case ENodeOp::cos:
+            return Syntax::AstOpType::cos;
+        case ENodeOp::exp:
+            return Syntax::AstOpType::exp;
+        case ENodeOp::ln:
+            return Syntax::AstOpType::ln;
+        case ENodeOp::sqrt:
+        default:
+            return Syntax::AstOpType::sqrt;
+        }
+    }
+
+    [[nodiscard]] static ENode makeConstantNode(double value) {
+        return {ENodeOp::constant, 0, 0, std::bit_cast<std::int64_t>(value)};
+    }
+
+    [[nodiscard]] static double getConstantPayload(const ENode& node) {
+        return std::bit_cast<double>(node.payload);
+    }
+
+    /// @note Counts the multiplies `raiseToInteger` does: one squaring per bit plus one per set bit.
+    [[nodiscard]] static double getIntPowerSteps(std::int64_t exponent) {
+        const auto magnitude = static_cast<std::uint64_t>((exponent < 0) ? -exponent : exponent);
+
+        return static_cast<double>(std::bit_width(magnitude) + std::popcount(magnitude));
+    }
+
+    /// @note Only 2^k divisors have exact reciprocals, so only those may turn a division into a multiplication.
+    [[nodiscard]] static bool hasExactReciprocal(double value) {
+        int exponent = 0;
+
+        return value != 0.0 && std::isfinite(value) && std::fabs(std::frexp(value, &exponent)) == 0.5;
+    }
+
+    /**
+     * @brief E-graph over function nodes: union-find e-classes, a hash-cons of canonical e-nodes, and a constant value per e-class for folding.
+     * @note Rebuilding re-hashes every e-node until no two e-classes hold the same one, which restores congruence after a round of merges in one simple loop.
+     */
+    class EGraph {
+    private:
+        struct EClass {
+            std::vector<ENode> nodes;
+            std::optional<double> constant;
+        };
+
+        std::vector<ClassId> parents;
+        std::vector<EClass> classes;
+        std::unordered_map<ENode, ClassId, ENodeHash> memo;
+        std::unordered_map<const IFunction*, ClassId> visited;
+        std::unordered_map<std::int64_t, FunctionAny> variable_leaves;
+        std::vector<FunctionAny> opaque_leaves;
+        std::vector<double> opaque_costs;
+        std::vector<Models::Polynomial> polys;
+        std::vector<bool> polys_factored;
+        std::map<std::vector<double>, std::uint32_t> poly_ids;
+        std::vector<double> class_costs;
+        std::vector<ENode> best_nodes;
+        const OpCosts& costs;
+        std::size_t node_count;
+
+        [[nodiscard]] ENode canonicalize(ENode node) {
+            if (!isLeafOp(node.op)) {
+                node.lhs = find(node.lhs);
+                node.rhs = isBinaryOp(node.op) ? find(node.rhs) : 0;
+            }
+
+            return node;
+        }
+
+        [[nodiscard]] std::optional<double> foldConstant(const ENode& node) {
+            if (node.op == ENodeOp::constant) {
+                return getConstantPayload(node);
+            } else if (isLeafOp(node.op)) {
+                return {};
+            }
+
+            const auto lhs = getConstant(node.lhs);
+            const auto rhs = isBinaryOp(node.op) ? getConstant(node.rhs) : std::optional<double> {0.0};
+
+            if (!lhs || !rhs) {
+                return {};
+            }
+
+            double result = 0.0;
+
+            switch (node.op) {
+            case ENodeOp::add:
+                result = *lhs + *rhs;
+                break;
+            case ENodeOp::sub:
+                result = *lhs - *rhs;
+                break;
+            case ENodeOp::mul:
+                result = *lhs * *rhs;
+                break;
+            case ENodeOp::div:
+                result = *lhs / *rhs;
+                break;
+            case ENodeOp::power:
+                result = std::pow(*lhs, *rhs);
+                break;
+            case ENodeOp::int_power:
+                result = Models::raiseToInteger(*lhs, static_cast<std::int32_t>(node.payload));
+                break;
+            case ENodeOp::neg:
+                result = -*lhs;
+                break;
+            case ENodeOp::sin:
+                result = std::sin(*lhs);
+                break;
+            case ENodeOp::cos:
+                result = std::cos(*lhs);
+                break;
+            case ENodeOp::exp:
+                result = std::exp(*lhs);
+                break;
+            case ENodeOp::ln:
+                result = std::log(*lhs);
+                break;
+            case ENodeOp::sqrt:
+            default:
+                result = std::sqrt(*lhs);
+                break;
+            }
+
+            // Like the validator, never fold into values evaluation could not give back as a constant.
+            if (!std::isfinite(result)) {
+                return {};
+            }
+
+            return result;
+        }
+
+        [[nodiscard]] double getNodeCost(const ENode& node) const {
+            switch (node.op) {
+            case ENodeOp::constant:
+                // Composites read constant children directly, so those cost no dispatch.
+                return 0.0;
+            case ENodeOp::variable:
+                return costs.dispatch;
+            case ENodeOp::polynomial:
+                return costs.dispatch + costs.poly_term * static_cast<double>(polys[node.payload].getTermCount());
+            case ENodeOp::opaque:
+                return opaque_costs[node.payload];
+            case ENodeOp::add:
+            case ENodeOp::sub:
+            case ENodeOp::neg:
+                return costs.dispatch + costs.add;
+            case ENodeOp::mul:
+                return costs.dispatch + costs.mul;
+            case ENodeOp::div:
+                return costs.dispatch + costs.div;
+            case ENodeOp::power:
+                return costs.dispatch + costs.pow;
+            case ENodeOp::int_power:
+                return costs.dispatch + costs.int_power_step * getIntPowerSteps(node.payload) + ((node.payload < 0) ? costs.div : 0.0);
+            case ENodeOp::sin:
+                return costs.dispatch + costs.sin;
+            case ENodeOp::cos:
+                return costs.dispatch + costs.cos;
+            case ENodeOp::exp:
+                return costs.dispatch + costs.exp;
+            case ENodeOp::ln:
+                return costs.dispatch + costs.ln;
+            case ENodeOp::sqrt:
+            default:
+                return costs.dispatch + costs.sqrt;
+            }
+        }
+
+        [[nodiscard]] ClassId addVariable(std::int64_t slot, const FunctionAny& leaf) {
+            variable_leaves.try_emplace(slot, leaf);
+
+            return add({ENodeOp::variable, 0, 0, slot});
+        }
+
+        [[nodiscard]] ClassId addOpaque(const FunctionAny& leaf) {
+            const IFunction* leaf_ptr = leaf.getStoragePtr();
+            double cost = costs.dispatch + costs.opaque;
+
+            if (leaf_ptr->getType() == FuncType::rational_function) {
+                const auto* quotient = static_cast<const Models::RationalFunction*>(leaf_ptr);
+                cost = costs.dispatch + costs.div + costs.poly_term * static_cast<double>(quotient->getNumerator().getTermCount() + quotient->getDenominator().getTermCount());
+            }
+
+            opaque_leaves.push_back(leaf);
+            opaque_costs.push_back(cost);
+
+            return add({ENodeOp::opaque, 0, 0, static_cast<std::int64_t>(opaque_leaves.size() - 1)});
+        }
+
+        /// @brief Adds `x^k * q` when the lowest power k is positive, and `c * (x - r)^n` when the polynomial is a perfect power of a line.
+        void factorPolynomial(const Models::Polynomial& poly, ClassId poly_class) {
+            const auto degree = Models::getDenseDegree(poly);
+
+            if (!degree || *degree < 2) {
+                return;
+            }
+
+            const auto terms = poly.getTerms();
+            const auto lowest_power = static_cast<std::int64_t>(terms.back().power);
+
+            if (lowest_power > 0) {
+                std::vector<PolynomialTerm> quotient_terms;
+
+                for (auto [coeff, power] : terms) {
+                    quotient_terms.push_back({coeff, power - static_cast<double>(lowest_power)});
+                }
+
+                const ClassId x_class = addVariable(0, Models::Identity {});
+                const ClassId x_power = (lowest_power == 1) ? x_class : add({ENodeOp::int_power, x_class, 0, lowest_power});
+                const ClassId quotient = addPolynomial(Models::Polynomial {std::move(quotient_terms)});
+
+                merge(poly_class, add({ENodeOp::mul, x_power, quotient, 0}));
+                return;
+            }
+
+            std::vector<double> coeffs(*degree + 1, 0.0);
+
+            for (auto [coeff, power] : terms) {
+                coeffs[static_cast<std::size_t>(power)] = coeff;
+            }
+
+            const double lead = coeffs.back();
+            const double shift = coeffs[*degree - 1] / (static_cast<double>(*degree) * lead);
+            const Models::Polynomial line {std::vector<PolynomialTerm> {{1.0, 1.0}, {shift, 0.0}}};
+            const auto expanded = Models::raisePolynomial(line, static_cast<unsigned int>(*degree)).getTerms();
+
+            double scale = 0.0;
+
+            for (double coeff : coeffs) {
+                scale = std::max(scale, std::fabs(coeff));
+            }
+
+            std::vector<double> expanded_coeffs(*degree + 1, 0.0);
+
+            for (auto [coeff, power] : expanded) {
+                if (power < 0.0 || power > static_cast<double>(*degree)) {
+                    return;
+                }
+
+                expanded_coeffs[static_cast<std::size_t>(power)] = coeff * lead;
+            }
+
+            for (std::size_t power = 0; power <= *degree; power++) {
+                if (std::fabs(expanded_coeffs[power] - coeffs[power]) > factor_tolerance * scale) {
+                    return;
+                }
+            }
+
+            const ClassId line_class = addPolynomial(line);
+            const ClassId powered = add({ENodeOp::int_power, line_class, 0, static_cast<std::int64_t>(*degree)});
+
+            merge(poly_class, (lead == 1.0) ? powered : add({ENodeOp::mul, add(makeConstantNode(lead)), powered, 0}));
+        }
+
+        [[nodiscard]] ClassId addPolynomial(const Models::Polynomial& poly) {
+            if (auto value = Models::getConstantValue(poly); value) {
+                return add(makeConstantNode(*value));
+            }
+
+            std::vector<double> key;
+
+            for (auto [coeff, power] : poly.getTerms()) {
+                key.push_back(coeff);
+                key.push_back(power);
+            }
+
+            auto [poly_it, inserted] = poly_ids.try_emplace(std::move(key), static_cast<std::uint32_t>(polys.size()));
+
+            if (!inserted) {
+                return add({ENodeOp::polynomial, 0, 0, poly_it->second});
+            }
+
+            polys.push_back(poly);
+            polys_factored.push_back(false);
+
+            return add({ENodeOp::polynomial, 0, 0, poly_it->second});
+        }
+
+        void emitEquivalent(ClassId target, const ENode& node) {
+            merge(target, add(node));
+        }
+
+        void rewriteSum(ClassId self, const ENode& node) {
+            const ClassId lhs = find(node.lhs);
+            const ClassId rhs = find(node.rhs);
+            const auto lhs_value = getConstant(lhs);
+            const auto rhs_value = getConstant(rhs);
+
+            if (node.op == ENodeOp::add) {
+                emitEquivalent(self, {ENodeOp::add, rhs, lhs, 0});
+
+                if (lhs_value == 0.0) {
+                    merge(self, rhs);
+                }
+
+                if (lhs == rhs) {
+                    emitEquivalent(self, {ENodeOp::mul, add(makeConstantNode(2.0)), lhs, 0});
+                }
+            }
+
+            if (rhs_value == 0.0) {
+                merge(self, lhs);
+            }
+
+            const auto lhs_nodes = classes[lhs].nodes;
+            const auto rhs_nodes = classes[rhs].nodes;
+
+            for (const auto& rhs_node : rhs_nodes) {
+                if (rhs_node.op == ENodeOp::neg) {
+                    // a + -b is a - b, and a - -b is a + b.
+                    emitEquivalent(self, {(node.op == ENodeOp::add) ? ENodeOp::sub : ENodeOp::add, lhs, rhs_node.lhs, 0});
+                } else if (node.op == ENodeOp::add && rhs_node.op == ENodeOp::add) {
+                    emitEquivalent(self, {ENodeOp::add, add({ENodeOp::add, lhs, rhs_node.lhs, 0}), rhs_node.rhs, 0});
+                }
+            }
+
+            // a * b +- a * c is a * (b +- c), which saves the shared factor's evaluation.
+            for (const auto& lhs_node : lhs_nodes) {
+                if (lhs_node.op != ENodeOp::mul) {
+                    continue;
+                }
+
+                for (const auto& rhs_node : rhs_nodes) {
+                    if (rhs_node.op == ENodeOp::mul && find(lhs_node.lhs) == find(rhs_node.lhs)) {
+                        emitEquivalent(self, {ENodeOp::mul, lhs_node.lhs, add({node.op, lhs_node.rhs, rhs_node.rhs, 0}), 0});
+                    }
+                }
+            }
+        }
+
+        void rewriteProduct(ClassId self, const ENode& node) {
+            const ClassId lhs = find(node.lhs);
+            const ClassId rhs = find(node.rhs);
+            const auto rhs_value = getConstant(rhs);
+
+            emitEquivalent(self, {ENodeOp::mul, rhs, lhs, 0});
+
+            if (rhs_value == 1.0) {
+                merge(self, lhs);
+            } else if (rhs_value == -1.0) {
+                emitEquivalent(self, {ENodeOp::neg, lhs, 0, 0});
+            }
+
+            if (lhs == rhs) {
+                emitEquivalent(self, {ENodeOp::int_power, lhs, 0, 2});
+            }
+
+            const auto lhs_nodes = classes[lhs].nodes;
+            const auto rhs_nodes = classes[rhs].nodes;
+
+            for (const auto& rhs_node : rhs_nodes) {
+                if (rhs_node.op == ENodeOp::mul) {
+                    emitEquivalent(self, {ENodeOp::mul, add({ENodeOp::mul, lhs, rhs_node.lhs, 0}), rhs_node.rhs, 0});
+                }
+            }
+
+            for (const auto& lhs_node : lhs_nodes) {
+                if (lhs_node.op == ENodeOp::int_power && find(lhs_node.lhs) == rhs && lhs_node.payload < max_merged_exponent) {
+                    emitEquivalent(self, {ENodeOp::int_power, rhs, 0, lhs_node.payload + 1});
+                }
+
+                for (const auto& rhs_node : rhs_nodes) {
+                    if (lhs_node.op == ENodeOp::int_power && rhs_node.op == ENodeOp::int_power && find(lhs_node.lhs) == find(rhs_node.lhs)) {
+                        const std::int64_t exponent = lhs_node.payload + rhs_node.payload;
+
+                        if (exponent >= -max_merged_exponent && exponent <= max_merged_exponent) {
+                            emitEquivalent(self, {ENodeOp::int_power, lhs_node.lhs, 0, exponent});
+                        }
+                    } else if (lhs_node.op == ENodeOp::exp && rhs_node.op == ENodeOp::exp) {
+                        emitEquivalent(self, {ENodeOp::exp, add({ENodeOp::add, lhs_node.lhs, rhs_node.lhs, 0}), 0, 0});
+                    }
+                }
+            }
+        }
+
+        void rewriteNode(ClassId self, const ENode& node) {
+            switch (node.op) {
+            case ENodeOp::add:
+            case ENodeOp::sub:
+                rewriteSum(self, node);
+                break;
+            case ENodeOp::mul:
+                rewriteProduct(self, node);
+                break;
+            case ENodeOp::div:
+                if (auto divisor = getConstant(node.rhs); divisor && hasExactReciprocal(*divisor)) {
+                    emitEquivalent(self, {ENodeOp::mul, node.lhs, add(makeConstantNode(1.0 / *divisor)), 0});
+                }
+                break;
+            case ENodeOp::power:
+                if (auto exponent = getConstant(node.rhs); exponent && Models::isIntPowerExponent(*exponent)) {
+                    emitEquivalent(self, {ENodeOp::int_power, node.lhs, 0, static_cast<std::int64_t>(*exponent)});
+                }
+                break;
+            case ENodeOp::int_power:
+                if (node.payload == 1) {
+                    merge(self, node.lhs);
+                } else if (node.payload == 0) {
+                    merge(self, add(makeConstantNode(1.0)));
+                }
+                break;
+            case ENodeOp::polynomial:
+                if (const auto index = static_cast<std::size_t>(node.payload); !polys_factored[index]) {
+                    // The copy outlives `polys` growing while the factors go in.
+                    const Models::Polynomial poly = polys[index];
+
+                    polys_factored[index] = true;
+                    factorPolynomial(poly, self);
+                }
+                break;
+            case ENodeOp::neg: {
+                const auto inner_nodes = classes[find(node.lhs)].nodes;
+
+                for (const auto& inner : inner_nodes) {
+                    if (inner.op == ENodeOp::neg) {
+                        merge(self, inner.lhs);
+                    }
+                }
+                break;
+            }
+            default:
+                break;
+            }
+        }
+
+    public:
+        explicit EGraph(const OpCosts& costs_)
+        : parents {}, classes {}, memo {}, visited {}, variable_leaves {}, opaque_leaves {}, opaque_costs {}, polys {}, polys_factored {}, poly_ids {}, class_costs {}, best_nodes {}, costs {costs_}, node_count {0} {}
+
+        [[nodiscard]] ClassId find(ClassId id) {
+            while (parents[id] != id) {
+                parents[id] = parents[parents[id]];
+                id = parents[id];
+            }
+
+            return id;
+        }
+
+        [[nodiscard]] std::optional<double> getConstant(ClassId id) {
+            return classes[find(id)].constant;
+        }
+
+        [[nodiscard]] std::size_t getClassCount() {
+            std::size_t count = 0;
+
+            for (ClassId id = 0; id < classes.size(); id++) {
+                count += (find(id) == id) ? 1 : 0;
+            }
+
+            return count;
+        }
+
+        [[nodiscard]] std::size_t getNodeCount() const { return node_count; }
+
+        [[nodiscard]] ClassId add(ENode node) {
+            node = canonicalize(node);
+
+            if (auto found = memo.find(node); found != memo.end()) {
+                return find(found->second);
+            }
+
+            const auto id = static_cast<ClassId>(classes.size());
+            const auto value = foldConstant(node);
+
+            parents.push_back(id);
+            classes.push_back({{node}, value});
+            memo.emplace(node, id);
+            node_count++;
+
+            if (value && node.op != ENodeOp::constant) {
+                merge(id, add(makeConstantNode(*value)));
+            }
+
+            return find(id);
+        }
+
+        bool merge(ClassId lhs, ClassId rhs) {
+            lhs = find(lhs);
+            rhs = find(rhs);
+
+            if (lhs == rhs) {
+                return false;
+            }
+
+            if (classes[lhs].nodes.size() < classes[rhs].nodes.size()) {
+                std::swap(lhs, rhs);
+            }
+
+            parents[rhs] = lhs;
+
+            auto& kept = classes[lhs];
+            auto& gone = classes[rhs];
+            kept.nodes.insert(kept.nodes.end(), gone.nodes.begin(), gone.nodes.end());
+            gone.nodes.clear();
+            gone.nodes.shrink_to_fit();
+
+            if (!kept.constant && gone.constant) {
+                kept.constant = gone.constant;
+                kept.nodes.push_back(makeConstantNode(*kept.constant));
+            }
+
+            return true;
+        }
+
+        /// @brief Restores the hash-cons invariants after merges. Gives whether congruence merged any e-classes.
+        bool rebuild() {
+            bool merged_any = false;
+            std::vector<std::pair<ClassId, ClassId>> congruent;
+
+            do {
+                congruent.clear();
+                memo.clear();
+                node_count = 0;
+
+                for (ClassId id = 0; id < classes.size(); id++) {
+                    if (find(id) != id) {
+                        continue;
+                    }
+
+                    auto& nodes = classes[id].nodes;
+
+                    for (auto& node : nodes) {
+                        node = canonicalize(node);
+                    }
+
+                    std::sort(nodes.begin(), nodes.end(), [](const ENode& lhs, const ENode& rhs) {
+                        return std::tie(lhs.op, lhs.lhs, lhs.rhs, lhs.payload) < std::tie(rhs.op, rhs.lhs, rhs.rhs, rhs.payload);
+                    });
+                    nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+                    node_count += nodes.size();
+
+                    for (const auto& node : nodes) {
+                        if (auto [memo_it, inserted] = memo.try_emplace(node, id); !inserted && memo_it->second != id) {
+                            congruent.emplace_back(memo_it->second, id);
+                        }
+                    }
+                }
+
+                for (auto [lhs, rhs] : congruent) {
+                    merged_any |= merge(lhs, rhs);
+                }
+            } while (!congruent.empty());
+
+            return merged_any;
+        }
+
+        /// @note Shared handles map to one e-class, so DAG inputs cost their distinct nodes only.
+        [[nodiscard]] ClassId addFunction(const FunctionAny& fn) {
+            const IFunction* fn_ptr = fn.getStoragePtr();
+
+            if (fn_ptr == nullptr) {
+                return add(makeConstantNode(0.0));
+            }
+
+            if (auto found = visited.find(fn_ptr); found != visited.end()) {
+                return find(found->second);
+            }
+
+            ClassId result = 0;
+
+            if (const auto* composite = dynamic_cast<const Models::Composite*>(fn_ptr); composite != nullptr) {
+                const auto op = getENodeOp(composite->getOp());
+
+                if (composite->getArity() == Models::CompositeArity::invalid) {
+                    // Same reading as `Tape`, which flattens an empty Composite to the constant 0.
+                    result = add(makeConstantNode(0.0));
+                } else if (!op) {
+                    result = addFunction(composite->getLeft());
+                } else if (composite->getArity() == Models::CompositeArity::unary) {
+                    result = add({*op, addFunction(composite->getLeft()), 0, 0});
+                } else {
+                    const ClassId lhs = addFunction(composite->getLeft());
+                    result = add({*op, lhs, addFunction(composite->getRight()), 0});
+                }
+            } else if (const auto* poly = dynamic_cast<const Models::Polynomial*>(fn_ptr); poly != nullptr) {
+                result = addPolynomial(*poly);
+            } else if (fn_ptr->getType() == FuncType::constant) {
+                result = add(makeConstantNode(static_cast<const Models::Constant*>(fn_ptr)->getValue()));
+            } else if (fn_ptr->getType() == FuncType::identity) {
+                result = addVariable(0, fn);
+            } else if (fn_ptr->getType() == FuncType::variable) {
+                result = addVariable(static_cast<std::int64_t>(static_cast<const Models::Variable*>(fn_ptr)->getSlot()), fn);
+            } else if (fn_ptr->getType() == FuncType::int_power) {
+                const auto* power = static_cast<const Models::IntPower*>(fn_ptr);
+                result = add({ENodeOp::int_power, addFunction(power->getBase()), 0, power->getExponent()});
+            } else {
+                result = addOpaque(fn);
+            }
+
+            visited.emplace(fn_ptr, result);
+
+            return find(result);
+        }
+
+        /// @brief Runs every rule once over the e-classes present at the start. Gives false when the deadline or node limit cut the round short.
+        bool applyRules(Clock::time_point deadline, std::size_t max_nodes) {
+            const auto class_count = static_cast<ClassId>(classes.size());
+
+            for (ClassId id = 0; id < class_count; id++) {
+                if (node_count >= max_nodes || Clock::now() >= deadline) {
+                    return false;
+                }
+
+                if (find(id) != id) {
+                    continue;
+                }
+
+                const auto nodes = classes[id].nodes;
+
+                for (const auto& node : nodes) {
+                    rewriteNode(find(id), node);
+                }
+            }
+
+            return true;
+        }
+
+        /// @brief Finds the cheapest e-node per e-class by relaxing costs until none improves. Gives the root's cost.
+        double computeBestNodes(ClassId root) {
+            constexpr double unreached = std::numeric_limits<double>::infinity();
+
+            class_costs.assign(classes.size(), unreached);
+            best_nodes.assign(classes.size(), makeConstantNode(0.0));
+
+            bool improved = true;
+
+            while (improved) {
+                improved = false;
+
+                for (ClassId id = 0; id < classes.size(); id++) {
+                    if (find(id) != id) {
+                        continue;
+                    }
+
+                    for (const auto& node : classes[id].nodes) {
+                        double total = getNodeCost(node) + min_node_cost;
+
+                        if (!isLeafOp(node.op)) {
+                            total += class_costs[find(node.lhs)];
+                            total += isBinaryOp(node.op) ? class_costs[find(node.rhs)] : 0.0;
+                        }
+
+                        if (total < class_costs[id]) {
+                            class_costs[id] = total;
+                            best_nodes[id] = node;
+                            improved = true;
+                        }
+                    }
+                }
+            }
+
+            return class_costs[find(root)];
+        }
+
+        /// @note Call after `computeBestNodes`. Each e-class becomes one function object, shared by every handle to it.
+        [[nodiscard]] FunctionAny buildBest(ClassId id, std::unordered_map<ClassId, FunctionAny>& built) {
+            id = find(id);
+
+            if (auto found = built.find(id); found != built.end()) {
+                return found->second;
+            }
+
+            const ENode node = best_nodes[id];
+            FunctionAny result;
+
+            switch (node.op) {
+            case ENodeOp::constant:
+                result = Models::Constant {getConstantPayload(node)};
+                break;
+            case ENodeOp::variable:
+                result = variable_leaves.at(node.payload);
+                break;
+            case ENodeOp::polynomial:
+                result = polys[node.payload];
+                break;
+            case ENodeOp::opaque:
+                result = opaque_leaves[node.payload];
+                break;
+            case ENodeOp::int_power:
+                result = Models::IntPower {buildBest(node.lhs, built), static_cast<std::int32_t>(node.payload)};
+                break;
+            default:
+                if (isBinaryOp(node.op)) {
+                    const FunctionAny lhs = buildBest(node.lhs, built);
+                    result = Models::Composite {getAstOp(node.op), lhs, buildBest(node.rhs, built)};
+                } else {
+                    result = Models::Composite {getAstOp(node.op), buildBest(node.lhs, built), {}};
+                }
+                break;
+            }
+
+            built.emplace(id, result);
+
+            return result;
+        }
+    };
+
+    /// @note Keeps the compiler from dropping timed loops whose results go unused.
+    static volatile double measure_sink = 0.0;
+
+    /// @brief Times a chain where each op waits on the previous result, since tree evaluation is bound by such chains rather than by throughput.
+    template <typename OpFn>
+    [[nodiscard]] static double timeChain(std::size_t length, double seed, OpFn&& op_fn) {
+        double value = seed;
+        const auto start = Clock::now();
+
+        for (std::size_t i = 0; i < length; i++) {
+            value = op_fn(value);
+        }
+
+        const auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        measure_sink = value;
+
+        return std::max(elapsed / static_cast<double>(length), min_node_cost);
+    }
+
+    OpCosts measureOpCosts() {
+        constexpr std::size_t chain_length = 1 << 15;
+        constexpr std::int32_t probe_exponent = 255;
+        constexpr std::size_t probe_terms = 16;
+
+        const FunctionAny identity = Models::Identity {};
+        const IFunction* identity_ptr = identity.getStoragePtr();
+        const Models::Polynomial probe_poly = Models::Polynomial::fromDense(std::vector<double>(probe_terms, 0.5));
+
+        // Each chain step keeps its value in a tame range. Steps needing an extra add or mul to do so get that op's time taken off.
+        OpCosts measured;
+        measured.add = timeChain(chain_length, 1.0, [](double x) { return x + 1e-9; });
+        measured.mul = timeChain(chain_length, 1.0, [](double x) { return x * 0.9999999; });
+
+        const auto without = [](double total, double helper) { return std::max(total - helper, min_node_cost); };
+
+        measured.dispatch = timeChain(chain_length, 0.5, [identity_ptr](double x) { return identity_ptr->evalAt(x); });
+        measured.div = timeChain(chain_length, 1.0, [](double x) { return 1.0000001 / x; });
+        measured.pow = timeChain(chain_length, 2.0, [](double x) { return std::pow(x, 0.999); });
+        measured.int_power_step = timeChain(chain_length, 1.0, [](double x) { return Models::raiseToInteger(x, probe_exponent); }) / getIntPowerSteps(probe_exponent);
+        measured.poly_term = without(timeChain(chain_length, 0.5, [&probe_poly](double x) { return probe_poly.evalAt(x) * 0.5; }), measured.mul) / static_cast<double>(probe_terms);
+        measured.sin = timeChain(chain_length, 1.0, [](double x) { return std::sin(x); });
+        measured.cos = timeChain(chain_length, 1.0, [](double x) { return std::cos(x); });
+        measured.exp = timeChain(chain_length, 0.5, [](double x) { return std::exp(-x); });
+        measured.ln = without(timeChain(chain_length, 1.0, [](double x) { return std::log(x + 2.0); }), measured.add);
+        measured.sqrt = without(timeChain(chain_length, 1.0, [](double x) { return std::sqrt(x + 1.0); }), measured.add);
+
+        return measured;
+    }
+
+    EGraphOptimizer::EGraphOptimizer()
+    : options {} {}
+
+    EGraphOptimizer::EGraphOptimizer(const EGraphOptions& options_)
+    : options {options_} {}
+
+    OptimizeResult EGraphOptimizer::optimize(const FunctionAny& fn) const {
+        if (fn.getStoragePtr() == nullptr) {
+            return {fn, {0, 0, 0, 0.0, 0.0, true}};
+        }
+
+        const auto deadline = Clock::now() + options.time_budget;
+        EGraph graph {options.costs};
+        const ClassId root = graph.addFunction(fn);
+        graph.rebuild();
+
+        EGraphStats stats {0, 0, 0, graph.computeBestNodes(root), 0.0, false};
+
+        while (stats.iterations < options.max_iterations) {
+            const std::size_t nodes_before = graph.getNodeCount();
+            const std::size_t classes_before = graph.getClassCount();
+
+            stats.iterations++;
+
+            const bool finished = graph.applyRules(deadline, options.max_nodes);
+            graph.rebuild();
+
+            if (!finished) {
+                break;
+            }
+
+            if (graph.getNodeCount() == nodes_before && graph.getClassCount() == classes_before) {
+                stats.saturated = true;
+                break;
+            }
+        }
+
+        stats.cost_after = graph.computeBestNodes(root);
+        stats.classes = graph.getClassCount();
+        stats.nodes = graph.getNodeCount();
+
+        std::unordered_map<ClassId, FunctionAny> built;
+
+        return {graph.buildBest(root, built), stats};
+    }
+}
@@ -0,0 +1,148 @@
+/**
+ * @file FlatPasses.cpp
+ * @author DrkWithT
+ * @brief Implements folding & function emission over flat ASTs.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <utility>
+#include "Backend/FlatPasses.hpp"
+#include "Backend/FuncEmitter.hpp"
+
+namespace GeneralDeriver::Backend {
+    using Syntax::FlatIndex;
+    using Syntax::FlatTag;
+
+    FlatValidator::FlatValidator()
+    : folds {} {}
+
+    void FlatValidator::foldNodes(const Syntax::FlatAst& ast) {
+        const std::size_t count = ast.getSize();
+
+        folds.clear();
+
+        for (FlatIndex node = 0; node < count; node++) {
+            switch (ast.getTag(node)) {
+            case FlatTag::constant:
+                folds.emplace_back(ast.getConstant(node));
+                break;
+            case FlatTag::variable:
+                folds.emplace_back(SymbolicOpt {});
+                break;
+            case FlatTag::unary:
+                folds.push_back(computeOp(ast.getOp(node), folds[ast.getLeft(node)]));
+                break;
+            case FlatTag::binary:
+                folds.push_back(computeOp(ast.getOp(node), folds[ast.getLeft(node)], folds[ast.getRight(node)]));
+                break;
+            }
+        }
+    }
+
+    bool FlatValidator::validateAst(const Syntax::FlatAst& ast) {
+        if (ast.isEmpty()) {
+            return false;
+        }
+
+        foldNodes(ast);
+
+        return folds.back().getFoldType() != FoldType::invalid;
+    }
+
+    /// @note A numeric node under a symbolic parent is the top of a constant sub-tree. Invalid folds propagate to the root, so reaching the rewrite loop means every reachable node is valid.
+    bool FlatValidator::foldAst(Syntax::FlatAst& ast) {
+        if (!validateAst(ast)) {
+            return false;
+        }
+
+        const auto root = ast.getRoot();
+
+        if (folds[root].getFoldType() == FoldType::number) {
+            ast.rewriteConstant(root, folds[root].getScalarOptional().value());
+            return true;
+        }
+
+        for (FlatIndex node = 0; node <= root; node++) {
+            const auto tag = ast.getTag(node);
+
+            if (folds[node].getFoldType() != FoldType::symbolic || (tag != FlatTag::unary && tag != FlatTag::binary)) {
+                continue;
+            }
+
+            const FlatIndex children[2] = {ast.getLeft(node), ast.getRight(node)};
+            const std::size_t child_count = (tag == FlatTag::binary) ? 2 : 1;
+
+            for (std::size_t i = 0; i < child_count; i++) {
+                const auto child = children[i];
+
+                if (folds[child].getFoldType() == FoldType::number && ast.getTag(child) != FlatTag::constant) {
+                    ast.rewriteConstant(child, folds[child].getScalarOptional().value());
+                }
+            }
+        }
+
+        return true;
+    }
+
+    FlatEmitter::FlatEmitter()
+    : parts {}, live {} {}
+
+    Models::Composite FlatEmitter::emitFunction(const Syntax::FlatAst& ast) {
+        if (ast.isEmpty()) {
+            return {};
+        }
+
+        const auto root = ast.getRoot();
+        const auto& names = ast.getVariableNames();
+
+        live.assign(ast.getSize(), 0);
+        live[root] = 1;
+
+        for (FlatIndex node = root + 1; node-- > 0;) {
+            if (!live[node]) {
+                continue;
+            }
+
+            const auto tag = ast.getTag(node);
+
+            if (tag == FlatTag::unary || tag == FlatTag::binary) {
+                live[ast.getLeft(node)] = 1;
+            }
+
+            if (tag == FlatTag::binary) {
+                live[ast.getRight(node)] = 1;
+            }
+        }
+
+        // Every live node has one parent, so parts get moved up & the buffer holds no emitted sub-functions afterwards.
+        parts.resize(ast.getSize());
+
+        for (FlatIndex node = 0; node <= root; node++) {
+            if (!live[node]) {
+                continue;
+            }
+
+            switch (ast.getTag(node)) {
+            case FlatTag::constant:
+                parts[node] = {Syntax::AstOpType::none, convertFoldResult(ast.getConstant(node)), {}};
+                break;
+            case FlatTag::variable: {
+                const auto slot = ast.getSlot(node);
+                parts[node] = emitVariable((slot < names.size()) ? names[slot] : std::string {}, slot);
+                break;
+            }
+            case FlatTag::unary:
+                parts[node] = emitNormalUnaryOp(ast.getOp(node), std::move(parts[ast.getLeft(node)]));
+                break;
+            case FlatTag::binary:
+                parts[node] = emitNormalBinaryOp(ast.getOp(node), std::move(parts[ast.getLeft(node)]), std::move(parts[ast.getRight(node)]));
+                break;
+            }
+        }
+
+        return std::move(parts[root]);
+    }
+}
@@ -3,30 +3,236 @@
  * @author DrkWithT
  * @brief Implements AST to function converter.
  * @date 2024-10-06
- * @todo Implement the emitting logic for Unary and Binary nodes. If this becomes too messy, just refactor: create AST optimizer and then redo emitter.
  * 
  * @copyright Copyright (c) 2024
  * 
  */
 
+#include <algorithm>
+#include <cmath>
+#include <optional>
 #include <utility>
 #include <vector>
 #include "Backend/AnalysisTypes.hpp"
 #include "Backend/FuncEmitter.hpp"
+#include "Models/Constant.hpp"
+#include "Models/Identity.hpp"
+#include "Models/IntPower.hpp"
 #include "Models/Polynomial.hpp"
+#include "Models/PolyAlgebra.hpp"
+#include "Models/RationalFunction.hpp"
+#include "Models/Variable.hpp"
 #include "Syntax/IAstNode.hpp"
 #include "Syntax/AstNodes.hpp"
 
 namespace GeneralDeriver::Backend {
+    static constexpr unsigned int max_sparse_power = 8; // powers of sparse or general bases grow terms fast
+    static constexpr std::size_t max_normal_terms = 1024;
+    static constexpr std::size_t max_rational_degree = 64; // Euclid's GCD on floating coefficients gets unreliable past this
+
+    /// @note Constants, x and collapsed polynomials are emitted as leaves wrapped in one or two `none` Composites, so this unwraps all of those. Constant & identity leaves convert to their polynomials.
+    static std::optional<Models::Polynomial> findPolynomialLeaf(const Models::Composite& fn) {
+        const Models::Composite* current = &fn;
+
+        while (current->getOp() == Syntax::AstOpType::none && current->getArity() == Models::CompositeArity::unary) {
+            const auto* inner = current->getLeft().getStoragePtr();
+
+            switch (inner->getType()) {
+            case Models::FuncType::constant:
+                return Models::Polynomial::fromDense({static_cast<const Models::Constant*>(inner)->getValue()});
+            case Models::FuncType::identity:
+                return Models::Polynomial::fromDense({0, 1});
+            case Models::FuncType::none:
+                current = static_cast<const Models::Composite*>(inner);
+                continue;
+            default:
+                break;
+            }
+
+            // A power Composite also reports polynomial, so this one needs the checked cast.
+            if (const auto* poly = dynamic_cast<const Models::Polynomial*>(inner); poly) {
+                return *poly;
+            }
+
+            break;
+        }
+
+        return {};
+    }
+
+    /// @note Collapsed constants and plain x get their dedicated leaf kinds back.
+    static Models::Composite wrapPolynomial(Models::Polynomial&& poly) {
+        if (auto value = Models::getConstantValue(poly); value) {
+            return convertFoldResult({*value});
+        }
+
+        if (const auto dense = poly.getDenseCoeffs(); dense.size() == 2 && dense[0] == 0 && dense[1] == 1) {
+            return {Syntax::AstOpType::none, Models::Identity {}, {}};
+        }
+
+        return {Syntax::AstOpType::none, std::move(poly), {}};
+    }
+
+    static std::optional<Models::Polynomial> raiseNormalPolynomial(const Models::Polynomial& base, double exponent) {
+        const auto base_terms = (base.getTermCount() == 1) ? base.getTerms() : std::vector<Models::PolynomialTerm> {};
+        const bool whole_exponent = std::isfinite(exponent) && exponent == std::floor(exponent);
+
+        if (base_terms.size() == 1 && base_terms[0].coeff == 1 && base_terms[0].power == 1) {
+            return Models::normalizePolynomial({{1, exponent}});
+        }
+
+        if (!whole_exponent) {
+            return {};
+        }
+
+        // (c * x^k)^n = c^n * x^(k * n) only holds for whole n, e.g (x^2)^0.5 is |x|.
+        if (base_terms.size() == 1 && base_terms[0].coeff != 0) {
+            return Models::normalizePolynomial({{std::pow(base_terms[0].coeff, exponent), base_terms[0].power * exponent}});
+        }
+
+        if (exponent < 0) {
+            return {};
+        }
+
+        // A dense base of degree d expands to at most d * n + 1 terms, so large n stay cheap while that fits.
+        if (base.getLayout() == Models::PolyLayout::dense) {
+            if (static_cast<double>(base.getDenseCoeffs().size() - 1) * exponent + 1 > max_normal_terms) {
+                return {};
+            }
+        } else if (exponent > max_sparse_power) {
+            return {};
+        }
+
+        return Models::raisePolynomial(base, static_cast<unsigned int>(exponent));
+    }
+
+    static std::optional<Models::Polynomial> combinePolynomials(Syntax::AstOpType op, const Models::Polynomial& lhs, const Models::Polynomial& rhs) {
+        std::optional<Models::Polynomial> result;
+
+        switch (op) {
+        case Syntax::AstOpType::add:
+            result = Models::addPolynomials(lhs, rhs);
+            break;
+        case Syntax::AstOpType::sub:
+            result = Models::subtractPolynomials(lhs, rhs);
+            break;
+        case Syntax::AstOpType::mul:
+            if (lhs.getTermCount() * rhs.getTermCount() <= max_normal_terms * max_normal_terms) {
+                result = Models::multiplyPolynomials(lhs, rhs);
+            }
+            break;
+        case Syntax::AstOpType::div:
+            if (auto divisor = Models::getConstantValue(rhs); divisor && *divisor != 0 && std::isfinite(*divisor)) {
+                result = Models::dividePolynomial(lhs, *divisor);
+            }
+            break;
+        case Syntax::AstOpType::power:
+            if (auto exponent = Models::getConstantValue(rhs); exponent) {
+                result = raiseNormalPolynomial(lhs, *exponent);
+            }
+            break;
+        default:
+            break;
+        }
+
+        if (!result) {
+            return result;
+        }
+
+        const auto result_terms = result->getTerms();
+
+        // e.g (x + 1)^1000 overflows its middle coefficients, which the unexpanded power would not.
+        if (result_terms.size() > max_normal_terms || std::any_of(result_terms.begin(), result_terms.end(), [](const Models::PolynomialTerm& term) {
+            return !std::isfinite(term.coeff);
+        })) {
+            return {};
+        }
+
+        return result;
+    }
+
+    /// @note Polynomial leaves count as quotients over 1, as long as their powers allow a rational form.
+    static std::optional<Models::RationalFunction> findRationalLeaf(const Models::Composite& fn) {
+        const Models::Composite* current = &fn;
+
+        while (current->getOp() == Syntax::AstOpType::none && current->getArity() == Models::CompositeArity::unary) {
+            const auto* inner = current->getLeft().getStoragePtr();
+
+            if (inner->getType() == Models::FuncType::rational_function) {
+                return *static_cast<const Models::RationalFunction*>(inner);
+            } else if (inner->getType() != Models::FuncType::none) {
+                break;
+            }
+
+            current = static_cast<const Models::Composite*>(inner);
+        }
+
+        if (auto poly = findPolynomialLeaf(fn); poly && Models::getDenseDegree(*poly)) {
+            return Models::RationalFunction {*poly, Models::Polynomial::fromDense({1.0})};
+        }
+
+        return {};
+    }
+
+    static Models::Composite wrapRational(Models::RationalFunction&& quotient) {
+        if (quotient.isPolynomial()) {
+            return wrapPolynomial(Models::Polynomial {quotient.getNumerator()});
+        }
+
+        return {Syntax::AstOpType::none, std::move(quotient), {}};
+    }
+
+    static bool fitsRationalForm(const Models::Polynomial& poly) {
+        const auto degree = Models::getDenseDegree(poly);
+        const auto terms = poly.getTerms();
+
+        return degree && *degree <= max_rational_degree && std::all_of(terms.begin(), terms.end(), [](const Models::PolynomialTerm& term) {
+            return std::isfinite(term.coeff);
+        });
+    }
+
+    /// @note Combines over the product of both denominators, then `fromQuotient` cancels whatever the operands had in common.
+    static std::optional<Models::RationalFunction> combineRationals(Syntax::AstOpType op, const Models::RationalFunction& lhs, const Models::RationalFunction& rhs) {
+        const auto& lhs_top = lhs.getNumerator();
+        const auto& lhs_bottom = lhs.getDenominator();
+        const auto& rhs_top = rhs.getNumerator();
+        const auto& rhs_bottom = rhs.getDenominator();
+        std::optional<Models::Polynomial> numerator;
+        std::optional<Models::Polynomial> denominator;
+
+        switch (op) {
+        case Syntax::AstOpType::add:
+            numerator = Models::addPolynomials(Models::multiplyPolynomials(lhs_top, rhs_bottom), Models::multiplyPolynomials(rhs_top, lhs_bottom));
+            denominator = Models::multiplyPolynomials(lhs_bottom, rhs_bottom);
+            break;
+        case Syntax::AstOpType::sub:
+            numerator = Models::subtractPolynomials(Models::multiplyPolynomials(lhs_top, rhs_bottom), Models::multiplyPolynomials(rhs_top, lhs_bottom));
+            denominator = Models::multiplyPolynomials(lhs_bottom, rhs_bottom);
+            break;
+        case Syntax::AstOpType::mul:
+            numerator = Models::multiplyPolynomials(lhs_top, rhs_top);
+            denominator = Models::multiplyPolynomials(lhs_bottom, rhs_bottom);
+            break;
+        case Syntax::AstOpType::div:
+            numerator = Models::multiplyPolynomials(lhs_top, rhs_bottom);
+            denominator = Models::multiplyPolynomials(lhs_bottom, rhs_top);
+            break;
+        default:
+            break;
+        }
+
+        if (!numerator || !fitsRationalForm(*numerator) || !fitsRationalForm(*denominator)) {
+            return {};
+        }
+
+        return Models::RationalFunction::fromQuotient(*numerator, *denominator);
+    }
+
     Models::Composite convertFoldResult(const FoldResult& folded_value) {
         if (folded_value.getFoldType() == FoldType::number) {
-            std::vector<Models::PolynomialTerm> terms = {
-                Models::PolynomialTerm {folded_value.getScalarOptional().value(), 0}
-            };
-
             return {
                 Syntax::AstOpType::none,
-                Models::Polynomial (std::move(terms)),
+                Models::Constant {folded_value.getScalarOptional().value()},
                 {}
             };
         }
@@ -34,34 +240,25 @@ namespace GeneralDeriver::Backend {
         return {Syntax::AstOpType::none, {}, {}};
     }
 
-    FunctionEmitter::FunctionEmitter() {}
-
-    Models::Composite FunctionEmitter::visitConstant(const Syntax::Constant& node) {
-        return {Syntax::AstOpType::none, convertFoldResult(node.getValue()), {}};
-    }
+    Models::Composite emitVariable(const std::string& name, std::size_t slot) {
+        if (slot != 0) {
+            return {Syntax::AstOpType::none, Models::Variable {name, slot}, {}};
+        }
 
-    Models::Composite FunctionEmitter::visitVarStub([[maybe_unused]] const Syntax::VarStub& node) {
-        return {
-            Syntax::AstOpType::none,
-            Models::Polynomial {
-        {Models::PolynomialTerm {1, 1}}
-            },
-            {}
-        };
+        return {Syntax::AstOpType::none, Models::Identity {}, {}};
     }
 
-    Models::Composite FunctionEmitter::visitUnary(const Syntax::Unary& node) {
-        auto root_op = node.getOp();
-        Models::Composite inside_fn = node.getInnerPtr()->acceptVisitor(*this);
-
-        if (root_op == Syntax::AstOpType::none) {
+    Models::Composite emitUnaryOp(Syntax::AstOpType op, const Models::Composite& inside_fn) {
+        if (op == Syntax::AstOpType::none) {
             return inside_fn;
-        } else if (root_op == Syntax::AstOpType::neg) {
+        } else if (op == Syntax::AstOpType::neg) {
             return {
                 Syntax::AstOpType::mul,
                 convertFoldResult({-1}),
                 inside_fn
             };
+        } else if (Syntax::isFunctionOp(op)) {
+            return {op, inside_fn, {}};
         }
 
         /// @note Hacky fix: treat unexpected binary exprs. here as 0
@@ -72,16 +269,75 @@ namespace GeneralDeriver::Backend {
         };
     }
 
+    Models::Composite emitBinaryOp(Syntax::AstOpType op, const Models::Composite& lhs_fn, const Models::Composite& rhs_fn) {
+        if (op == Syntax::AstOpType::power) {
+            if (auto exponent = Models::getConstantLeaf(rhs_fn); exponent && Models::isIntPowerExponent(*exponent)) {
+                return {Syntax::AstOpType::none, Models::IntPower {lhs_fn, static_cast<std::int32_t>(*exponent)}, {}};
+            }
+        }
+
+        return {op, lhs_fn, rhs_fn};
+    }
+
+    Models::Composite emitNormalUnaryOp(Syntax::AstOpType op, const Models::Composite& inside_fn) {
+        if (op == Syntax::AstOpType::neg) {
+            if (auto inside_poly = findPolynomialLeaf(inside_fn); inside_poly) {
+                return wrapPolynomial(Models::negatePolynomial(*inside_poly));
+            }
+
+            if (auto inside_quotient = findRationalLeaf(inside_fn); inside_quotient) {
+                return wrapRational({Models::negatePolynomial(inside_quotient->getNumerator()), inside_quotient->getDenominator()});
+            }
+        }
+
+        return emitUnaryOp(op, inside_fn);
+    }
+
+    Models::Composite emitNormalBinaryOp(Syntax::AstOpType op, const Models::Composite& lhs_fn, const Models::Composite& rhs_fn) {
+        auto lhs_poly = findPolynomialLeaf(lhs_fn);
+        auto rhs_poly = (lhs_poly) ? findPolynomialLeaf(rhs_fn) : std::nullopt;
+
+        if (lhs_poly && rhs_poly) {
+            if (auto normal = combinePolynomials(op, *lhs_poly, *rhs_poly); normal) {
+                return wrapPolynomial(std::move(*normal));
+            }
+        }
+
+        // Quotients of polynomials, and any sum, difference, product or quotient with one, stay a single rational leaf.
+        if (op != Syntax::AstOpType::power) {
+            auto lhs_quotient = findRationalLeaf(lhs_fn);
+            auto rhs_quotient = (lhs_quotient) ? findRationalLeaf(rhs_fn) : std::nullopt;
+
+            if (lhs_quotient && rhs_quotient) {
+                if (auto normal = combineRationals(op, *lhs_quotient, *rhs_quotient); normal) {
+                    return wrapRational(std::move(*normal));
+                }
+            }
+        }
+
+        return emitBinaryOp(op, lhs_fn, rhs_fn);
+    }
+
+    FunctionEmitter::FunctionEmitter() {}
+
+    Models::Composite FunctionEmitter::visitConstant(const Syntax::Constant& node) {
+        return {Syntax::AstOpType::none, convertFoldResult(node.getValue()), {}};
+    }
+
+    Models::Composite FunctionEmitter::visitVarStub(const Syntax::VarStub& node) {
+        return emitVariable(node.getName(), node.getSlot());
+    }
+
+    Models::Composite FunctionEmitter::visitUnary(const Syntax::Unary& node) {
+        return emitNormalUnaryOp(node.getOp(), node.getInnerPtr()->acceptVisitor(*this));
+    }
+
     Models::Composite FunctionEmitter::visitBinary(const Syntax::Binary& node) {
         auto parent_op = node.getOp();
         Models::Composite lhs_fn = node.getLeft()->acceptVisitor(*this);
         Models::Composite rhs_fn = node.getRight()->acceptVisitor(*this);
 
-        return {
-            parent_op,
-            lhs_fn,
-            rhs_fn
-        };
+        return emitNormalBinaryOp(parent_op, lhs_fn, rhs_fn);
     }
 
     Models::Composite FunctionEmitter::emitFunction(const std::unique_ptr<Syntax::IAstNode>& root) {
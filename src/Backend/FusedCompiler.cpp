@@ -0,0 +1,223 @@
+/**
+ * @file FusedCompiler.cpp
+ * @author DrkWithT
+ * @brief Implements single-pass x-expression compiler: parse, fold & emit at once.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "Backend/FusedCompiler.hpp"
+#include "Backend/FuncEmitter.hpp"
+#include "Frontend/Parser.hpp"
+
+namespace GeneralDeriver::Backend {
+    using Frontend::Token;
+    using Frontend::TokenType;
+
+    FoldedPart makeConstantPart(double value) {
+        return {{value}, convertFoldResult({value})};
+    }
+
+    FoldedPart makeVariablePart(const std::string& name, std::size_t slot) {
+        return {{SymbolicOpt {}}, emitVariable(name, slot)};
+    }
+
+    /// @note Mirrors `FunctionEmitter::visitUnary`, but a numeric operand folds straight into a constant leaf.
+    FoldedPart foldUnaryPart(Syntax::AstOpType op, const FoldedPart& inner) {
+        FoldResult folded = computeOp(op, inner.folded);
+
+        if (folded.getFoldType() == FoldType::invalid) {
+            throw std::domain_error {"NaN fold"};
+        }
+
+        if (folded.getFoldType() == FoldType::number) {
+            return {folded, convertFoldResult(folded)};
+        }
+
+        return {folded, emitUnaryOp(op, inner.fn)};
+    }
+
+    /// @note Mirrors `FunctionEmitter::visitBinary`, but numeric operands fold straight into a constant leaf.
+    FoldedPart foldBinaryPart(Syntax::AstOpType op, const FoldedPart& lhs, const FoldedPart& rhs) {
+        FoldResult folded = computeOp(op, lhs.folded, rhs.folded);
+
+        if (folded.getFoldType() == FoldType::invalid) {
+            throw std::domain_error {"NaN fold"};
+        }
+
+        if (folded.getFoldType() == FoldType::number) {
+            return {folded, convertFoldResult(folded)};
+        }
+
+        return {folded, emitBinaryOp(op, lhs.fn, rhs.fn)};
+    }
+
+    const Token& FusedCompiler::peekCurrent() const { return current; }
+
+    Token FusedCompiler::advanceToken() {
+        Token temp;
+
+        do {
+            temp = lexer.lexNext();
+        } while (temp.tag == TokenType::spacing);
+
+        return temp;
+    }
+
+    void FusedCompiler::consumeToken(std::initializer_list<TokenType> expected) {
+        if (expected.size() == 0) {
+            previous = current;
+            current = advanceToken();
+            return;
+        }
+
+        auto current_tag = peekCurrent().tag;
+
+        if (current_tag == TokenType::eos) {
+            return;
+        }
+
+        if (std::find(expected.begin(), expected.end(), current_tag) != expected.end()) {
+            previous = current;
+            current = advanceToken();
+            return;
+        }
+
+        throw std::runtime_error {
+            Frontend::formatParseError(Frontend::ParseError::token_err, peekCurrent(), lexer.getSource())
+        };
+    }
+
+    FusedCompiler::Partial FusedCompiler::compileLiteral() {
+        auto peeked_tag = peekCurrent().tag;
+
+        if (peeked_tag == TokenType::number) {
+            double n = std::stod(getLexeme(peekCurrent(), lexer.getSource()));
+            consumeToken({});
+
+            return makeConstantPart(n);
+        } else if (peeked_tag == TokenType::variable) {
+            auto name = getLexeme(peekCurrent(), lexer.getSource());
+            consumeToken({});
+
+            return makeVariablePart(name, variables.getSlot(name));
+        } else if (peeked_tag == TokenType::func_name) {
+            auto func_op = Frontend::getFunctionOp(viewLexeme(peekCurrent(), lexer.getSource()));
+            consumeToken({});
+            consumeToken({TokenType::l_paren});
+            auto argument = compileTerm();
+            consumeToken({TokenType::r_paren});
+
+            return foldUnaryPart(func_op, argument);
+        } else if (peeked_tag == TokenType::l_paren) {
+            consumeToken({});
+            auto temp = compileTerm();
+            consumeToken({TokenType::r_paren});
+
+            return temp;
+        } else if (peeked_tag == TokenType::op_minus) {
+            return compileUnary();
+        }
+
+        throw std::runtime_error {
+            Frontend::formatParseError(Frontend::ParseError::syntax_err, peekCurrent(), lexer.getSource())
+        };
+    }
+
+    FusedCompiler::Partial FusedCompiler::compileUnary() {
+        if (peekCurrent().tag == TokenType::op_minus) {
+            consumeToken({});
+            return foldUnaryPart(Syntax::AstOpType::neg, compileLiteral());
+        }
+
+        return compileLiteral();
+    }
+
+    FusedCompiler::Partial FusedCompiler::compilePower() {
+        auto power_target = compileUnary();
+
+        if (peekCurrent().tag == TokenType::op_power) {
+            consumeToken({});
+            auto exponent = compileLiteral();
+
+            return foldBinaryPart(Syntax::AstOpType::power, power_target, exponent);
+        }
+
+        return power_target;
+    }
+
+    FusedCompiler::Partial FusedCompiler::compileFactor() {
+        auto lhs = compilePower();
+
+        do {
+            auto current_tag = peekCurrent().tag;
+
+            if (current_tag != TokenType::op_times && current_tag != TokenType::op_slash) {
+                break;
+            }
+
+            auto op = (current_tag == TokenType::op_times)
+                ? Syntax::AstOpType::mul
+                : Syntax::AstOpType::div;
+
+            consumeToken({});
+
+            auto rhs = compilePower();
+
+            lhs = foldBinaryPart(op, lhs, rhs);
+        } while (true);
+
+        return lhs;
+    }
+
+    FusedCompiler::Partial FusedCompiler::compileTerm() {
+        auto lhs = compileFactor();
+
+        do {
+            auto current_tag = peekCurrent().tag;
+
+            if (current_tag != TokenType::op_plus && current_tag != TokenType::op_minus) {
+                break;
+            }
+
+            auto op = (current_tag == TokenType::op_plus)
+                ? Syntax::AstOpType::add
+                : Syntax::AstOpType::sub;
+
+            consumeToken({});
+
+            auto rhs = compileFactor();
+
+            lhs = foldBinaryPart(op, lhs, rhs);
+        } while (true);
+
+        return lhs;
+    }
+
+    FusedCompiler::FusedCompiler()
+    : lexer {}, variables {}, current {0, 1, TokenType::unknown}, previous {0, 1, TokenType::unknown} {}
+
+    FusedResult FusedCompiler::compileAll(const std::string& source_arg) {
+        lexer = Frontend::Lexer(source_arg);
+        variables.clearState();
+        consumeToken({});
+
+        try {
+            auto result = compileTerm();
+
+            return {result.fn, variables.getNames(), true};
+        } catch (const std::domain_error&) {
+            return {{}, {}, false};
+        } catch (const std::runtime_error& parse_err) {
+            std::cerr << "\033[31;1m" << parse_err.what() << "\033[0m";
+        }
+
+        return {{}, {}, false};
+    }
+}
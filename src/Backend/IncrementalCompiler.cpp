@@ -0,0 +1,335 @@
+/**
+ * @file IncrementalCompiler.cpp
+ * @author DrkWithT
+ * @brief Implements edit-aware x-expression compiler reusing unchanged sub-expressions.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include "Backend/IncrementalCompiler.hpp"
+#include "Frontend/Lexer.hpp"
+#include "Frontend/Parser.hpp"
+#include "Models/Constant.hpp"
+
+namespace GeneralDeriver::Backend {
+    using Frontend::Token;
+    using Frontend::TokenType;
+
+    static Models::FunctionAny makeConstantDerivative(double slope) {
+        return Models::Constant {slope};
+    }
+
+    /// @note Replaces `items[begin, end)` with `count` items, moving the tail at most once. Kept items in the span are left as they were.
+    template <typename Item>
+    static void resizeSpan(std::vector<Item>& items, std::size_t begin, std::size_t end, std::size_t count) {
+        const std::size_t old_count = end - begin;
+
+        if (count < old_count) {
+            items.erase(items.begin() + begin + count, items.begin() + end);
+        } else if (count > old_count) {
+            items.insert(items.begin() + end, count - old_count, Item {});
+        }
+    }
+
+    /// @note Tokens ending before the first changed char keep their spans, and once re-lexing reaches a token start inside the unchanged tail, every later old token is the same up to a shift. Prefix cache entries stay in place but drop any power or chain step reading past the edit, since trailing tokens left unparsed may keep the next compile from revisiting them.
+    void IncrementalCompiler::relexEdit(const std::string& source_arg) {
+        const std::size_t old_len = source.size();
+        const std::size_t new_len = source_arg.size();
+        const std::size_t common_len = std::min(old_len, new_len);
+
+        std::size_t same_front = 0;
+
+        while (same_front < common_len && source[same_front] == source_arg[same_front]) {
+            same_front++;
+        }
+
+        std::size_t same_back = 0;
+
+        while (same_back < common_len - same_front && source[old_len - 1 - same_back] == source_arg[new_len - 1 - same_back]) {
+            same_back++;
+        }
+
+        prefix_count = 0;
+
+        while (prefix_count < tokens.size() && tokens[prefix_count].tag != TokenType::eos && tokens[prefix_count].begin + tokens[prefix_count].length < same_front) {
+            prefix_count++;
+        }
+
+        Frontend::Lexer lexer {source_arg};
+        lexer.seekTo((prefix_count > 0) ? tokens[prefix_count - 1].begin + tokens[prefix_count - 1].length : 0);
+
+        std::vector<Token> middle;
+        auto old_match = tokens.end();
+
+        do {
+            Token temp = lexer.lexNext();
+
+            if (temp.tag == TokenType::spacing) {
+                continue;
+            }
+
+            if (temp.begin >= new_len - same_back) {
+                const std::size_t old_begin = temp.begin + old_len - new_len;
+
+                old_match = std::lower_bound(tokens.begin() + prefix_count, tokens.end(), old_begin, [](const Token& token, std::size_t pos) {
+                    return token.begin < pos;
+                });
+
+                if (old_match != tokens.end() && old_match->begin == old_begin) {
+                    break;
+                }
+
+                old_match = tokens.end();
+            }
+
+            middle.push_back(temp);
+
+            if (temp.tag == TokenType::eos) {
+                break;
+            }
+        } while (true);
+
+        const auto match_pos = static_cast<std::size_t>(old_match - tokens.begin());
+
+        for (auto old_it = old_match; old_it != tokens.end(); old_it++) {
+            old_it->begin += new_len - old_len;
+        }
+
+        resizeSpan(tokens, prefix_count, match_pos, middle.size());
+        resizeSpan(cache, prefix_count, match_pos, middle.size());
+        std::copy(middle.begin(), middle.end(), tokens.begin() + prefix_count);
+        suffix_begin = prefix_count + middle.size();
+
+        for (std::size_t pos = 0; pos < prefix_count; pos++) {
+            CacheEntry& entry = cache[pos];
+            auto reads_edit = [this, pos](const ChainStep& step) {
+                return pos + step.token_count >= prefix_count;
+            };
+
+            if (entry.filled && !isReusable(pos, entry.token_count)) {
+                entry.filled = false;
+            }
+
+            std::erase_if(entry.factor_steps, reads_edit);
+            std::erase_if(entry.term_steps, reads_edit);
+        }
+
+        for (std::size_t pos = prefix_count; pos < suffix_begin; pos++) {
+            cache[pos] = CacheEntry {{}, 0, false, {}, {}};
+        }
+
+        source = source_arg;
+    }
+
+    /// @note A cached power reads its own tokens plus one lookahead token, so all of those must lie outside the edit.
+    bool IncrementalCompiler::isReusable(std::size_t token_pos, std::size_t token_count) const {
+        return token_pos + token_count < prefix_count || token_pos >= suffix_begin;
+    }
+
+    const Token& IncrementalCompiler::peekCurrent() const { return tokens[cursor]; }
+
+    void IncrementalCompiler::consumeToken() {
+        if (tokens[cursor].tag != TokenType::eos) {
+            cursor++;
+        }
+    }
+
+    void IncrementalCompiler::consumeToken(TokenType expected) {
+        auto current_tag = peekCurrent().tag;
+
+        if (current_tag == TokenType::eos) {
+            return;
+        }
+
+        if (current_tag == expected) {
+            cursor++;
+            return;
+        }
+
+        throw std::runtime_error {
+            Frontend::formatParseError(Frontend::ParseError::token_err, peekCurrent(), source)
+        };
+    }
+
+    IncrementalCompiler::Piece IncrementalCompiler::combineUnary(Syntax::AstOpType op, const Piece& inner) {
+        combined_count++;
+
+        auto part = foldUnaryPart(op, inner.part);
+
+        if (part.folded.getFoldType() == FoldType::number) {
+            return {part, makeConstantDerivative(0)};
+        }
+
+        return {part, Models::assembleDerivative(op, inner.part.fn, inner.derivative)};
+    }
+
+    IncrementalCompiler::Piece IncrementalCompiler::compileLiteral() {
+        auto peeked_tag = peekCurrent().tag;
+
+        if (peeked_tag == TokenType::number) {
+            double n = std::stod(getLexeme(peekCurrent(), source));
+            consumeToken();
+
+            return {makeConstantPart(n), makeConstantDerivative(0)};
+        } else if (peeked_tag == TokenType::variable) {
+            auto name = getLexeme(peekCurrent(), source);
+            auto slot = variables.getSlot(name);
+            consumeToken();
+
+            return {makeVariablePart(name, slot), makeConstantDerivative((slot == 0) ? 1 : 0)};
+        } else if (peeked_tag == TokenType::func_name) {
+            auto func_op = Frontend::getFunctionOp(viewLexeme(peekCurrent(), source));
+            consumeToken();
+            consumeToken(TokenType::l_paren);
+            auto argument = compileTerm();
+            consumeToken(TokenType::r_paren);
+
+            return combineUnary(func_op, argument);
+        } else if (peeked_tag == TokenType::l_paren) {
+            consumeToken();
+            auto temp = compileTerm();
+            consumeToken(TokenType::r_paren);
+
+            return temp;
+        } else if (peeked_tag == TokenType::op_minus) {
+            return compileUnary();
+        }
+
+        throw std::runtime_error {
+            Frontend::formatParseError(Frontend::ParseError::syntax_err, peekCurrent(), source)
+        };
+    }
+
+    IncrementalCompiler::Piece IncrementalCompiler::compileUnary() {
+        if (peekCurrent().tag == TokenType::op_minus) {
+            consumeToken();
+
+            return combineUnary(Syntax::AstOpType::neg, compileLiteral());
+        }
+
+        return compileLiteral();
+    }
+
+    IncrementalCompiler::Piece IncrementalCompiler::compilePower() {
+        const std::size_t start = cursor;
+        CacheEntry& cached = cache[start];
+
+        if (cached.filled && isReusable(start, cached.token_count)) {
+            cursor = start + cached.token_count;
+            reused_count += cached.token_count;
+
+            return cached.piece;
+        }
+
+        auto power_target = compileUnary();
+
+        if (peekCurrent().tag == TokenType::op_power) {
+            consumeToken();
+            auto exponent = compileLiteral();
+            power_target = combineBinary(Syntax::AstOpType::power, power_target, exponent);
+        }
+
+        cached.piece = power_target;
+        cached.token_count = cursor - start;
+        cached.filled = true;
+
+        return power_target;
+    }
+
+    IncrementalCompiler::Piece IncrementalCompiler::combineBinary(Syntax::AstOpType op, const Piece& lhs, const Piece& rhs) {
+        combined_count++;
+
+        auto part = foldBinaryPart(op, lhs.part, rhs.part);
+
+        if (part.folded.getFoldType() == FoldType::number) {
+            return {part, makeConstantDerivative(0)};
+        }
+
+        return {part, Models::assembleDerivative(op, lhs.part.fn, rhs.part.fn, lhs.derivative, rhs.derivative)};
+    }
+
+    /// @note Resumes from the last cached step, which `relexEdit` left only if its tokens & lookahead lie outside the edit, then folds & caches every later operand. A chain in the unchanged tail resumes from its last step, which ends it.
+    IncrementalCompiler::Piece IncrementalCompiler::compileChain(ChainKind kind) {
+        const std::size_t start = cursor;
+        auto& steps = (kind == ChainKind::term) ? cache[start].term_steps : cache[start].factor_steps;
+        Piece lhs;
+
+        if (!steps.empty()) {
+            cursor = start + steps.back().token_count;
+            reused_count += steps.back().token_count;
+            lhs = steps.back().piece;
+        } else {
+            lhs = (kind == ChainKind::term) ? compileFactor() : compilePower();
+            steps.push_back({lhs, cursor - start});
+        }
+
+        do {
+            auto current_tag = peekCurrent().tag;
+            Syntax::AstOpType op;
+
+            if (kind == ChainKind::factor && (current_tag == TokenType::op_times || current_tag == TokenType::op_slash)) {
+                op = (current_tag == TokenType::op_times) ? Syntax::AstOpType::mul : Syntax::AstOpType::div;
+            } else if (kind == ChainKind::term && (current_tag == TokenType::op_plus || current_tag == TokenType::op_minus)) {
+                op = (current_tag == TokenType::op_plus) ? Syntax::AstOpType::add : Syntax::AstOpType::sub;
+            } else {
+                break;
+            }
+
+            consumeToken();
+
+            auto rhs = (kind == ChainKind::term) ? compileFactor() : compilePower();
+            lhs = combineBinary(op, lhs, rhs);
+            steps.push_back({lhs, cursor - start});
+        } while (true);
+
+        return lhs;
+    }
+
+    IncrementalCompiler::Piece IncrementalCompiler::compileFactor() {
+        return compileChain(ChainKind::factor);
+    }
+
+    IncrementalCompiler::Piece IncrementalCompiler::compileTerm() {
+        return compileChain(ChainKind::term);
+    }
+
+    IncrementalCompiler::IncrementalCompiler()
+    : source {}, tokens {}, cache {}, variables {}, cursor {0}, prefix_count {0}, suffix_begin {0}, reused_count {0}, combined_count {0} {}
+
+    IncrementalResult IncrementalCompiler::compile(const std::string& source_arg) {
+        relexEdit(source_arg);
+        cursor = 0;
+        reused_count = 0;
+        combined_count = 0;
+
+        try {
+            auto result = compileTerm();
+
+            return {result.part.fn, result.derivative, variables.getNames(), reused_count, combined_count, true};
+        } catch (const std::domain_error&) {
+            clearState();
+        } catch (const std::runtime_error& parse_err) {
+            std::cerr << "\033[31;1m" << parse_err.what() << "\033[0m";
+            clearState();
+        }
+
+        return {{}, {}, {}, 0, 0, false};
+    }
+
+    void IncrementalCompiler::clearState() {
+        source.clear();
+        tokens.clear();
+        cache.clear();
+        variables.clearState();
+        cursor = 0;
+        prefix_count = 0;
+        suffix_begin = 0;
+        reused_count = 0;
+        combined_count = 0;
+    }
+}
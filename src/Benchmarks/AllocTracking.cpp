@@ -0,0 +1,139 @@
+/**
+ * @file AllocTracking.cpp
+ * @author DrkWithT
+ * @brief Implements the counting global allocator for benchmarks, allocation budget tests & instrumented builds.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "Benchmarks/AllocTracking.hpp"
+#include "Utils/Instrument.hpp"
+
+namespace GeneralDeriver::Benchmarks {
+    static std::atomic<std::uint64_t> alloc_count {0};
+    static std::atomic<std::uint64_t> alloc_bytes {0};
+    static std::atomic<std::uint64_t> free_count {0};
+
+    // Plain integers need no TLS constructor, so the counting hooks are safe even while a thread starts up.
+    static thread_local std::uint64_t thread_alloc_count = 0;
+    static thread_local std::uint64_t thread_alloc_bytes = 0;
+    static thread_local std::uint64_t thread_free_count = 0;
+
+    static void noteAlloc(std::size_t size) {
+        alloc_count.fetch_add(1, std::memory_order_relaxed);
+        alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+        thread_alloc_count++;
+        thread_alloc_bytes += size;
+    }
+
+    static void* countedAlloc(std::size_t size) {
+        noteAlloc(size);
+
+        if (void* block = std::malloc((size != 0) ? size : 1); block != nullptr) {
+            return block;
+        }
+
+        throw std::bad_alloc {};
+    }
+
+    /// @note `aligned_alloc` wants a size that is a multiple of the alignment.
+    static void* countedAlignedAlloc(std::size_t size, std::align_val_t align) {
+        const auto alignment = static_cast<std::size_t>(align);
+        const std::size_t rounded_size = (size != 0) ? (size + alignment - 1) / alignment * alignment : alignment;
+        noteAlloc(size);
+
+        if (void* block = std::aligned_alloc(alignment, rounded_size); block != nullptr) {
+            return block;
+        }
+
+        throw std::bad_alloc {};
+    }
+
+    static void countedFree(void* block) noexcept {
+        if (block == nullptr) {
+            return;
+        }
+
+        free_count.fetch_add(1, std::memory_order_relaxed);
+        thread_free_count++;
+        std::free(block);
+    }
+
+    AllocStats readAllocStats() {
+        return {alloc_count.load(std::memory_order_relaxed), alloc_bytes.load(std::memory_order_relaxed), free_count.load(std::memory_order_relaxed)};
+    }
+
+    AllocStats readThreadAllocStats() {
+        return {thread_alloc_count, thread_alloc_bytes, thread_free_count};
+    }
+
+    void attachStageAllocTracking() {
+        Utils::setAllocReader([]() -> Utils::AllocTotals {
+            const auto stats = readThreadAllocStats();
+
+            return {stats.count, stats.bytes};
+        });
+    }
+
+    AllocScope::AllocScope()
+    : before {readThreadAllocStats()} {}
+
+    AllocStats AllocScope::read() const {
+        const auto now = readThreadAllocStats();
+
+        return {now.count - before.count, now.bytes - before.bytes, now.frees - before.frees};
+    }
+}
+
+void* operator new(std::size_t size) {
+    return GeneralDeriver::Benchmarks::countedAlloc(size);
+}
+
+void* operator new[](std::size_t size) {
+    return GeneralDeriver::Benchmarks::countedAlloc(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t align) {
+    return GeneralDeriver::Benchmarks::countedAlignedAlloc(size, align);
+}
+
+void* operator new[](std::size_t size, std::align_val_t align) {
+    return GeneralDeriver::Benchmarks::countedAlignedAlloc(size, align);
+}
+
+void operator delete(void* block) noexcept {
+    GeneralDeriver::Benchmarks::countedFree(block);
+}
+
+void operator delete[](void* block) noexcept {
+    GeneralDeriver::Benchmarks::countedFree(block);
+}
+
+void operator delete(void* block, [[maybe_unused]] std::size_t size) noexcept {
+    GeneralDeriver::Benchmarks::countedFree(block);
+}
+
+void operator delete[](void* block, [[maybe_unused]] std::size_t size) noexcept {
+    GeneralDeriver::Benchmarks::countedFree(block);
+}
+
+void operator delete(void* block, [[maybe_unused]] std::align_val_t align) noexcept {
+    GeneralDeriver::Benchmarks::countedFree(block);
+}
+
+void operator delete[](void* block, [[maybe_unused]] std::align_val_t align) noexcept {
+    GeneralDeriver::Benchmarks::countedFree(block);
+}
+
+void operator delete(void* block, [[maybe_unused]] std::size_t size, [[maybe_unused]] std::align_val_t align) noexcept {
+    GeneralDeriver::Benchmarks::countedFree(block);
+}
+
+void operator delete[](void* block, [[maybe_unused]] std::size_t size, [[maybe_unused]] std::align_val_t align) noexcept {
+    GeneralDeriver::Benchmarks::countedFree(block);
+}
@@ -0,0 +1,303 @@
+/**
+ * @file BenchComponents.cpp
+ * @author DrkWithT
+ * @brief Implements per-component microbenchmarks over small, medium & huge inputs.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <array>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Benchmarks/MicroBench.hpp"
+#include "Frontend/Lexer.hpp"
+#include "Frontend/Parser.hpp"
+#include "Frontend/FlatParser.hpp"
+#include "Backend/FlatPasses.hpp"
+#include "Backend/AstValidator.hpp"
+#include "Backend/FuncEmitter.hpp"
+#include "Models/Composite.hpp"
+#include "Models/FunctionLibrary.hpp"
+#include "Models/IntPower.hpp"
+#include "Models/LazyDerivative.hpp"
+#include "Models/ParameterEvaluator.hpp"
+#include "Models/Polynomial.hpp"
+#include "Models/PolyAlgebra.hpp"
+#include "Models/PolyKernels.hpp"
+#include "Utils/ExprGenerator.hpp"
+
+using MyAstPtr = std::unique_ptr<GeneralDeriver::Syntax::IAstNode>;
+using MyGenConfig = GeneralDeriver::Utils::ExprGenConfig;
+using MyPolynomial = GeneralDeriver::Models::Polynomial;
+using MyPolyTerm = GeneralDeriver::Models::PolynomialTerm;
+namespace MyBench = GeneralDeriver::Benchmarks;
+
+static constexpr std::size_t huge_join_count = 400;
+static constexpr double bench_x = 0.75;
+static constexpr std::size_t dense_mul_length = 2048;
+static constexpr unsigned int binomial_power = 200;
+static constexpr std::size_t tape_batch_length = 1024;
+
+struct SizedInput {
+    const char* label;
+    std::string source;
+    std::size_t poly_terms;
+};
+
+/// @note The huge input joins many medium expressions into one long sum.
+[[nodiscard]] std::vector<SizedInput> makeInputs() {
+    MyGenConfig small_config;
+    small_config.seed = 1;
+    small_config.max_depth = 1;
+    small_config.max_terms = 3;
+
+    MyGenConfig medium_config = small_config;
+    medium_config.seed = 2;
+    medium_config.max_depth = 3;
+    medium_config.max_terms = 6;
+
+    GeneralDeriver::Utils::ExprGenerator small_gen {small_config};
+    GeneralDeriver::Utils::ExprGenerator medium_gen {medium_config};
+
+    std::string huge_source;
+
+    for (std::size_t i = 0; i < huge_join_count; i++) {
+        huge_source += std::format("{}({})", (i > 0) ? " + " : "", medium_gen.generate());
+    }
+
+    return {
+        {"small", small_gen.generate(), 4},
+        {"medium", medium_gen.generate(), 32},
+        {"huge", std::move(huge_source), 1024}
+    };
+}
+
+[[nodiscard]] MyPolynomial makePolynomial(std::size_t term_count) {
+    std::vector<MyPolyTerm> terms;
+
+    for (std::size_t i = 0; i < term_count; i++) {
+        terms.push_back({1.0 / static_cast<double>(i + 1), static_cast<double>(i)});
+    }
+
+    return MyPolynomial {std::move(terms)};
+}
+
+/// @note Whole coefficients in [-8, 8] keep every multiplication method exact, so the methods time the same product.
+[[nodiscard]] std::vector<double> makeDenseCoeffs(std::size_t count) {
+    std::vector<double> coeffs;
+
+    for (std::size_t i = 0; i < count; i++) {
+        coeffs.push_back(static_cast<double>(static_cast<int>((i * 7919) % 17) - 8));
+    }
+
+    return coeffs;
+}
+
+/// @note Nodes one tree evaluation visits, for the cycles / node column of `--perf 1` runs.
+[[nodiscard]] std::size_t countFunctionNodes(const GeneralDeriver::Models::IFunction* fn) {
+    if (fn == nullptr) {
+        return 0;
+    }
+
+    if (const auto* composite = dynamic_cast<const GeneralDeriver::Models::Composite*>(fn); composite) {
+        return 1 + countFunctionNodes(composite->getLeft().getStoragePtr()) + countFunctionNodes(composite->getRight().getStoragePtr());
+    } else if (const auto* power = dynamic_cast<const GeneralDeriver::Models::IntPower*>(fn); power) {
+        return 1 + countFunctionNodes(power->getBase().getStoragePtr());
+    }
+
+    return 1;
+}
+
+int main(int argc, char* argv[]) {
+    MyBench::BenchOptions options;
+
+    if (!MyBench::parseBenchOptions(argc, argv, options)) {
+        std::cerr << "Usage: bench_components [--filter S] [--reps N] [--warmup N] [--min-time SECONDS] [--json PATH] [--compare PATH] [--threshold FRACTION] [--perf 0|1]\n";
+        return 1;
+    }
+
+    MyBench::MicroBench bench {options};
+    const auto inputs = makeInputs();
+
+    for (const auto& input : inputs) {
+        GeneralDeriver::Frontend::Parser parser;
+        GeneralDeriver::Backend::AstValidator validator;
+        GeneralDeriver::Backend::FunctionEmitter emitter;
+
+        const MyAstPtr ast = parser.parseAll(input.source).root;
+        const auto fn = emitter.emitFunction(ast);
+        const auto poly = makePolynomial(input.poly_terms);
+        const auto fn_nodes = countFunctionNodes(&fn);
+
+        GeneralDeriver::Frontend::FlatParser flat_parser;
+        GeneralDeriver::Backend::FlatValidator flat_validator;
+        GeneralDeriver::Backend::FlatEmitter flat_emitter;
+        GeneralDeriver::Syntax::FlatAst flat_ast;
+
+        if (!flat_parser.parseAll(input.source, flat_ast)) {
+            return 1;
+        }
+
+        bench.run(std::format("lexer/lexNext/{}", input.label), [&input]() {
+            GeneralDeriver::Frontend::Lexer lexer {input.source};
+            std::size_t token_count = 0;
+
+            while (lexer.lexNext().tag != GeneralDeriver::Frontend::TokenType::eos) {
+                token_count++;
+            }
+
+            MyBench::doNotOptimize(token_count);
+        });
+
+        bench.run(std::format("parser/parseAll/{}", input.label), [&input, &parser]() {
+            auto result = parser.parseAll(input.source);
+            MyBench::doNotOptimize(result.ok);
+        });
+
+        bench.run(std::format("validator/validateAst/{}", input.label), [&ast, &validator]() {
+            bool ok = validator.validateAst(ast);
+            validator.clearState();
+            MyBench::doNotOptimize(ok);
+        });
+
+        bench.run(std::format("emitter/emitFunction/{}", input.label), [&ast, &emitter]() {
+            auto result = emitter.emitFunction(ast);
+            MyBench::doNotOptimize(result);
+        });
+
+        bench.run(std::format("flat/parseAll/{}", input.label), [&input, &flat_parser, &flat_ast]() {
+            bool ok = flat_parser.parseAll(input.source, flat_ast);
+            MyBench::doNotOptimize(ok);
+        });
+
+        bench.run(std::format("flat/validateAst/{}", input.label), [&flat_ast, &flat_validator]() {
+            bool ok = flat_validator.validateAst(flat_ast);
+            MyBench::doNotOptimize(ok);
+        });
+
+        bench.run(std::format("flat/emitFunction/{}", input.label), [&flat_ast, &flat_emitter]() {
+            auto result = flat_emitter.emitFunction(flat_ast);
+            MyBench::doNotOptimize(result);
+        });
+
+        bench.run(std::format("polynomial/evalAt/{}", input.label), [&poly]() {
+            MyBench::doNotOptimize(poly.evalAt(bench_x));
+        }, input.poly_terms);
+
+        bench.run(std::format("polynomial/makeDerivative/{}", input.label), [&poly]() {
+            auto result = poly.makeDerivative();
+            MyBench::doNotOptimize(result);
+        });
+
+        bench.run(std::format("composite/evalAt/{}", input.label), [&fn]() {
+            MyBench::doNotOptimize(fn.evalAt(bench_x));
+        }, fn_nodes);
+
+        bench.run(std::format("composite/makeDerivative/{}", input.label), [&fn]() {
+            auto result = fn.makeDerivative();
+            MyBench::doNotOptimize(result);
+        }, fn_nodes);
+
+        bench.run(std::format("composite/makeDerivative+evalAt/{}", input.label), [&fn]() {
+            MyBench::doNotOptimize(fn.makeDerivative().getStoragePtr()->evalAt(bench_x));
+        }, fn_nodes);
+
+        bench.run(std::format("composite/makeLazyDerivative+evalAt/{}", input.label), [&fn]() {
+            MyBench::doNotOptimize(GeneralDeriver::Models::makeLazyDerivative(fn).getStoragePtr()->evalAt(bench_x));
+        }, fn_nodes);
+
+        // One compiled tape evaluated over a batch in each precision.
+        const GeneralDeriver::Models::Tape fn_tape {fn};
+        GeneralDeriver::Models::ParameterEvaluator double_eval {fn_tape, 0};
+        GeneralDeriver::Models::SingleParameterEvaluator single_eval {fn_tape, 0};
+        std::vector<double> double_xs(tape_batch_length);
+        std::vector<double> double_out(tape_batch_length);
+
+        for (std::size_t i = 0; i < tape_batch_length; i++) {
+            double_xs[i] = bench_x + static_cast<double>(i) / tape_batch_length;
+        }
+
+        const std::vector<float> single_xs(double_xs.begin(), double_xs.end());
+        std::vector<float> single_out(tape_batch_length);
+
+        bench.run(std::format("tape/evalBatch/f64/{}", input.label), [&double_eval, &double_xs, &double_out]() {
+            double_eval.evalBatch(double_xs, {}, double_out);
+            MyBench::doNotOptimize(double_out.back());
+        }, fn_nodes * tape_batch_length);
+
+        bench.run(std::format("tape/evalBatch/f32/{}", input.label), [&single_eval, &single_xs, &single_out]() {
+            single_eval.evalBatch(single_xs, {}, single_out);
+            MyBench::doNotOptimize(single_out.back());
+        }, fn_nodes * tape_batch_length);
+
+        // Cold start both ways: re-compiling from source vs. mapping a library image written ahead of time.
+        const auto library_path = (std::filesystem::temp_directory_path() / std::format("gd_bench_{}.bin", input.label)).string();
+        GeneralDeriver::Models::LibraryWriter library_writer;
+        library_writer.addFunction(input.label, fn, fn.makeDerivative());
+
+        if (!library_writer.writeFile(library_path)) {
+            return 1;
+        }
+
+        std::vector<double> library_scratch;
+        const std::array<double, 1> library_point {bench_x};
+
+        bench.run(std::format("library/compileSource+evalAt/{}", input.label), [&input, &parser, &emitter]() {
+            const auto compiled = emitter.emitFunction(parser.parseAll(input.source).root);
+            MyBench::doNotOptimize(compiled.makeDerivative().getStoragePtr()->evalAt(bench_x));
+        }, fn_nodes);
+
+        bench.run(std::format("library/open+find+evalAt/{}", input.label), [&input, &library_path, &library_scratch, &library_point]() {
+            const auto library = GeneralDeriver::Models::MappedLibrary::open(library_path);
+            const auto item = library->find(input.label);
+            library_scratch.resize(item->derivative.getNodeCount());
+            MyBench::doNotOptimize(item->derivative.evalAt(library_point, library_scratch));
+        }, fn_nodes);
+
+        std::filesystem::remove(library_path);
+    }
+
+    const auto dense_coeffs = makeDenseCoeffs(dense_mul_length);
+    constexpr std::array<std::pair<const char*, GeneralDeriver::Models::MulMethod>, 3> mul_methods {{
+        {"schoolbook", GeneralDeriver::Models::MulMethod::schoolbook},
+        {"karatsuba", GeneralDeriver::Models::MulMethod::karatsuba},
+        {"fft", GeneralDeriver::Models::MulMethod::fft}
+    }};
+
+    for (const auto& [label, method] : mul_methods) {
+        bench.run(std::format("polykernels/multiplyDense/{}", label), [&dense_coeffs, method]() {
+            auto result = GeneralDeriver::Models::multiplyDenseWith(method, dense_coeffs, dense_coeffs);
+            MyBench::doNotOptimize(result);
+        });
+    }
+
+    const MyPolynomial x_plus_one {{{1, 1}, {1, 0}}};
+
+    bench.run(std::format("polyalgebra/raisePolynomial/binomial{}", binomial_power), [&x_plus_one]() {
+        auto result = GeneralDeriver::Models::raisePolynomial(x_plus_one, binomial_power);
+        MyBench::doNotOptimize(result);
+    });
+
+    bench.printSummary();
+    bench.printPerfSummary();
+
+    if (!options.json_path.empty() && !bench.writeJson()) {
+        return 1;
+    }
+
+    if (!options.baseline_path.empty()) {
+        auto regressions = bench.compareBaseline();
+
+        if (regressions > 0) {
+            std::cout << std::format("{} case(s) regressed beyond {:.0f}%\n", regressions, options.threshold * 100);
+            return 2;
+        }
+    }
+}
@@ -0,0 +1,344 @@
+/**
+ * @file BenchPipeline.cpp
+ * @author DrkWithT
+ * @brief Implements end-to-end throughput benchmark: lex, parse, validate, emit, derive & eval over a generated corpus.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <format>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Benchmarks/BenchSupport.hpp"
+#include "Benchmarks/PerfCounters.hpp"
+#include "Frontend/Lexer.hpp"
+#include "Frontend/Parser.hpp"
+#include "Syntax/AstNodes.hpp"
+#include "Backend/AstValidator.hpp"
+#include "Backend/FuncEmitter.hpp"
+#include "Models/Composite.hpp"
+#include "Utils/ExprGenerator.hpp"
+
+using MyClock = std::chrono::steady_clock;
+using MyAstPtr = std::unique_ptr<GeneralDeriver::Syntax::IAstNode>;
+using MyGenConfig = GeneralDeriver::Utils::ExprGenConfig;
+namespace MyBench = GeneralDeriver::Benchmarks;
+
+static constexpr std::size_t default_expr_count = 20000;
+static constexpr std::size_t default_eval_points = 8;
+
+struct PipelineOptions {
+    MyGenConfig gen;
+    std::size_t expr_count = default_expr_count;
+    std::size_t eval_points = default_eval_points;
+    bool perf = false;
+};
+
+/// @brief Totals of one pipeline stage. `nodes` counts tokens for lexing and AST nodes of the handled expressions otherwise.
+struct StageReport {
+    std::string_view name;
+    double seconds;
+    std::size_t exprs;
+    std::size_t nodes;
+    MyBench::AllocStats allocs;
+    std::uint64_t peak_rss_kb;
+    MyBench::PerfReading perf;
+};
+
+/// @brief Times one stage & diffs the allocation counters around it. With counters given, also counts hardware events over the stage.
+class StageProbe {
+private:
+    std::string_view name;
+    MyBench::PerfCounters* counters;
+    MyClock::time_point start;
+    MyBench::AllocStats allocs_before;
+
+public:
+    StageProbe(std::string_view name_, MyBench::PerfCounters* counters_)
+    : name {name_}, counters {counters_}, start {}, allocs_before {MyBench::readAllocStats()} {
+        if (counters != nullptr) {
+            counters->start();
+        }
+
+        start = MyClock::now();
+    }
+
+    [[nodiscard]] StageReport finish(std::size_t exprs, std::size_t nodes) const {
+        const auto stop = MyClock::now();
+        const auto perf = (counters != nullptr) ? counters->stop() : MyBench::PerfReading {};
+        const auto allocs_after = MyBench::readAllocStats();
+
+        return {
+            name,
+            std::chrono::duration<double>(stop - start).count(),
+            exprs,
+            nodes,
+            {allocs_after.count - allocs_before.count, allocs_after.bytes - allocs_before.bytes, allocs_after.frees - allocs_before.frees},
+            MyBench::readPeakRssKb(),
+            perf
+        };
+    }
+};
+
+[[nodiscard]] std::size_t countNodes(const GeneralDeriver::Syntax::IAstNode& node) {
+    using GeneralDeriver::Syntax::AstNodeType;
+
+    switch (node.getType()) {
+    case AstNodeType::unary:
+        return 1 + countNodes(*static_cast<const GeneralDeriver::Syntax::Unary&>(node).getInnerPtr());
+    case AstNodeType::binary: {
+        const auto& binary = static_cast<const GeneralDeriver::Syntax::Binary&>(node);
+        return 1 + countNodes(*binary.getLeft()) + countNodes(*binary.getRight());
+    }
+    default:
+        return 1;
+    }
+}
+
+/// @note Random points leave the domain of e.g ln often, so the checksum keeps only finite results.
+void addFinite(double& sum, double value) {
+    if (std::isfinite(value)) {
+        sum += value;
+    }
+}
+
+[[nodiscard]] bool parseOptions(int argc, char* argv[], PipelineOptions& options) {
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string_view flag {argv[i]};
+        const auto value = std::stoull(argv[i + 1]);
+
+        if (flag == "--count") {
+            options.expr_count = value;
+        } else if (flag == "--seed") {
+            options.gen.seed = value;
+        } else if (flag == "--depth") {
+            options.gen.max_depth = value;
+        } else if (flag == "--terms") {
+            options.gen.max_terms = value;
+        } else if (flag == "--factors") {
+            options.gen.max_factors = value;
+        } else if (flag == "--vars") {
+            options.gen.variable_count = value;
+        } else if (flag == "--exponent") {
+            options.gen.max_exponent = static_cast<std::uint32_t>(value);
+        } else if (flag == "--points") {
+            options.eval_points = value;
+        } else if (flag == "--perf") {
+            options.perf = value != 0;
+        } else {
+            return false;
+        }
+    }
+
+    return argc % 2 == 1;
+}
+
+void printReports(const std::vector<StageReport>& reports) {
+    std::cout << std::format("{:<10}{:>10}{:>12}{:>14}{:>14}{:>12}{:>12}{:>14}\n", "stage", "exprs", "time_ms", "exprs/s", "nodes/s", "allocs", "alloc_KiB", "peak_rss_KiB");
+
+    for (const auto& report : reports) {
+        const double seconds = (report.seconds > 0.0) ? report.seconds : 1e-9;
+
+        std::cout << std::format(
+            "{:<10}{:>10}{:>12.2f}{:>14.0f}{:>14.0f}{:>12}{:>12}{:>14}\n",
+            report.name,
+            report.exprs,
+            report.seconds * 1e3,
+            static_cast<double>(report.exprs) / seconds,
+            static_cast<double>(report.nodes) / seconds,
+            report.allocs.count,
+            report.allocs.bytes / 1024,
+            report.peak_rss_kb
+        );
+    }
+}
+
+/// @note Per expression & per node averages, so stages of different corpus sizes compare directly.
+void printPerfReports(const std::vector<StageReport>& reports) {
+    using MyBench::PerfCounter;
+
+    std::cout << std::format("\n{:<10}{:>14}{:>14}{:>8}{:>14}{:>14}{:>14}{:>14}\n", "stage", "cycles/expr", "instrs/expr", "IPC", "cycles/node", "br_miss/node", "L1d_miss/node", "LLC_miss/node");
+
+    for (const auto& report : reports) {
+        const auto per_expr = report.perf.scaledBy(static_cast<double>(std::max<std::size_t>(report.exprs, 1)));
+        const auto per_node = report.perf.scaledBy(static_cast<double>(std::max<std::size_t>(report.nodes, 1)));
+        const auto showCount = [](const MyBench::PerfReading& reading, PerfCounter counter) {
+            return reading.has(counter) ? std::format("{:.2f}", reading.get(counter)) : std::string {"-"};
+        };
+
+        const bool has_ipc = report.perf.has(PerfCounter::cycles) && report.perf.has(PerfCounter::instructions) && report.perf.get(PerfCounter::cycles) > 0.0;
+
+        std::cout << std::format(
+            "{:<10}{:>14}{:>14}{:>8}{:>14}{:>14}{:>14}{:>14}\n",
+            report.name,
+            showCount(per_expr, PerfCounter::cycles),
+            showCount(per_expr, PerfCounter::instructions),
+            has_ipc ? std::format("{:.2f}", report.perf.get(PerfCounter::instructions) / report.perf.get(PerfCounter::cycles)) : std::string {"-"},
+            showCount(per_node, PerfCounter::cycles),
+            showCount(per_node, PerfCounter::branch_misses),
+            showCount(per_node, PerfCounter::l1d_misses),
+            showCount(per_node, PerfCounter::llc_misses)
+        );
+    }
+}
+
+int main(int argc, char* argv[]) {
+    PipelineOptions options;
+
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Usage: bench_pipeline [--count N] [--seed S] [--depth D] [--terms T] [--factors F] [--vars V] [--exponent E] [--points P] [--perf 0|1]\n";
+        return 1;
+    }
+
+    std::unique_ptr<MyBench::PerfCounters> counters;
+
+    if (options.perf) {
+        counters = std::make_unique<MyBench::PerfCounters>();
+
+        if (!counters->isAvailable()) {
+            std::cerr << std::format("Hardware counters unavailable ({}), timing only\n", counters->getOpenError());
+            counters.reset();
+        }
+    }
+
+    GeneralDeriver::Utils::ExprGenerator generator {options.gen};
+    const auto corpus = generator.generateCorpus(options.expr_count);
+    std::vector<StageReport> reports;
+
+    std::size_t token_count = 0;
+    {
+        StageProbe probe {"lex", counters.get()};
+
+        for (const auto& source : corpus) {
+            GeneralDeriver::Frontend::Lexer lexer {source};
+
+            while (lexer.lexNext().tag != GeneralDeriver::Frontend::TokenType::eos) {
+                token_count++;
+            }
+        }
+
+        reports.push_back(probe.finish(corpus.size(), token_count));
+    }
+
+    std::vector<MyAstPtr> asts;
+    std::vector<std::size_t> node_counts;
+    std::size_t max_slots = 1;
+    asts.reserve(corpus.size());
+    {
+        StageProbe probe {"parse", counters.get()};
+        GeneralDeriver::Frontend::Parser parser;
+
+        for (const auto& source : corpus) {
+            auto result = parser.parseAll(source);
+
+            if (result.ok) {
+                max_slots = std::max(max_slots, result.variables.size());
+                asts.push_back(std::move(result.root));
+            }
+        }
+
+        auto report = probe.finish(asts.size(), 0);
+
+        for (const auto& ast : asts) {
+            node_counts.push_back(countNodes(*ast));
+        }
+
+        for (auto count : node_counts) {
+            report.nodes += count;
+        }
+
+        reports.push_back(report);
+    }
+
+    std::vector<std::size_t> valid_ids;
+    std::size_t valid_nodes = 0;
+    {
+        StageProbe probe {"validate", counters.get()};
+        GeneralDeriver::Backend::AstValidator validator;
+
+        for (std::size_t i = 0; i < asts.size(); i++) {
+            if (validator.foldAst(asts[i])) {
+                valid_ids.push_back(i);
+                valid_nodes += node_counts[i];
+            }
+
+            validator.clearState();
+        }
+
+        auto report = probe.finish(asts.size(), 0);
+
+        for (auto count : node_counts) {
+            report.nodes += count;
+        }
+
+        reports.push_back(report);
+    }
+
+    std::vector<GeneralDeriver::Models::Composite> functions;
+    functions.reserve(valid_ids.size());
+    {
+        StageProbe probe {"emit", counters.get()};
+        GeneralDeriver::Backend::FunctionEmitter emitter;
+
+        for (auto id : valid_ids) {
+            functions.push_back(emitter.emitFunction(asts[id]));
+        }
+
+        reports.push_back(probe.finish(functions.size(), valid_nodes));
+    }
+
+    std::vector<GeneralDeriver::Models::FunctionAny> derivatives;
+    std::size_t underived_count = 0;
+    derivatives.reserve(functions.size());
+    {
+        StageProbe probe {"derive", counters.get()};
+
+        for (const auto& fn : functions) {
+            derivatives.push_back(fn.makeDerivative());
+        }
+
+        reports.push_back(probe.finish(derivatives.size(), valid_nodes));
+    }
+
+    // Functions without a derivative rule give an empty derivative, which eval skips.
+    for (const auto& derivative : derivatives) {
+        underived_count += (derivative.getStoragePtr() == nullptr) ? 1 : 0;
+    }
+
+    double checksum = 0.0;
+    {
+        std::vector<double> point (max_slots, 0.5);
+        StageProbe probe {"eval", counters.get()};
+
+        for (std::size_t i = 0; i < functions.size(); i++) {
+            for (std::size_t p = 0; p < options.eval_points; p++) {
+                point[0] = 0.25 + 0.125 * static_cast<double>(p);
+                addFinite(checksum, functions[i].evalAtPoint(point));
+
+                if (const auto* derivative = derivatives[i].getStoragePtr(); derivative != nullptr) {
+                    addFinite(checksum, derivative->evalAtPoint(point));
+                }
+            }
+        }
+
+        reports.push_back(probe.finish(functions.size(), valid_nodes * options.eval_points));
+    }
+
+    std::cout << std::format(
+        "corpus: {} exprs, seed {}, {} rejected by validation, {} without derivative, eval checksum {}\n",
+        corpus.size(), options.gen.seed, asts.size() - valid_ids.size(), underived_count, checksum
+    );
+    printReports(reports);
+
+    if (counters != nullptr) {
+        printPerfReports(reports);
+    }
+}
@@ -0,0 +1,21 @@
+/**
+ * @file BenchSupport.cpp
+ * @author DrkWithT
+ * @brief Implements memory usage probes for benchmarks.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <sys/resource.h>
+#include "Benchmarks/BenchSupport.hpp"
+
+namespace GeneralDeriver::Benchmarks {
+    std::uint64_t readPeakRssKb() {
+        rusage usage {};
+        getrusage(RUSAGE_SELF, &usage);
+
+        return static_cast<std::uint64_t>(usage.ru_maxrss);
+    }
+}
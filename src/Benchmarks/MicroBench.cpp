@@ -0,0 +1,222 @@
+/**
+ * @file MicroBench.cpp
+ * @author DrkWithT
+ * @brief Implements microbenchmark statistics, JSON output & baseline comparison.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <unordered_map>
+#include "Benchmarks/MicroBench.hpp"
+
+namespace GeneralDeriver::Benchmarks {
+    static constexpr std::string_view name_key = "\"name\": \"";
+    static constexpr std::string_view median_key = "\"median_ns\": ";
+
+    bool parseBenchOptions(int argc, char* argv[], BenchOptions& options) {
+        for (int i = 1; i + 1 < argc; i += 2) {
+            std::string_view flag {argv[i]};
+            std::string value {argv[i + 1]};
+
+            if (flag == "--filter") {
+                options.filter = value;
+            } else if (flag == "--reps") {
+                options.repetitions = std::max<std::size_t>(std::stoull(value), 1);
+            } else if (flag == "--warmup") {
+                options.warmup_runs = std::stoull(value);
+            } else if (flag == "--min-time") {
+                options.min_rep_seconds = std::stod(value);
+            } else if (flag == "--json") {
+                options.json_path = value;
+            } else if (flag == "--compare") {
+                options.baseline_path = value;
+            } else if (flag == "--threshold") {
+                options.threshold = std::stod(value);
+            } else if (flag == "--perf") {
+                options.perf = value != "0";
+            } else {
+                return false;
+            }
+        }
+
+        return argc % 2 == 1;
+    }
+
+    BenchStats summarizeSamples(std::string_view name, std::size_t iterations, std::vector<double>& samples_ns) {
+        std::sort(samples_ns.begin(), samples_ns.end());
+
+        const std::size_t count = samples_ns.size();
+        const double mean = std::accumulate(samples_ns.begin(), samples_ns.end(), 0.0) / static_cast<double>(count);
+        const double median = (count % 2 == 1)
+            ? samples_ns[count / 2]
+            : 0.5 * (samples_ns[count / 2 - 1] + samples_ns[count / 2]);
+
+        double square_sum = 0.0;
+
+        for (double sample : samples_ns) {
+            square_sum += (sample - mean) * (sample - mean);
+        }
+
+        const double stddev = (count > 1) ? std::sqrt(square_sum / static_cast<double>(count - 1)) : 0.0;
+
+        return {std::string {name}, iterations, count, samples_ns.front(), median, mean, stddev};
+    }
+
+    /// @note Reads back only what `writeJson` writes: one case object per line.
+    static std::unordered_map<std::string, double> readBaselineMedians(const std::string& path) {
+        std::unordered_map<std::string, double> medians;
+        std::ifstream fin {path};
+        std::string line;
+
+        while (std::getline(fin, line)) {
+            const auto name_pos = line.find(name_key);
+            const auto median_pos = line.find(median_key);
+
+            if (name_pos == std::string::npos || median_pos == std::string::npos) {
+                continue;
+            }
+
+            const auto name_begin = name_pos + name_key.size();
+            const auto name_end = line.find('"', name_begin);
+
+            medians[line.substr(name_begin, name_end - name_begin)] = std::stod(line.substr(median_pos + median_key.size()));
+        }
+
+        return medians;
+    }
+
+    MicroBench::MicroBench(const BenchOptions& options_)
+    : options {options_}, results {}, counters {} {
+        if (!options.perf) {
+            return;
+        }
+
+        counters = std::make_unique<PerfCounters>();
+
+        if (!counters->isAvailable()) {
+            std::cerr << std::format("Hardware counters unavailable ({}), timing only\n", counters->getOpenError());
+            counters.reset();
+        }
+    }
+
+    const std::vector<BenchStats>& MicroBench::getResults() const { return results; }
+
+    void MicroBench::printSummary() const {
+        std::cout << std::format("{:<40}{:>12}{:>14}{:>14}{:>14}{:>12}\n", "case", "iters", "min_ns", "median_ns", "mean_ns", "stddev%");
+
+        for (const auto& stats : results) {
+            const double spread = (stats.mean_ns > 0.0) ? 100.0 * stats.stddev_ns / stats.mean_ns : 0.0;
+
+            std::cout << std::format("{:<40}{:>12}{:>14.1f}{:>14.1f}{:>14.1f}{:>12.1f}\n", stats.name, stats.iterations, stats.min_ns, stats.median_ns, stats.mean_ns, spread);
+        }
+    }
+
+    void MicroBench::printPerfSummary() const {
+        if (counters == nullptr) {
+            return;
+        }
+
+        std::cout << std::format("\n{:<40}{:>12}{:>12}{:>8}{:>12}{:>12}{:>12}{:>14}\n", "case", "cycles/op", "instrs/op", "IPC", "br_miss/op", "L1d_miss/op", "LLC_miss/op", "cycles/node");
+
+        for (const auto& stats : results) {
+            const auto& perf = stats.perf_per_op;
+            const auto showCount = [&perf](PerfCounter counter) {
+                return perf.has(counter) ? std::format("{:.1f}", perf.get(counter)) : std::string {"-"};
+            };
+
+            const bool has_ipc = perf.has(PerfCounter::cycles) && perf.has(PerfCounter::instructions) && perf.get(PerfCounter::cycles) > 0.0;
+            const bool has_per_node = perf.has(PerfCounter::cycles) && stats.nodes_per_op > 0;
+
+            std::cout << std::format(
+                "{:<40}{:>12}{:>12}{:>8}{:>12}{:>12}{:>12}{:>14}\n",
+                stats.name,
+                showCount(PerfCounter::cycles),
+                showCount(PerfCounter::instructions),
+                has_ipc ? std::format("{:.2f}", perf.get(PerfCounter::instructions) / perf.get(PerfCounter::cycles)) : std::string {"-"},
+                showCount(PerfCounter::branch_misses),
+                showCount(PerfCounter::l1d_misses),
+                showCount(PerfCounter::llc_misses),
+                has_per_node ? std::format("{:.2f}", perf.get(PerfCounter::cycles) / static_cast<double>(stats.nodes_per_op)) : std::string {"-"}
+            );
+        }
+    }
+
+    bool MicroBench::writeJson() const {
+        std::ofstream fout {options.json_path};
+
+        if (!fout) {
+            std::cerr << std::format("Cannot write benchmark JSON to {}\n", options.json_path);
+            return false;
+        }
+
+        fout << "{\n  \"benchmarks\": [\n";
+
+        for (std::size_t i = 0; i < results.size(); i++) {
+            const auto& stats = results[i];
+
+            std::string perf_fields;
+
+            for (std::size_t c = 0; c < perf_counter_count; c++) {
+                if (stats.perf_per_op.valid[c]) {
+                    perf_fields += std::format(", \"{}_per_op\": {}", getPerfCounterName(static_cast<PerfCounter>(c)), stats.perf_per_op.counts[c]);
+                }
+            }
+
+            if (stats.nodes_per_op > 0) {
+                perf_fields += std::format(", \"nodes_per_op\": {}", stats.nodes_per_op);
+            }
+
+            fout << std::format(
+                "    {{\"name\": \"{}\", \"iterations\": {}, \"repetitions\": {}, \"min_ns\": {}, \"median_ns\": {}, \"mean_ns\": {}, \"stddev_ns\": {}{}}}{}\n",
+                stats.name, stats.iterations, stats.repetitions, stats.min_ns, stats.median_ns, stats.mean_ns, stats.stddev_ns, perf_fields,
+                (i + 1 < results.size()) ? "," : ""
+            );
+        }
+
+        fout << "  ]\n}\n";
+
+        return static_cast<bool>(fout);
+    }
+
+    std::size_t MicroBench::compareBaseline() const {
+        const auto baseline = readBaselineMedians(options.baseline_path);
+        std::size_t regressions = 0;
+
+        std::cout << std::format("{:<40}{:>14}{:>14}{:>10}\n", "case", "base_ns", "now_ns", "ratio");
+
+        for (const auto& stats : results) {
+            auto base_it = baseline.find(stats.name);
+
+            if (base_it == baseline.end()) {
+                std::cout << std::format("{:<40}{:>14}{:>14.1f}{:>10}  (new)\n", stats.name, "-", stats.median_ns, "-");
+                continue;
+            }
+
+            const double ratio = stats.median_ns / base_it->second;
+            const bool regressed = ratio > 1.0 + options.threshold;
+
+            regressions += regressed ? 1 : 0;
+
+            std::cout << std::format("{:<40}{:>14.1f}{:>14.1f}{:>10.3f}{}\n", stats.name, base_it->second, stats.median_ns, ratio, regressed ? "  REGRESSION" : "");
+        }
+
+        for (const auto& [name, median] : baseline) {
+            auto found = std::find_if(results.begin(), results.end(), [&name](const BenchStats& stats) { return stats.name == name; });
+
+            if (found == results.end() && (options.filter.empty() || name.find(options.filter) != std::string::npos)) {
+                std::cout << std::format("{:<40}{:>14.1f}{:>14}{:>10}  (missing)\n", name, median, "-", "-");
+            }
+        }
+
+        return regressions;
+    }
+}
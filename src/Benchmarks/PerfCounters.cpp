@@ -0,0 +1,178 @@
+/**
+ * @file PerfCounters.cpp
+ * @author DrkWithT
+ * @brief Implements hardware performance counter reads through Linux perf events.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include "Benchmarks/PerfCounters.hpp"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace GeneralDeriver::Benchmarks {
+    static constexpr int closed_fd = -1;
+
+    std::string_view getPerfCounterName(PerfCounter counter) {
+        switch (counter) {
+        case PerfCounter::cycles:
+            return "cycles";
+        case PerfCounter::instructions:
+            return "instructions";
+        case PerfCounter::branch_misses:
+            return "branch-misses";
+        case PerfCounter::l1d_misses:
+            return "L1d-misses";
+        case PerfCounter::llc_misses:
+        default:
+            return "LLC-misses";
+        }
+    }
+
+    bool PerfReading::hasAny() const {
+        return std::any_of(valid.begin(), valid.end(), [](bool flag) { return flag; });
+    }
+
+    double PerfReading::get(PerfCounter counter) const {
+        return counts[static_cast<std::size_t>(counter)];
+    }
+
+    bool PerfReading::has(PerfCounter counter) const {
+        return valid[static_cast<std::size_t>(counter)];
+    }
+
+    PerfReading PerfReading::scaledBy(double divisor) const {
+        PerfReading result = *this;
+
+        for (auto& count : result.counts) {
+            count /= divisor;
+        }
+
+        return result;
+    }
+
+#ifdef __linux__
+    /// @note Cache events pack cache id, op and result into one config value, see `perf_event_open(2)`.
+    static constexpr std::uint64_t makeCacheConfig(std::uint64_t cache_id) {
+        return cache_id | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    }
+
+    static perf_event_attr makeEventAttr(PerfCounter counter) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+
+        attr.size = sizeof(attr);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        switch (counter) {
+        case PerfCounter::cycles:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+        case PerfCounter::instructions:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+        case PerfCounter::branch_misses:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+            break;
+        case PerfCounter::l1d_misses:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = makeCacheConfig(PERF_COUNT_HW_CACHE_L1D);
+            break;
+        case PerfCounter::llc_misses:
+        default:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = makeCacheConfig(PERF_COUNT_HW_CACHE_LL);
+            break;
+        }
+
+        return attr;
+    }
+
+    PerfCounters::PerfCounters()
+    : fds {}, open_error {} {
+        for (std::size_t i = 0; i < perf_counter_count; i++) {
+            auto attr = makeEventAttr(static_cast<PerfCounter>(i));
+
+            // pid 0 & cpu -1: this thread, on whichever CPU it runs.
+            fds[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+
+            if (fds[i] == closed_fd && open_error.empty()) {
+                open_error = std::string {getPerfCounterName(static_cast<PerfCounter>(i))} + ": " + std::strerror(errno);
+            }
+        }
+    }
+
+    PerfCounters::~PerfCounters() {
+        for (int fd : fds) {
+            if (fd != closed_fd) {
+                close(fd);
+            }
+        }
+    }
+
+    void PerfCounters::start() {
+        for (int fd : fds) {
+            if (fd != closed_fd) {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+    }
+
+    PerfReading PerfCounters::stop() {
+        PerfReading reading;
+
+        for (int fd : fds) {
+            if (fd != closed_fd) {
+                ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            }
+        }
+
+        for (std::size_t i = 0; i < perf_counter_count; i++) {
+            std::uint64_t values[3] {}; // value, time enabled, time running
+
+            if (fds[i] == closed_fd || read(fds[i], values, sizeof(values)) != static_cast<ssize_t>(sizeof(values)) || values[2] == 0) {
+                continue;
+            }
+
+            reading.counts[i] = static_cast<double>(values[0]) * static_cast<double>(values[1]) / static_cast<double>(values[2]);
+            reading.valid[i] = true;
+        }
+
+        return reading;
+    }
+#else
+    PerfCounters::PerfCounters()
+    : fds {}, open_error {"perf events need Linux"} {
+        fds.fill(closed_fd);
+    }
+
+    PerfCounters::~PerfCounters() = default;
+
+    void PerfCounters::start() {}
+
+    PerfReading PerfCounters::stop() { return {}; }
+#endif
+
+    bool PerfCounters::isAvailable() const {
+        return std::any_of(fds.begin(), fds.end(), [](int fd) { return fd != closed_fd; });
+    }
+
+    const std::string& PerfCounters::getOpenError() const { return open_error; }
+}
@@ -0,0 +1,187 @@
+/**
+ * @file FlatParser.cpp
+ * @author DrkWithT
+ * @brief Implements recursive descent parser for x-exprs into a flat AST buffer.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "Frontend/FlatParser.hpp"
+#include "Frontend/Parser.hpp"
+
+namespace GeneralDeriver::Frontend {
+    using Syntax::FlatIndex;
+
+    const Token& FlatParser::peekCurrent() const { return current; }
+
+    Token FlatParser::advanceToken() {
+        Token temp;
+
+        do {
+            temp = lexer.lexNext();
+        } while (temp.tag == TokenType::spacing);
+
+        return temp;
+    }
+
+    void FlatParser::consumeToken(std::initializer_list<TokenType> expected) {
+        if (expected.size() == 0) {
+            previous = current;
+            current = advanceToken();
+            return;
+        }
+
+        auto current_tag = peekCurrent().tag;
+
+        if (current_tag == TokenType::eos) {
+            return;
+        }
+
+        if (std::find(expected.begin(), expected.end(), current_tag) != expected.end()) {
+            previous = current;
+            current = advanceToken();
+            return;
+        }
+
+        throw std::runtime_error {
+            formatParseError(ParseError::token_err, peekCurrent(), lexer.getSource())
+        };
+    }
+
+    FlatIndex FlatParser::parseLiteral() {
+        auto peeked_tag = peekCurrent().tag;
+
+        if (peeked_tag == TokenType::number) {
+            double n = std::stod(getLexeme(peekCurrent(), lexer.getSource()));
+            consumeToken({});
+
+            return target->addConstant(n);
+        } else if (peeked_tag == TokenType::variable) {
+            auto slot = variables.getSlot(viewLexeme(peekCurrent(), lexer.getSource()));
+            consumeToken({});
+
+            return target->addVariable(slot);
+        } else if (peeked_tag == TokenType::func_name) {
+            auto func_op = getFunctionOp(viewLexeme(peekCurrent(), lexer.getSource()));
+            consumeToken({});
+            consumeToken({TokenType::l_paren});
+            auto argument = parseTerm();
+            consumeToken({TokenType::r_paren});
+
+            return target->addUnary(func_op, argument);
+        } else if (peeked_tag == TokenType::l_paren) {
+            consumeToken({});
+            auto temp = parseTerm();
+            consumeToken({TokenType::r_paren});
+
+            return temp;
+        } else if (peeked_tag == TokenType::op_minus) {
+            return parseUnary();
+        }
+
+        throw std::runtime_error {
+            formatParseError(ParseError::syntax_err, peekCurrent(), lexer.getSource())
+        };
+    }
+
+    FlatIndex FlatParser::parseUnary() {
+        if (peekCurrent().tag == TokenType::op_minus) {
+            consumeToken({});
+            auto inner = parseLiteral();
+
+            return target->addUnary(Syntax::AstOpType::neg, inner);
+        }
+
+        return parseLiteral();
+    }
+
+    FlatIndex FlatParser::parsePower() {
+        auto power_target = parseUnary();
+
+        if (peekCurrent().tag == TokenType::op_power) {
+            consumeToken({});
+            auto exponent = parseLiteral();
+
+            return target->addBinary(Syntax::AstOpType::power, power_target, exponent);
+        }
+
+        return power_target;
+    }
+
+    FlatIndex FlatParser::parseFactor() {
+        auto lhs = parsePower();
+
+        do {
+            auto current_tag = peekCurrent().tag;
+
+            if (current_tag != TokenType::op_times && current_tag != TokenType::op_slash) {
+                break;
+            }
+
+            auto op = (current_tag == TokenType::op_times)
+                ? Syntax::AstOpType::mul
+                : Syntax::AstOpType::div;
+
+            consumeToken({});
+
+            auto rhs = parsePower();
+
+            lhs = target->addBinary(op, lhs, rhs);
+        } while (true);
+
+        return lhs;
+    }
+
+    FlatIndex FlatParser::parseTerm() {
+        auto lhs = parseFactor();
+
+        do {
+            auto current_tag = peekCurrent().tag;
+
+            if (current_tag != TokenType::op_plus && current_tag != TokenType::op_minus) {
+                break;
+            }
+
+            auto op = (current_tag == TokenType::op_plus)
+                ? Syntax::AstOpType::add
+                : Syntax::AstOpType::sub;
+
+            consumeToken({});
+
+            auto rhs = parseFactor();
+
+            lhs = target->addBinary(op, lhs, rhs);
+        } while (true);
+
+        return lhs;
+    }
+
+    FlatParser::FlatParser()
+    : lexer {}, variables {}, current {0, 1, TokenType::unknown}, previous {0, 1, TokenType::unknown}, target {nullptr} {}
+
+    /// @note A parenthesized root returns an inner index, but nodes are still appended in post-order, so the root is always the last node.
+    bool FlatParser::parseAll(const std::string& source_arg, Syntax::FlatAst& buffer) {
+        lexer = Lexer(source_arg);
+        variables.clearState();
+        target = &buffer;
+        target->clear();
+        consumeToken({});
+
+        try {
+            [[maybe_unused]] auto root = parseTerm();
+            target->setVariableNames(variables.getNames());
+
+            return true;
+        } catch (const std::runtime_error& parse_err) {
+            std::cerr << "\033[31;1m" << parse_err.what() << "\033[0m";
+        }
+
+        return false;
+    }
+}
@@ -21,6 +21,26 @@ namespace GeneralDeriver::Frontend {
         return (s >= '0' && s <= '9') || s == '.';
     }
 
+    bool isAlphabetic(char s) {
+        return (s >= 'a' && s <= 'z') || (s >= 'A' && s <= 'Z');
+    }
+
+    Syntax::AstOpType getFunctionOp(std::string_view name) {
+        if (name == "sin") {
+            return Syntax::AstOpType::sin;
+        } else if (name == "cos") {
+            return Syntax::AstOpType::cos;
+        } else if (name == "exp") {
+            return Syntax::AstOpType::exp;
+        } else if (name == "ln") {
+            return Syntax::AstOpType::ln;
+        } else if (name == "sqrt") {
+            return Syntax::AstOpType::sqrt;
+        }
+
+        return Syntax::AstOpType::none;
+    }
+
     bool Lexer::isAtEOS() const {
         return pos >= limit;
     }
@@ -76,6 +96,31 @@ namespace GeneralDeriver::Frontend {
         }
     }
 
+    /// @note Words are function names or else variable names, which start with a letter and may go on with digits or underscores.
+    Token Lexer::lexWord() {
+        std::size_t tbegin = pos;
+        std::size_t tlen = 0;
+
+        while (pos < limit) {
+            char temp = source[pos];
+
+            if (!isAlphabetic(temp) && !(temp >= '0' && temp <= '9') && temp != '_') {
+                break;
+            }
+
+            tlen++;
+            pos++;
+        }
+
+        std::string_view word {source.data() + tbegin, tlen};
+
+        if (getFunctionOp(word) != Syntax::AstOpType::none) {
+            return {tbegin, tlen, TokenType::func_name};
+        }
+
+        return {tbegin, tlen, TokenType::variable};
+    }
+
     Lexer::Lexer()
     : source {""}, pos {0}, limit {0} {}
 
@@ -112,6 +157,10 @@ namespace GeneralDeriver::Frontend {
         return source;
     }
 
+    void Lexer::seekTo(std::size_t pos_) {
+        pos = (pos_ < limit) ? pos_ : limit;
+    }
+
     Token Lexer::lexNext() {
         if (isAtEOS()) {
             return {pos, 1, TokenType::eos};
@@ -124,14 +173,14 @@ namespace GeneralDeriver::Frontend {
                 return lexSingle(TokenType::l_paren);
             case ')':
                 return lexSingle(TokenType::r_paren);
-            case 'x':
-                return lexSingle(TokenType::variable);
             case '+':
                 return lexSingle(TokenType::op_plus);
             case '-':
                 return lexSingle(TokenType::op_minus);
-            // case '*':
-            // case '/':
+            case '*':
+                return lexSingle(TokenType::op_times);
+            case '/':
+                return lexSingle(TokenType::op_slash);
             case '^':
                 return lexSingle(TokenType::op_power);
             default:
@@ -142,6 +191,8 @@ namespace GeneralDeriver::Frontend {
             return lexSpacing();
         } else if (isNumeric(temp)) {
             return lexNumber();
+        } else if (isAlphabetic(temp)) {
+            return lexWord();
         } else {
             return {pos++, 1, TokenType::unknown};
         }
@@ -92,9 +92,19 @@ namespace GeneralDeriver::Frontend {
 
             return std::make_unique<Syntax::Constant>(n);
         } else if (peeked_tag == TokenType::variable) {
+            auto name = getLexeme(peekCurrent(), lexer.getSource());
             consumeToken({});
+            auto slot = variables.getSlot(name);
 
-            return std::make_unique<Syntax::VarStub>();
+            return std::make_unique<Syntax::VarStub>(name, slot);
+        } else if (peeked_tag == TokenType::func_name) {
+            auto func_op = getFunctionOp(viewLexeme(peekCurrent(), lexer.getSource()));
+            consumeToken({});
+            consumeToken({TokenType::l_paren});
+            auto argument = parseTerm();
+            consumeToken({TokenType::r_paren});
+
+            return std::make_unique<Syntax::Unary>(func_op, std::move(argument));
         } else if (peeked_tag == TokenType::l_paren) {
             consumeToken({});
             auto temp = parseTerm();
@@ -134,9 +144,33 @@ namespace GeneralDeriver::Frontend {
         return power_target;
     }
 
-    std::unique_ptr<Syntax::IAstNode> Parser::parseTerm() {
+    std::unique_ptr<Syntax::IAstNode> Parser::parseFactor() {
         auto lhs = parsePower();
 
+        do {
+            auto current_tag = peekCurrent().tag;
+
+            if (current_tag != TokenType::op_times && current_tag != TokenType::op_slash) {
+                break;
+            }
+
+            auto op = (current_tag == TokenType::op_times)
+                ? Syntax::AstOpType::mul
+                : Syntax::AstOpType::div;
+
+            consumeToken({});
+
+            auto rhs = parsePower();
+
+            lhs = std::make_unique<Syntax::Binary>(op, std::move(lhs), std::move(rhs));
+        } while (true);
+
+        return lhs;
+    }
+
+    std::unique_ptr<Syntax::IAstNode> Parser::parseTerm() {
+        auto lhs = parseFactor();
+
         do {
             auto current_tag = peekCurrent().tag;
 
@@ -150,7 +184,7 @@ namespace GeneralDeriver::Frontend {
 
             consumeToken({});
 
-            auto rhs = parsePower();
+            auto rhs = parseFactor();
 
             lhs = std::make_unique<Syntax::Binary>(op, std::move(lhs), std::move(rhs));
         } while (true);
@@ -159,21 +193,24 @@ namespace GeneralDeriver::Frontend {
     }
 
     Parser::Parser()
-    : lexer {}, current {0, 1, TokenType::unknown}, previous {0, 1, TokenType::unknown} {}
+    : lexer {}, variables {}, current {0, 1, TokenType::unknown}, previous {0, 1, TokenType::unknown} {}
 
     Parser::Parser(const std::string& source_)
-    : lexer {source_}, current {0, 1, TokenType::unknown}, previous {0, 1, TokenType::unknown} {}
+    : lexer {source_}, variables {}, current {0, 1, TokenType::unknown}, previous {0, 1, TokenType::unknown} {}
 
     ParseResult Parser::parseAll(const std::string& source_arg) {
         lexer = Lexer(source_arg);
+        variables.clearState();
         consumeToken({});
 
         try {
-            return {parseTerm(), true};
+            auto root = parseTerm();
+
+            return {std::move(root), variables.getNames(), true};
         } catch (const std::runtime_error& parse_err) {
             std::cerr << "\033[31;1m" << parse_err.what() << "\033[0m";
         }
 
-        return {nullptr, false};
+        return {nullptr, {}, false};
     }
 }
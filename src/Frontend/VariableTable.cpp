@@ -0,0 +1,38 @@
+/**
+ * @file VariableTable.cpp
+ * @author DrkWithT
+ * @brief Implements variable name to slot table.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include "Frontend/VariableTable.hpp"
+
+namespace GeneralDeriver::Frontend {
+    static constexpr const char* primary_variable_name = "x";
+
+    VariableTable::VariableTable()
+    : names {primary_variable_name} {}
+
+    std::size_t VariableTable::getSlot(std::string_view name) {
+        auto name_it = std::find(names.begin(), names.end(), name);
+
+        if (name_it != names.end()) {
+            return static_cast<std::size_t>(name_it - names.begin());
+        }
+
+        names.emplace_back(name);
+
+        return names.size() - 1;
+    }
+
+    const std::vector<std::string>& VariableTable::getNames() const { return names; }
+
+    void VariableTable::clearState() {
+        names.clear();
+        names.emplace_back(primary_variable_name);
+    }
+}
@@ -1,7 +1,7 @@
 /**
  * @file Main.cpp
  * @author DrkWithT
- * @brief Implements test program.
+ * @brief Implements command-line driver: derives one x-expression and evaluates it & its derivative at some x, or serves evaluations over a Unix socket.
  * @version 0.0.1
  * @date 2024-09-02
  * 
@@ -9,10 +9,307 @@
  * 
  */
 
-// #include <format>
+#include <cerrno>
+#include <charconv>
+#include <csignal>
+#include <cstring>
+#include <format>
+#include <fstream>
 #include <iostream>
-// #include <vector>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "Frontend/Lexer.hpp"
+#include "Frontend/Parser.hpp"
+#include "Backend/AstValidator.hpp"
+#include "Backend/FuncEmitter.hpp"
+#include "Models/Composite.hpp"
+#include "Models/DerivativeBudget.hpp"
+#include "Models/IntPower.hpp"
+#include "Models/ParameterEvaluator.hpp"
+#include "Models/Tape.hpp"
+#include "Service/EvalServer.hpp"
+#include "Utils/Instrument.hpp"
 
-int main() {
-    std::cout << "Hello World!\n";
-}
\ No newline at end of file
+#ifdef GD_INSTRUMENT
+#include "Benchmarks/AllocTracking.hpp"
+#endif
+
+using MyStage = GeneralDeriver::Utils::Stage;
+using MyStageTimer = GeneralDeriver::Utils::StageTimer;
+
+struct DriverOptions {
+    std::string source;
+    std::string trace_path;
+    std::string serve_path;
+    GeneralDeriver::Models::DerivativeBudget budget;
+    std::vector<std::pair<std::string, double>> params; // from --param NAME=VALUE
+    GeneralDeriver::Models::Precision precision = GeneralDeriver::Models::Precision::f64;
+    double x = 0.0;
+    bool show_stats = false;
+};
+
+/// @note Gives false unless all of `text` is one number of `Number`'s type, so bad flag values end in the usage line.
+template <typename Number>
+[[nodiscard]] bool parseNumber(std::string_view text, Number& out) {
+    const auto [number_end, number_errc] = std::from_chars(text.data(), text.data() + text.size(), out);
+
+    return number_errc == std::errc {} && number_end == text.data() + text.size();
+}
+
+[[nodiscard]] bool parseOptions(int argc, char* argv[], DriverOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string_view arg {argv[i]};
+
+        if (arg == "--stats") {
+            options.show_stats = true;
+        } else if (arg == "--x" && i + 1 < argc) {
+            if (!parseNumber(argv[++i], options.x)) {
+                return false;
+            }
+        } else if (arg == "--param" && i + 1 < argc) {
+            std::string_view binding {argv[++i]};
+            const auto equals_pos = binding.find('=');
+
+            double value = 0.0;
+
+            if (equals_pos == std::string_view::npos || equals_pos == 0 || !parseNumber(binding.substr(equals_pos + 1), value)) {
+                return false;
+            }
+
+            options.params.emplace_back(binding.substr(0, equals_pos), value);
+        } else if (arg == "--precision" && i + 1 < argc) {
+            std::string_view precision_name {argv[++i]};
+
+            if (precision_name == "f32") {
+                options.precision = GeneralDeriver::Models::Precision::f32;
+            } else if (precision_name == "f64") {
+                options.precision = GeneralDeriver::Models::Precision::f64;
+            } else {
+                return false;
+            }
+        } else if (arg == "--trace" && i + 1 < argc) {
+            options.trace_path = argv[++i];
+        } else if (arg == "--max-derivative-nodes" && i + 1 < argc) {
+            if (!parseNumber(argv[++i], options.budget.max_derivative_nodes)) {
+                return false;
+            }
+        } else if (arg == "--max-derivative-bytes" && i + 1 < argc) {
+            if (!parseNumber(argv[++i], options.budget.max_derivative_bytes)) {
+                return false;
+            }
+        } else if (arg == "--serve" && i + 1 < argc) {
+            options.serve_path = argv[++i];
+        } else if (options.source.empty() && !arg.starts_with("--")) {
+            options.source = arg;
+        } else {
+            return false;
+        }
+    }
+
+    return options.source.empty() != options.serve_path.empty();
+}
+
+static GeneralDeriver::Service::EvalServer* active_server = nullptr;
+
+extern "C" void stopActiveServer([[maybe_unused]] int signal_number) {
+    active_server->requestStop();
+}
+
+[[nodiscard]] int runServer(const DriverOptions& options) {
+    GeneralDeriver::Service::EvalServer server {options.serve_path, options.budget};
+
+    if (!server.start()) {
+        std::cerr << std::format("Cannot listen on {}: {}\n", options.serve_path, std::strerror(errno));
+        return 1;
+    }
+
+    active_server = &server;
+    std::signal(SIGINT, stopActiveServer);
+    std::signal(SIGTERM, stopActiveServer);
+
+    std::cerr << std::format("serving on {}\n", options.serve_path);
+    const auto stats = server.run();
+
+    std::signal(SIGINT, SIG_DFL);
+    std::signal(SIGTERM, SIG_DFL);
+    active_server = nullptr;
+
+    std::cerr << std::format(
+        "served {} requests ({} evaluations in {} batches, largest {}), {} errors, {} formulas cached, {} on dual numbers\nlatency us: p50 {:.1f}, p90 {:.1f}, p99 {:.1f}, max {:.1f}\n",
+        stats.requests, stats.evaluations, stats.batches, stats.largest_batch, stats.errors, stats.cached_formulas, stats.numeric_derivatives,
+        stats.p50_us, stats.p90_us, stats.p99_us, stats.max_us
+    );
+
+    return 0;
+}
+
+/// @note Counts function nodes, looking through `IntPower` bases. Shared sub-trees count once per use, like tree evaluation visits them.
+[[nodiscard]] std::size_t countTreeSize(const GeneralDeriver::Models::IFunction* fn) {
+    if (fn == nullptr) {
+        return 0;
+    }
+
+    if (const auto* composite = dynamic_cast<const GeneralDeriver::Models::Composite*>(fn); composite) {
+        return 1 + countTreeSize(composite->getLeft().getStoragePtr()) + countTreeSize(composite->getRight().getStoragePtr());
+    } else if (const auto* power = dynamic_cast<const GeneralDeriver::Models::IntPower*>(fn); power) {
+        return 1 + countTreeSize(power->getBase().getStoragePtr());
+    }
+
+    return 1;
+}
+
+/// @note Runs f & f' as compiled tapes in `Scalar`, which is how single precision callers evaluate them. Throws `std::invalid_argument` for functions without a tape form, like dual-number derivatives.
+template <typename Scalar>
+[[nodiscard]] std::pair<double, double> evalCompiled(const GeneralDeriver::Models::IFunction& fn, const GeneralDeriver::Models::IFunction* derivative, std::span<const double> point) {
+    const std::vector<Scalar> params(point.begin() + 1, point.end());
+    const auto x = static_cast<Scalar>(point[0]);
+
+    GeneralDeriver::Models::Tape fn_tape {fn};
+    GeneralDeriver::Models::BasicParameterEvaluator<Scalar> fn_eval {fn_tape, params.size()};
+    const double y = fn_eval.evalAt(x, params);
+
+    if (derivative == nullptr) {
+        return {y, 0.0};
+    }
+
+    GeneralDeriver::Models::Tape derivative_tape {*derivative};
+    GeneralDeriver::Models::BasicParameterEvaluator<Scalar> derivative_eval {derivative_tape, params.size()};
+
+    return {y, derivative_eval.evalAt(x, params)};
+}
+
+int main(int argc, char* argv[]) {
+    DriverOptions options;
+
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Usage: general_deriver [--x VALUE] [--param NAME=VALUE]... [--precision f32|f64] [--stats] [--trace PATH] [BUDGET] EXPR\n       general_deriver [BUDGET] --serve SOCKET_PATH\nBUDGET: [--max-derivative-nodes N] [--max-derivative-bytes N]\n";
+        return 1;
+    }
+
+    if (!options.serve_path.empty()) {
+        return runServer(options);
+    }
+
+#ifdef GD_INSTRUMENT
+    GeneralDeriver::Benchmarks::attachStageAllocTracking();
+#endif
+
+    if (!options.trace_path.empty()) {
+        GeneralDeriver::Utils::startTrace();
+    }
+
+    {
+        MyStageTimer timer {MyStage::lex};
+        GeneralDeriver::Frontend::Lexer lexer {options.source};
+        std::size_t token_count = 0;
+
+        while (lexer.lexNext().tag != GeneralDeriver::Frontend::TokenType::eos) {
+            token_count++;
+        }
+
+        GeneralDeriver::Utils::noteNodes(token_count);
+    }
+
+    GeneralDeriver::Frontend::ParseResult parsed {nullptr, {}, false};
+    {
+        MyStageTimer timer {MyStage::parse};
+        GeneralDeriver::Frontend::Parser parser;
+        parsed = parser.parseAll(options.source);
+    }
+
+    if (!parsed.ok) {
+        return 1;
+    }
+
+    bool valid = false;
+    {
+        MyStageTimer timer {MyStage::validate};
+        GeneralDeriver::Backend::AstValidator validator;
+        valid = validator.foldAst(parsed.root);
+    }
+
+    if (!valid) {
+        std::cerr << std::format("Invalid expression, as it folds to NaN: {}\n", options.source);
+        return 1;
+    }
+
+    GeneralDeriver::Models::Composite fn;
+    {
+        MyStageTimer timer {MyStage::emit};
+        GeneralDeriver::Backend::FunctionEmitter emitter;
+        fn = emitter.emitFunction(parsed.root);
+    }
+
+    GeneralDeriver::Models::BudgetedDerivative derived {{}, {}, GeneralDeriver::Models::DerivativeStrategy::symbolic};
+    {
+        MyStageTimer timer {MyStage::derive};
+        derived = GeneralDeriver::Models::deriveWithinBudget(fn, options.budget);
+    }
+
+    const auto& derivative = derived.derivative;
+
+    if (derived.strategy == GeneralDeriver::Models::DerivativeStrategy::dual_number) {
+        std::cerr << std::format("Derivative estimate of {} nodes & {} bytes is over budget, so f' uses dual numbers\n", derived.cost.derivative_nodes, derived.cost.derivative_bytes);
+    }
+
+    if constexpr (GeneralDeriver::Utils::instrument_enabled) {
+        GeneralDeriver::Utils::noteTreeSize(countTreeSize(&fn));
+        GeneralDeriver::Utils::noteTreeSize(countTreeSize(derivative.getStoragePtr()));
+    }
+
+    // Parameters bind late, by name, into the evaluation point after x.
+    std::vector<double> point(parsed.variables.size(), std::numeric_limits<double>::quiet_NaN());
+    point[0] = options.x;
+
+    for (const auto& [name, value] : options.params) {
+        const auto index = GeneralDeriver::Models::findParameter(parsed.variables, name);
+
+        if (!index) {
+            std::cerr << std::format("Unknown parameter {}, as the expression does not use it\n", name);
+            return 1;
+        }
+
+        point[*index + 1] = value;
+    }
+
+    double y = 0.0;
+    double dy = 0.0;
+    {
+        MyStageTimer timer {MyStage::eval};
+
+        if (options.precision == GeneralDeriver::Models::Precision::f32) {
+            try {
+                std::tie(y, dy) = evalCompiled<float>(fn, derivative.getStoragePtr(), point);
+            } catch (const std::invalid_argument& error) {
+                std::cerr << std::format("Cannot compile for f32: {}\n", error.what());
+                return 1;
+            }
+        } else {
+            y = fn.evalAtPoint(point);
+            dy = (derivative.getStoragePtr() != nullptr) ? derivative.getStoragePtr()->evalAtPoint(point) : 0.0;
+        }
+    }
+
+    std::cout << std::format("f({}) = {}\nf'({}) = {}\n", options.x, y, options.x, dy);
+
+    if (options.show_stats) {
+        GeneralDeriver::Utils::printStats(std::cerr, GeneralDeriver::Utils::readStats());
+    }
+
+    if (!options.trace_path.empty()) {
+        std::ofstream trace_file {options.trace_path};
+
+        if (!trace_file) {
+            std::cerr << std::format("Cannot write trace file {}\n", options.trace_path);
+            return 1;
+        }
+
+        GeneralDeriver::Utils::writeChromeTrace(trace_file);
+    }
+}
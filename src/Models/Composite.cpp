@@ -8,42 +8,148 @@
  * 
  */
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <string>
-#include <iostream>
 #include "Models/Composite.hpp"
+#include "Models/Constant.hpp"
+#include "Models/IntPower.hpp"
+#include "Models/MathKernels.hpp"
+#include "Models/PolyAlgebra.hpp"
+#include "Models/TextWriter.hpp"
 #include "Backend/FuncEmitter.hpp"
 #include "Models/IFunction.hpp"
 #include "Models/Polynomial.hpp"
 #include "Syntax/IAstNode.hpp"
+#include "Utils/Instrument.hpp"
 
 namespace GeneralDeriver::Models {
-    FunctionAny deriveComposite(Syntax::AstOpType top_op, const FunctionAny& first_child, const FunctionAny& second_child) {
-        auto first = first_child.unpackFunctionAny<Composite>();
-        auto second = second_child.unpackFunctionAny<Composite>();
-        auto first_derived = first.makeDerivative();
-        auto second_derived = second.makeDerivative();
+    static constexpr std::size_t batch_chunk_size = 64;
+
+    std::optional<double> getConstantLeaf(const FunctionAny& fn) {
+        const IFunction* current = fn.getStoragePtr();
+
+        while (current != nullptr) {
+            switch (current->getType()) {
+            case FuncType::constant:
+                return static_cast<const Constant*>(current)->getValue();
+            case FuncType::polynomial:
+                // A power Composite also reports polynomial, so this one needs the checked cast.
+                if (const auto* poly = dynamic_cast<const Polynomial*>(current); poly) {
+                    return getConstantValue(*poly);
+                }
+                return {};
+            case FuncType::none: {
+                const auto* wrapper = static_cast<const Composite*>(current);
+
+                if (wrapper->getArity() != CompositeArity::unary) {
+                    return {};
+                }
+
+                current = wrapper->getLeft().getStoragePtr();
+                break;
+            }
+            default:
+                return {};
+            }
+        }
+
+        return {};
+    }
+
+    static bool isConstantLeafOf(const FunctionAny& fn, double value) {
+        auto leaf_value = getConstantLeaf(fn);
+
+        return leaf_value && *leaf_value == value;
+    }
+
+    /// @brief Wraps a non-empty leaf derivative into a none Composite, since a Composite's derivative must stay a Composite for callers unpacking it.
+    static FunctionAny wrapLeafDerivative(const FunctionAny& derived) {
+        if (const auto* derived_ptr = derived.getStoragePtr(); derived_ptr && !dynamic_cast<const Composite*>(derived_ptr)) {
+            return Composite {Syntax::AstOpType::none, derived, {}};
+        }
+
+        return derived;
+    }
 
+    /// @brief Gives `derived * factor`, or just `factor` when the derivative is the constant 1.
+    static FunctionAny scaleByDerivative(const FunctionAny& factor, const FunctionAny& derived) {
+        if (isConstantLeafOf(derived, 1.0)) {
+            return factor;
+        }
+
+        return Composite {Syntax::AstOpType::mul, derived, factor};
+    }
+
+    /// @note Product rule f'g + fg'. The result holds the same f, g, f' & g' handles instead of copies, so it is a DAG over them and costs a constant factor more to evaluate than f * g. Terms with a zero derivative get dropped, which also covers the emitter's `-1 * f` negations.
+    static FunctionAny assembleProductRule(const FunctionAny& first_child, const FunctionAny& second_child, const FunctionAny& first_derived, const FunctionAny& second_derived) {
+        const bool first_is_constant = isConstantLeafOf(first_derived, 0.0);
+        const bool second_is_constant = isConstantLeafOf(second_derived, 0.0);
+
+        if (first_is_constant && second_is_constant) {
+            return Constant {0.0};
+        } else if (first_is_constant) {
+            return scaleByDerivative(first_child, second_derived);
+        } else if (second_is_constant) {
+            return scaleByDerivative(second_child, first_derived);
+        }
+
+        return Composite {
+            Syntax::AstOpType::add,
+            scaleByDerivative(second_child, first_derived),
+            scaleByDerivative(first_child, second_derived)
+        };
+    }
+
+    /// @note Quotient rule (f'g - fg') / g^2. The square is an `IntPower` over the same g handle, so g appears once per use instead of being re-emitted as g * g. A constant g gives just f' / g.
+    static FunctionAny assembleQuotientRule(const FunctionAny& first_child, const FunctionAny& second_child, const FunctionAny& first_derived, const FunctionAny& second_derived) {
+        const bool first_is_constant = isConstantLeafOf(first_derived, 0.0);
+
+        if (isConstantLeafOf(second_derived, 0.0)) {
+            if (first_is_constant) {
+                return Constant {0.0};
+            }
+
+            return Composite {Syntax::AstOpType::div, first_derived, second_child};
+        }
+
+        FunctionAny numerator = (first_is_constant)
+            ? FunctionAny {Composite {Syntax::AstOpType::mul, Constant {-1.0}, scaleByDerivative(first_child, second_derived)}}
+            : FunctionAny {Composite {Syntax::AstOpType::sub, scaleByDerivative(second_child, first_derived), scaleByDerivative(first_child, second_derived)}};
+
+        return Composite {
+            Syntax::AstOpType::div,
+            numerator,
+            IntPower {second_child, 2}
+        };
+    }
+
+    FunctionAny assembleDerivative(Syntax::AstOpType top_op, const FunctionAny& first_child, const FunctionAny& second_child, const FunctionAny& first_derived, const FunctionAny& second_derived) {
         if (top_op == Syntax::AstOpType::power) {
-            std::cout << "Chain rule on power op...\n"; // debug
-            Composite new_exp {Syntax::AstOpType::sub, second, Composite {Syntax::AstOpType::none, {Polynomial {std::vector<PolynomialTerm> {{1, 0}}}}, {}}};
+
+            /// @note Constant whole exponents derive like `IntPower`, so the result skips both `std::pow` and the exponent sub-tree.
+            if (auto exponent = getConstantLeaf(second_child); exponent && isIntPowerExponent(*exponent)) {
+                return IntPower {first_child, static_cast<std::int32_t>(*exponent)}.deriveWith(first_derived);
+            }
+
+            Composite new_exp {Syntax::AstOpType::sub, second_child, Constant {1.0}};
 
             /// @note composed (f(x))^n functions must follow chain rule: (first)^second becomes second * first ^ (second - 1) * dx(first)!
             return Composite {
                 Syntax::AstOpType::mul,
                 Composite {
                     Syntax::AstOpType::mul,
-                    second,
+                    second_child,
                     Composite {
                         Syntax::AstOpType::power,
-                        first,
+                        first_child,
                         new_exp
                     }
                 },
                 first_derived
             };
         } else if (top_op == Syntax::AstOpType::add || top_op ==  Syntax::AstOpType::sub) {
-            std::cout << "Chain rule on term op...\n"; // debug
             return {
                 Composite {
                     top_op,
@@ -53,22 +159,26 @@ namespace GeneralDeriver::Models {
             };
         }
 
-        std::cout << "Derivation bad!\n"; // debug
+        // Both rules below inspect the child derivatives, so an underivable child leaves the whole product or quotient underivable.
+        if (first_derived.getStoragePtr() == nullptr || second_derived.getStoragePtr() == nullptr) {
+            return {};
+        }
+
+        if (top_op == Syntax::AstOpType::mul) {
+            return wrapLeafDerivative(assembleProductRule(first_child, second_child, first_derived, second_derived));
+        } else if (top_op == Syntax::AstOpType::div) {
+            return wrapLeafDerivative(assembleQuotientRule(first_child, second_child, first_derived, second_derived));
+        }
+
         return {};
     }
 
-    FunctionAny deriveComposite(Syntax::AstOpType top_op, const FunctionAny& inner_child) {
-        auto inner_derived = (inner_child.getStoragePtr()->getType() == FuncType::polynomial)
-            ? inner_child.unpackFunctionAny<Polynomial>().makeDerivative()
-            : inner_child.unpackFunctionAny<Composite>().makeDerivative();
-
-        /// @note A none Composite is practically just the inner function, so I just skip the wrapping and derive the inner item.
+    FunctionAny assembleDerivative(Syntax::AstOpType top_op, const FunctionAny& inner_child, const FunctionAny& inner_derived) {
+        /// @note A none Composite is practically just the inner function, so I just derive the inner item. Leaf derivatives still get one wrapping, since collapsed polynomial leaves must keep giving Composite derivatives.
         if (top_op == Syntax::AstOpType::none) {
-            std::cout << "Deriving identity op...\n"; // debug
 
-            return inner_derived;
+            return wrapLeafDerivative(inner_derived);
         } else if (top_op == Syntax::AstOpType::neg) {
-            std::cout << "Deriving negation op...\n"; // debug
             return Composite {
                 Syntax::AstOpType::mul,
                 Backend::convertFoldResult({-1}),
@@ -76,16 +186,87 @@ namespace GeneralDeriver::Models {
             };
         }
 
+        /// @note Function ops follow the chain rule: f(g(x)) becomes f'(g(x)) * dx(g).
+        switch (top_op) {
+        case Syntax::AstOpType::sin:
+            return Composite {
+                Syntax::AstOpType::mul,
+                Composite {Syntax::AstOpType::cos, inner_child, {}},
+                inner_derived
+            };
+        case Syntax::AstOpType::cos:
+            return Composite {
+                Syntax::AstOpType::mul,
+                Backend::convertFoldResult({-1}),
+                Composite {
+                    Syntax::AstOpType::mul,
+                    Composite {Syntax::AstOpType::sin, inner_child, {}},
+                    inner_derived
+                }
+            };
+        case Syntax::AstOpType::exp:
+            return Composite {
+                Syntax::AstOpType::mul,
+                Composite {Syntax::AstOpType::exp, inner_child, {}},
+                inner_derived
+            };
+        case Syntax::AstOpType::ln:
+            return Composite {
+                Syntax::AstOpType::div,
+                inner_derived,
+                inner_child
+            };
+        case Syntax::AstOpType::sqrt:
+            return Composite {
+                Syntax::AstOpType::div,
+                inner_derived,
+                Composite {
+                    Syntax::AstOpType::mul,
+                    Backend::convertFoldResult({2}),
+                    Composite {Syntax::AstOpType::sqrt, inner_child, {}}
+                }
+            };
+        default:
+            break;
+        }
+
         /// @note Do not handle negation op. type since the function emitter will detect negations of an expr. and simplify that away.
-        std::cout << "Derivation bad!\n"; // debug
         return {};
     }
 
+    FunctionAny deriveComposite(Syntax::AstOpType top_op, const FunctionAny& first_child, const FunctionAny& second_child) {
+        auto first_derived = first_child.getStoragePtr()->makeDerivative();
+        auto second_derived = second_child.getStoragePtr()->makeDerivative();
+
+        return assembleDerivative(top_op, first_child, second_child, first_derived, second_derived);
+    }
+
+    FunctionAny deriveComposite(Syntax::AstOpType top_op, const FunctionAny& inner_child) {
+        /// @note Dispatch by the virtual call, since a power Composite also reports `FuncType::polynomial`.
+        auto inner_derived = inner_child.getStoragePtr()->makeDerivative();
+
+        return assembleDerivative(top_op, inner_child, inner_derived);
+    }
+
     Composite::Composite()
-    : lhs_subject {}, rhs_subject {}, op {Syntax::AstOpType::none} {}
+    : lhs_subject {}, rhs_subject {}, lhs_constant {0.0}, rhs_constant {0.0}, op {Syntax::AstOpType::none}, lhs_is_constant {false}, rhs_is_constant {false} {
+        Utils::noteNodes(1);
+    }
 
     Composite::Composite(Syntax::AstOpType op_, const FunctionAny& lhs, const FunctionAny& rhs)
-    : lhs_subject(lhs), rhs_subject(rhs), op {op_} {}
+    : lhs_subject(lhs), rhs_subject(rhs), lhs_constant {0.0}, rhs_constant {0.0}, op {op_}, lhs_is_constant {false}, rhs_is_constant {false} {
+        Utils::noteNodes(1);
+
+        if (auto value = getConstantLeaf(lhs_subject); value) {
+            lhs_constant = *value;
+            lhs_is_constant = true;
+        }
+
+        if (auto value = getConstantLeaf(rhs_subject); value) {
+            rhs_constant = *value;
+            rhs_is_constant = true;
+        }
+    }
 
     Syntax::AstOpType Composite::getOp() const { return op; }
 
@@ -99,6 +280,14 @@ namespace GeneralDeriver::Models {
         return CompositeArity::invalid;
     }
 
+    const FunctionAny& Composite::getLeft() const { return lhs_subject; }
+
+    const FunctionAny& Composite::getRight() const { return rhs_subject; }
+
+    FunctionCost Composite::estimateCost() const {
+        return Models::estimateCost(*this);
+    }
+
     FuncType Composite::getType() const {
         switch (op) {
         case Syntax::AstOpType::sub:
@@ -112,27 +301,19 @@ namespace GeneralDeriver::Models {
         case Syntax::AstOpType::neg:
         case Syntax::AstOpType::mul:
             return FuncType::product;
+        case Syntax::AstOpType::sin:
+        case Syntax::AstOpType::cos:
+        case Syntax::AstOpType::exp:
+        case Syntax::AstOpType::ln:
+        case Syntax::AstOpType::sqrt:
+            return FuncType::elementary;
         case Syntax::AstOpType::none:
         default:
-            return FuncType::identity;
+            return FuncType::none;
         }
     }
 
-    double Composite::evalAt(double x) const {
-        auto op_arity = getArity();
-        double lhs_val = 0.0;
-        double rhs_val = 0.0;
-
-        if (op_arity == CompositeArity::unary) {
-            lhs_val = lhs_subject.getStoragePtr()->evalAt(x);
-        } else if (op_arity == CompositeArity::binary) {
-            lhs_val = lhs_subject.getStoragePtr()->evalAt(x);
-            rhs_val = rhs_subject.getStoragePtr()->evalAt(x);
-        } else {
-            /// @todo Add exception throwing for invalid op arity, perhaps from some func. emission failure.
-            return 0.0;
-        }
-
+    double Composite::applyOp(double lhs_val, double rhs_val) const {
         switch (op) {
         case Syntax::AstOpType::sub:
             return lhs_val - rhs_val;
@@ -147,12 +328,143 @@ namespace GeneralDeriver::Models {
             return std::pow(lhs_val, rhs_val);
         case Syntax::AstOpType::neg:
             return -1.0 * lhs_val;
+        case Syntax::AstOpType::sin:
+            return std::sin(lhs_val);
+        case Syntax::AstOpType::cos:
+            return std::cos(lhs_val);
+        case Syntax::AstOpType::exp:
+            return std::exp(lhs_val);
+        case Syntax::AstOpType::ln:
+            return std::log(lhs_val);
+        case Syntax::AstOpType::sqrt:
+            return std::sqrt(lhs_val);
         case Syntax::AstOpType::none:
         default:
             return lhs_val;
         }
     }
 
+    double Composite::evalAt(double x) const {
+        auto op_arity = getArity();
+        double lhs_val = 0.0;
+        double rhs_val = 0.0;
+
+        if (op_arity == CompositeArity::unary) {
+            lhs_val = lhs_is_constant ? lhs_constant : lhs_subject.getStoragePtr()->evalAt(x);
+        } else if (op_arity == CompositeArity::binary) {
+            lhs_val = lhs_is_constant ? lhs_constant : lhs_subject.getStoragePtr()->evalAt(x);
+            rhs_val = rhs_is_constant ? rhs_constant : rhs_subject.getStoragePtr()->evalAt(x);
+        } else {
+            /// @todo Add exception throwing for invalid op arity, perhaps from some func. emission failure.
+            return 0.0;
+        }
+
+        return applyOp(lhs_val, rhs_val);
+    }
+
+    double Composite::evalAtPoint(std::span<const double> point) const {
+        auto op_arity = getArity();
+        double lhs_val = 0.0;
+        double rhs_val = 0.0;
+
+        if (op_arity == CompositeArity::unary) {
+            lhs_val = lhs_is_constant ? lhs_constant : lhs_subject.getStoragePtr()->evalAtPoint(point);
+        } else if (op_arity == CompositeArity::binary) {
+            lhs_val = lhs_is_constant ? lhs_constant : lhs_subject.getStoragePtr()->evalAtPoint(point);
+            rhs_val = rhs_is_constant ? rhs_constant : rhs_subject.getStoragePtr()->evalAtPoint(point);
+        } else {
+            return 0.0;
+        }
+
+        return applyOp(lhs_val, rhs_val);
+    }
+
+    /// @note Works in chunks of `batch_chunk_size` x values: the left child fills `out` directly and the right child uses a stack buffer, so no level of the tree allocates.
+    void Composite::evalBatch(std::span<const double> xs, std::span<double> out) const {
+        auto op_arity = getArity();
+        const std::size_t count = xs.size();
+
+        if (op_arity == CompositeArity::invalid) {
+            /// @todo Add exception throwing for invalid op arity, like in evalAt.
+            std::fill(out.begin(), out.begin() + count, 0.0);
+            return;
+        }
+
+        std::array<double, batch_chunk_size> rhs_buffer;
+
+        for (std::size_t chunk_begin = 0; chunk_begin < count; chunk_begin += batch_chunk_size) {
+            const std::size_t chunk_len = std::min(batch_chunk_size, count - chunk_begin);
+            auto xs_chunk = xs.subspan(chunk_begin, chunk_len);
+            auto lhs_vals = out.subspan(chunk_begin, chunk_len);
+            std::span<double> rhs_vals {rhs_buffer.data(), chunk_len};
+
+            if (lhs_is_constant) {
+                std::fill(lhs_vals.begin(), lhs_vals.end(), lhs_constant);
+            } else {
+                lhs_subject.getStoragePtr()->evalBatch(xs_chunk, lhs_vals);
+            }
+
+            if (op_arity == CompositeArity::binary) {
+                if (rhs_is_constant) {
+                    std::fill(rhs_vals.begin(), rhs_vals.end(), rhs_constant);
+                } else {
+                    rhs_subject.getStoragePtr()->evalBatch(xs_chunk, rhs_vals);
+                }
+            }
+
+            switch (op) {
+            case Syntax::AstOpType::sub:
+                for (std::size_t i = 0; i < chunk_len; i++) {
+                    lhs_vals[i] -= rhs_vals[i];
+                }
+                break;
+            case Syntax::AstOpType::add:
+                for (std::size_t i = 0; i < chunk_len; i++) {
+                    lhs_vals[i] += rhs_vals[i];
+                }
+                break;
+            case Syntax::AstOpType::mul:
+                for (std::size_t i = 0; i < chunk_len; i++) {
+                    lhs_vals[i] *= rhs_vals[i];
+                }
+                break;
+            case Syntax::AstOpType::div:
+                for (std::size_t i = 0; i < chunk_len; i++) {
+                    lhs_vals[i] /= rhs_vals[i];
+                }
+                break;
+            case Syntax::AstOpType::power:
+                for (std::size_t i = 0; i < chunk_len; i++) {
+                    lhs_vals[i] = std::pow(lhs_vals[i], rhs_vals[i]);
+                }
+                break;
+            case Syntax::AstOpType::neg:
+                for (std::size_t i = 0; i < chunk_len; i++) {
+                    lhs_vals[i] = -lhs_vals[i];
+                }
+                break;
+            case Syntax::AstOpType::sin:
+                sinBatch(lhs_vals, lhs_vals);
+                break;
+            case Syntax::AstOpType::cos:
+                cosBatch(lhs_vals, lhs_vals);
+                break;
+            case Syntax::AstOpType::exp:
+                expBatch(lhs_vals, lhs_vals);
+                break;
+            case Syntax::AstOpType::ln:
+                lnBatch(lhs_vals, lhs_vals);
+                break;
+            case Syntax::AstOpType::sqrt:
+                sqrtBatch(lhs_vals, lhs_vals);
+                break;
+            case Syntax::AstOpType::none:
+            default:
+                break;
+            }
+        }
+    }
+
     /// @todo Implement derivative member function!
     FunctionAny Composite::makeDerivative() const {
         auto checked_arity = getArity();
@@ -170,7 +482,6 @@ namespace GeneralDeriver::Models {
     }
 
     std::string Composite::toText() const {
-        /// @todo Implement full stringification logic with recursion.
-        return "Composite {...}";
+        return writeText(*this);
     }
 }
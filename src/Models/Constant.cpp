@@ -0,0 +1,41 @@
+/**
+ * @file Constant.cpp
+ * @author DrkWithT
+ * @brief Implements constant leaf function.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include "Models/Constant.hpp"
+#include "Models/TextWriter.hpp"
+
+namespace GeneralDeriver::Models {
+    Constant::Constant()
+    : value {0.0} {}
+
+    Constant::Constant(double value_)
+    : value {value_} {}
+
+    double Constant::getValue() const { return value; }
+
+    FuncType Constant::getType() const { return FuncType::constant; }
+
+    double Constant::evalAt([[maybe_unused]] double x) const { return value; }
+
+    double Constant::evalAtPoint([[maybe_unused]] std::span<const double> point) const { return value; }
+
+    void Constant::evalBatch(std::span<const double> xs, std::span<double> out) const {
+        std::fill(out.begin(), out.begin() + xs.size(), value);
+    }
+
+    FunctionAny Constant::makeDerivative() const {
+        return {Constant {0.0}};
+    }
+
+    std::string Constant::toText() const {
+        return writeText(*this);
+    }
+}
@@ -0,0 +1,337 @@
+/**
+ * @file DerivativeBudget.cpp
+ * @author DrkWithT
+ * @brief Implements derivative cost estimates and the budgeted switch to dual-number derivatives.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <array>
+#include <format>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+#include "Models/DerivativeBudget.hpp"
+#include "Models/Composite.hpp"
+#include "Models/Constant.hpp"
+#include "Models/IntPower.hpp"
+#include "Models/LazyDerivative.hpp"
+#include "Models/Polynomial.hpp"
+#include "Models/RationalFunction.hpp"
+
+namespace GeneralDeriver::Models {
+    /// @note Every node sits behind a `FunctionAny`: its `Storage` plus the control blocks of both `make_shared` calls, rounded up.
+    static constexpr std::size_t holder_bytes = 64;
+    static constexpr std::size_t composite_bytes = sizeof(Composite) + holder_bytes;
+    static constexpr std::size_t term_bytes = sizeof(PolynomialTerm);
+
+    /// @brief Adds without wrapping, since derivative estimates of DAG-shaped inputs can pass any `std::size_t`.
+    [[nodiscard]] static std::size_t addSaturating(std::size_t lhs, std::size_t rhs) {
+        return (lhs > std::numeric_limits<std::size_t>::max() - rhs) ? std::numeric_limits<std::size_t>::max() : lhs + rhs;
+    }
+
+    /// @note Counts the nodes `assembleDerivative` allocates for one op, besides its children's derivatives.
+    [[nodiscard]] static std::size_t getRuleNodeCount(const Composite& fn) {
+        switch (fn.getOp()) {
+        case Syntax::AstOpType::none:
+        case Syntax::AstOpType::add:
+        case Syntax::AstOpType::sub:
+        case Syntax::AstOpType::ln:
+            return 1;
+        case Syntax::AstOpType::neg:
+        case Syntax::AstOpType::sin:
+        case Syntax::AstOpType::exp:
+            return 2;
+        case Syntax::AstOpType::mul:
+            return 3;
+        case Syntax::AstOpType::cos:
+        case Syntax::AstOpType::sqrt:
+            return 4;
+        case Syntax::AstOpType::div:
+        case Syntax::AstOpType::power:
+        default:
+            return 5;
+        }
+    }
+
+    class CostEstimator {
+    private:
+        struct NodeCost {
+            std::size_t derivative_nodes;
+            std::size_t derivative_bytes;
+        };
+
+        std::unordered_map<const IFunction*, NodeCost> memo;
+        FunctionCost total;
+
+        /// @note Leaves & polynomial kinds derive into one node of about their own size.
+        [[nodiscard]] NodeCost visitLeaf(const IFunction& fn) {
+            std::size_t own_bytes = composite_bytes;
+
+            if (fn.getType() == FuncType::rational_function) {
+                const auto& quotient = static_cast<const RationalFunction&>(fn);
+                own_bytes += term_bytes * (quotient.getNumerator().getTermCount() + quotient.getDenominator().getTermCount());
+            } else if (const auto* poly = dynamic_cast<const Polynomial*>(&fn); poly != nullptr) {
+                own_bytes += term_bytes * poly->getTermCount();
+            }
+
+            total.bytes = addSaturating(total.bytes, own_bytes);
+
+            // A quotient's rule builds several intermediate polynomials, each bounded by the squared denominator.
+            const std::size_t derived_count = (fn.getType() == FuncType::rational_function) ? 4 : 1;
+
+            return {derived_count, derived_count * own_bytes};
+        }
+
+        [[nodiscard]] NodeCost visit(const IFunction* fn) {
+            if (fn == nullptr) {
+                return {0, 0};
+            }
+
+            if (auto found = memo.find(fn); found != memo.end()) {
+                return found->second;
+            }
+
+            total.node_count++;
+            NodeCost cost {0, 0};
+
+            if (const auto* composite = dynamic_cast<const Composite*>(fn); composite != nullptr) {
+                total.bytes = addSaturating(total.bytes, composite_bytes);
+
+                const NodeCost lhs = visit(composite->getLeft().getStoragePtr());
+                const NodeCost rhs = visit(composite->getRight().getStoragePtr());
+                const std::size_t rule_nodes = getRuleNodeCount(*composite);
+
+                cost.derivative_nodes = addSaturating(rule_nodes, addSaturating(lhs.derivative_nodes, rhs.derivative_nodes));
+                cost.derivative_bytes = addSaturating(rule_nodes * composite_bytes, addSaturating(lhs.derivative_bytes, rhs.derivative_bytes));
+            } else if (fn->getType() == FuncType::int_power) {
+                total.bytes = addSaturating(total.bytes, composite_bytes);
+
+                const NodeCost base = visit(static_cast<const IntPower*>(fn)->getBase().getStoragePtr());
+                constexpr std::size_t rule_nodes = 4;
+
+                cost.derivative_nodes = addSaturating(rule_nodes, base.derivative_nodes);
+                cost.derivative_bytes = addSaturating(rule_nodes * composite_bytes, base.derivative_bytes);
+            } else if (fn->getType() == FuncType::lazy_derivative) {
+                // Whatever a lazy derivative expands to has to be derived again, so its source's rule applies twice.
+                total.bytes = addSaturating(total.bytes, composite_bytes);
+
+                const NodeCost source = visit(static_cast<const LazyDerivative*>(fn)->getSource().getStoragePtr());
+
+                cost.derivative_nodes = addSaturating(source.derivative_nodes, source.derivative_nodes);
+                cost.derivative_bytes = addSaturating(source.derivative_bytes, source.derivative_bytes);
+            } else {
+                cost = visitLeaf(*fn);
+            }
+
+            memo.emplace(fn, cost);
+
+            return cost;
+        }
+
+    public:
+        CostEstimator()
+        : memo {}, total {0, 0, 0, 0} {}
+
+        [[nodiscard]] FunctionCost estimate(const IFunction& root) {
+            const NodeCost root_cost = visit(&root);
+
+            total.derivative_nodes = root_cost.derivative_nodes;
+            total.derivative_bytes = root_cost.derivative_bytes;
+
+            return total;
+        }
+    };
+
+    FunctionCost estimateCost(const IFunction& fn) {
+        CostEstimator estimator;
+
+        return estimator.estimate(fn);
+    }
+
+    bool fitsBudget(const FunctionCost& cost, const DerivativeBudget& budget) {
+        return cost.derivative_nodes <= budget.max_derivative_nodes && cost.derivative_bytes <= budget.max_derivative_bytes;
+    }
+
+    BudgetedDerivative deriveWithinBudget(const FunctionAny& fn, const DerivativeBudget& budget) {
+        const IFunction* fn_ptr = fn.getStoragePtr();
+
+        if (fn_ptr == nullptr) {
+            return {{}, {0, 0, 0, 0}, DerivativeStrategy::symbolic};
+        }
+
+        const FunctionCost cost = estimateCost(*fn_ptr);
+
+        if (fitsBudget(cost, budget)) {
+            return {fn_ptr->makeDerivative(), cost, DerivativeStrategy::symbolic};
+        }
+
+        return {DualDerivative {fn}, cost, DerivativeStrategy::dual_number};
+    }
+
+    [[nodiscard]] static ValueSlope sweepDualLeaf(const TapeNode& node, const std::vector<PolynomialTerm>& terms, std::span<const double> point) {
+        switch (node.op) {
+        case TapeOp::variable:
+            // x-only evaluation leaves parameters unbound, like `Variable::evalAt`.
+            return {(node.lhs < point.size()) ? point[node.lhs] : std::numeric_limits<double>::quiet_NaN(), (node.lhs == 0) ? 1.0 : 0.0};
+        case TapeOp::polynomial: {
+            ValueSlope result {0.0, 0.0};
+
+            for (std::uint32_t t = node.lhs; t < node.lhs + node.rhs; t++) {
+                const auto [coeff, power] = terms[t];
+
+                if (power == 0.0) {
+                    result.value += coeff;
+                    continue;
+                }
+
+                result.value += coeff * std::pow(point[0], power);
+                result.slope += coeff * power * std::pow(point[0], power - 1.0);
+            }
+
+            return result;
+        }
+        case TapeOp::constant:
+        default:
+            return {node.value, 0.0};
+        }
+    }
+
+    /// @note Mirrors `evalWithSlope`, including its power rule treating the exponent as constant, so both strategies give the same f'.
+    [[nodiscard]] static double sweepDual(const Tape& tape, std::span<const double> point, std::vector<ValueSlope>& duals) {
+        const auto& nodes = tape.getNodes();
+        const auto& terms = tape.getTerms();
+
+        if (nodes.empty()) {
+            return 0.0;
+        }
+
+        if (duals.size() < nodes.size()) {
+            duals.resize(nodes.size());
+        }
+
+        for (std::size_t i = 0; i < nodes.size(); i++) {
+            const TapeNode& node = nodes[i];
+
+            // Leaves keep a slot or a term range in `lhs` & `rhs`, so only ops read operand duals.
+            if (node.op == TapeOp::constant || node.op == TapeOp::variable || node.op == TapeOp::polynomial) {
+                duals[i] = sweepDualLeaf(node, terms, point);
+                continue;
+            }
+
+            const bool binary = node.op == TapeOp::add || node.op == TapeOp::sub || node.op == TapeOp::mul || node.op == TapeOp::div || node.op == TapeOp::power;
+            const ValueSlope lhs = duals[node.lhs];
+            const ValueSlope rhs = binary ? duals[node.rhs] : ValueSlope {0.0, 0.0};
+
+            switch (node.op) {
+            case TapeOp::constant:
+            case TapeOp::variable:
+            case TapeOp::polynomial:
+                break;
+            case TapeOp::add:
+                duals[i] = {lhs.value + rhs.value, lhs.slope + rhs.slope};
+                break;
+            case TapeOp::sub:
+                duals[i] = {lhs.value - rhs.value, lhs.slope - rhs.slope};
+                break;
+            case TapeOp::mul:
+                duals[i] = {lhs.value * rhs.value, lhs.slope * rhs.value + lhs.value * rhs.slope};
+                break;
+            case TapeOp::div:
+                duals[i] = {lhs.value / rhs.value, (lhs.slope * rhs.value - lhs.value * rhs.slope) / (rhs.value * rhs.value)};
+                break;
+            case TapeOp::power:
+                duals[i] = {std::pow(lhs.value, rhs.value), rhs.value * std::pow(lhs.value, rhs.value - 1.0) * lhs.slope};
+                break;
+            case TapeOp::int_power: {
+                const auto exponent = static_cast<std::int32_t>(node.value);
+                const double slope = (exponent != 0) ? exponent * raiseToInteger(lhs.value, exponent - 1) * lhs.slope : 0.0;
+
+                duals[i] = {raiseToInteger(lhs.value, exponent), slope};
+                break;
+            }
+            case TapeOp::neg:
+                duals[i] = {-lhs.value, -lhs.slope};
+                break;
+            case TapeOp::sin:
+                duals[i] = {std::sin(lhs.value), std::cos(lhs.value) * lhs.slope};
+                break;
+            case TapeOp::cos:
+                duals[i] = {std::cos(lhs.value), -std::sin(lhs.value) * lhs.slope};
+                break;
+            case TapeOp::exp: {
+                const double value = std::exp(lhs.value);
+                duals[i] = {value, value * lhs.slope};
+                break;
+            }
+            case TapeOp::ln:
+                duals[i] = {std::log(lhs.value), lhs.slope / lhs.value};
+                break;
+            case TapeOp::sqrt: {
+                const double value = std::sqrt(lhs.value);
+                duals[i] = {value, lhs.slope / (2.0 * value)};
+                break;
+            }
+            }
+        }
+
+        return duals[nodes.size() - 1].slope;
+    }
+
+    /// @note Grows to the largest tape this thread has swept, so steady-state sweeps do not allocate.
+    static std::vector<ValueSlope>& getSweepBuffer() {
+        thread_local std::vector<ValueSlope> duals;
+
+        return duals;
+    }
+
+    [[nodiscard]] static std::shared_ptr<const Tape> compileTape(const FunctionAny& source) {
+        try {
+            return std::make_shared<const Tape>(*source.getStoragePtr());
+        } catch (const std::invalid_argument&) {
+            return nullptr;
+        }
+    }
+
+    DualDerivative::DualDerivative()
+    : source {Constant {0.0}}, tape {compileTape(source)} {}
+
+    DualDerivative::DualDerivative(const FunctionAny& source_)
+    : source {source_}, tape {compileTape(source_)} {}
+
+    const FunctionAny& DualDerivative::getSource() const { return source; }
+
+    FuncType DualDerivative::getType() const { return FuncType::dual_derivative; }
+
+    double DualDerivative::evalAt(double x) const {
+        const std::array<double, 1> point {x};
+
+        return evalAtPoint(point);
+    }
+
+    double DualDerivative::evalAtPoint(std::span<const double> point) const {
+        if (tape == nullptr) {
+            return evalWithSlope(*source.getStoragePtr(), point).slope;
+        }
+
+        return sweepDual(*tape, point, getSweepBuffer());
+    }
+
+    void DualDerivative::evalBatch(std::span<const double> xs, std::span<double> out) const {
+        for (std::size_t i = 0; i < xs.size(); i++) {
+            out[i] = evalAtPoint(xs.subspan(i, 1));
+        }
+    }
+
+    FunctionAny DualDerivative::makeDerivative() const {
+        return {};
+    }
+
+    std::string DualDerivative::toText() const {
+        return std::format("d/dx ({})", source.getStoragePtr()->toText());
+    }
+}
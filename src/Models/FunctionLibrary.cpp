@@ -0,0 +1,415 @@
+/**
+ * @file FunctionLibrary.cpp
+ * @author DrkWithT
+ * @brief Implements the compiled function library image: writer, mmap loader & in-place evaluation.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "Models/FunctionLibrary.hpp"
+#include "Models/IntPower.hpp"
+
+namespace GeneralDeriver::Models {
+    static constexpr char library_magic[8] = {'G', 'D', 'F', 'N', 'L', 'I', 'B', '\0'};
+    static constexpr std::uint32_t byte_order_mark = 0x01020304;
+    static constexpr std::size_t x_slot = 0;
+    static constexpr std::size_t section_align = 8;
+
+    static_assert(sizeof(LibraryHeader) == 80 && sizeof(LibraryEntry) == 32 && sizeof(LibraryNode) == 12 && sizeof(PolynomialTerm) == 16);
+    static_assert(std::is_trivially_copyable_v<LibraryHeader> && std::is_trivially_copyable_v<LibraryNode> && std::is_trivially_copyable_v<PolynomialTerm>);
+
+    static std::uint64_t alignSection(std::uint64_t offset) {
+        return (offset + section_align - 1) / section_align * section_align;
+    }
+
+    static bool isBinaryOp(TapeOp op) {
+        return op == TapeOp::add || op == TapeOp::sub || op == TapeOp::mul || op == TapeOp::div || op == TapeOp::power;
+    }
+
+    /* LibraryFunction impl. */
+
+    LibraryFunction::LibraryFunction()
+    : nodes {}, constants {}, terms {} {}
+
+    LibraryFunction::LibraryFunction(std::span<const LibraryNode> nodes_, std::span<const double> constants_, std::span<const PolynomialTerm> terms_)
+    : nodes {nodes_}, constants {constants_}, terms {terms_} {}
+
+    bool LibraryFunction::isEmpty() const { return nodes.empty(); }
+
+    std::size_t LibraryFunction::getNodeCount() const { return nodes.size(); }
+
+    double LibraryFunction::evalAt(std::span<const double> point, std::span<double> scratch) const {
+        const std::size_t count = nodes.size();
+
+        for (std::size_t i = 0; i < count; i++) {
+            const LibraryNode& node = nodes[i];
+
+            switch (node.op) {
+            case TapeOp::constant:
+                scratch[i] = constants[node.lhs];
+                break;
+            case TapeOp::variable:
+                scratch[i] = point[node.lhs];
+                break;
+            case TapeOp::polynomial: {
+                double result = 0.0;
+
+                for (std::uint32_t t = node.lhs; t < node.lhs + node.rhs; t++) {
+                    result += (terms[t].power != 0.0) ? std::pow(point[x_slot], terms[t].power) * terms[t].coeff : terms[t].coeff;
+                }
+
+                scratch[i] = result;
+                break;
+            }
+            case TapeOp::add:
+                scratch[i] = scratch[node.lhs] + scratch[node.rhs];
+                break;
+            case TapeOp::sub:
+                scratch[i] = scratch[node.lhs] - scratch[node.rhs];
+                break;
+            case TapeOp::mul:
+                scratch[i] = scratch[node.lhs] * scratch[node.rhs];
+                break;
+            case TapeOp::div:
+                scratch[i] = scratch[node.lhs] / scratch[node.rhs];
+                break;
+            case TapeOp::power:
+                scratch[i] = std::pow(scratch[node.lhs], scratch[node.rhs]);
+                break;
+            case TapeOp::int_power:
+                scratch[i] = raiseToInteger(scratch[node.lhs], std::bit_cast<std::int32_t>(node.rhs));
+                break;
+            case TapeOp::neg:
+                scratch[i] = -scratch[node.lhs];
+                break;
+            case TapeOp::sin:
+                scratch[i] = std::sin(scratch[node.lhs]);
+                break;
+            case TapeOp::cos:
+                scratch[i] = std::cos(scratch[node.lhs]);
+                break;
+            case TapeOp::exp:
+                scratch[i] = std::exp(scratch[node.lhs]);
+                break;
+            case TapeOp::ln:
+                scratch[i] = std::log(scratch[node.lhs]);
+                break;
+            case TapeOp::sqrt:
+                scratch[i] = std::sqrt(scratch[node.lhs]);
+                break;
+            }
+        }
+
+        return (count > 0) ? scratch[count - 1] : 0.0;
+    }
+
+    /* LibraryWriter impl. */
+
+    /// @brief Image sections being filled, with each distinct constant pooled once.
+    struct ImageSections {
+        std::vector<double> constants;
+        std::vector<PolynomialTerm> terms;
+        std::vector<LibraryNode> nodes;
+        std::unordered_map<std::uint64_t, std::uint32_t> constant_ids; // keyed by bits, so -0.0 and NaN payloads survive
+
+        std::uint32_t poolConstant(double value) {
+            const auto bits = std::bit_cast<std::uint64_t>(value);
+
+            if (auto found = constant_ids.find(bits); found != constant_ids.end()) {
+                return found->second;
+            }
+
+            const auto id = static_cast<std::uint32_t>(constants.size());
+            constants.push_back(value);
+            constant_ids[bits] = id;
+
+            return id;
+        }
+
+        /// @note Returns the first node of the appended run. Tape operands are already local indices, so only pooled fields change.
+        std::uint32_t appendTape(const Tape& tape) {
+            const auto first = static_cast<std::uint32_t>(nodes.size());
+            const auto term_base = static_cast<std::uint32_t>(terms.size());
+
+            terms.insert(terms.end(), tape.getTerms().begin(), tape.getTerms().end());
+
+            for (const auto& tape_node : tape.getNodes()) {
+                LibraryNode node {tape_node.lhs, tape_node.rhs, tape_node.op, {0, 0, 0}};
+
+                if (tape_node.op == TapeOp::constant) {
+                    node.lhs = poolConstant(tape_node.value);
+                } else if (tape_node.op == TapeOp::polynomial) {
+                    node.lhs += term_base;
+                } else if (tape_node.op == TapeOp::int_power) {
+                    node.rhs = std::bit_cast<std::uint32_t>(static_cast<std::int32_t>(tape_node.value));
+                }
+
+                nodes.push_back(node);
+            }
+
+            return first;
+        }
+    };
+
+    template <typename Tp>
+    static void writeSection(std::ofstream& fout, const std::vector<Tp>& items, std::uint64_t offset) {
+        const auto written = static_cast<std::uint64_t>(fout.tellp());
+        const std::vector<char> padding(offset - written, '\0');
+
+        fout.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+        fout.write(reinterpret_cast<const char*>(items.data()), static_cast<std::streamsize>(items.size() * sizeof(Tp)));
+    }
+
+    LibraryWriter::LibraryWriter()
+    : entries {} {}
+
+    void LibraryWriter::addFunction(std::string_view name, const IFunction& fn, const FunctionAny& derivative) {
+        PendingEntry entry {std::string {name}, Tape {fn}, Tape {}, false};
+
+        if (const auto* derived_ptr = derivative.getStoragePtr(); derived_ptr != nullptr) {
+            entry.derivative = Tape {*derived_ptr};
+            entry.has_derivative = true;
+        }
+
+        auto same_name = std::find_if(entries.begin(), entries.end(), [&name](const PendingEntry& other) { return other.name == name; });
+
+        if (same_name != entries.end()) {
+            *same_name = std::move(entry);
+        } else {
+            entries.push_back(std::move(entry));
+        }
+    }
+
+    std::size_t LibraryWriter::getEntryCount() const { return entries.size(); }
+
+    bool LibraryWriter::writeFile(const std::string& path) const {
+        std::vector<std::size_t> order(entries.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [this](std::size_t lhs, std::size_t rhs) { return entries[lhs].name < entries[rhs].name; });
+
+        ImageSections sections;
+        std::vector<LibraryEntry> table;
+        std::string names;
+
+        for (auto id : order) {
+            const auto& pending = entries[id];
+            LibraryEntry entry {};
+
+            entry.name_offset = static_cast<std::uint32_t>(names.size());
+            entry.name_length = static_cast<std::uint32_t>(pending.name.size());
+            names += pending.name;
+
+            entry.slot_count = static_cast<std::uint32_t>(std::max(pending.function.getSlotCount(), pending.derivative.getSlotCount()));
+            entry.function_first = sections.appendTape(pending.function);
+            entry.function_count = static_cast<std::uint32_t>(pending.function.getNodes().size());
+
+            if (pending.has_derivative) {
+                entry.derivative_first = sections.appendTape(pending.derivative);
+                entry.derivative_count = static_cast<std::uint32_t>(pending.derivative.getNodes().size());
+            }
+
+            table.push_back(entry);
+        }
+
+        LibraryHeader header {};
+        std::memcpy(header.magic, library_magic, sizeof(library_magic));
+        header.version = library_version;
+        header.byte_order = byte_order_mark;
+        header.entry_count = static_cast<std::uint32_t>(table.size());
+        header.constant_count = static_cast<std::uint32_t>(sections.constants.size());
+        header.term_count = static_cast<std::uint32_t>(sections.terms.size());
+        header.node_count = static_cast<std::uint32_t>(sections.nodes.size());
+        header.name_bytes = static_cast<std::uint32_t>(names.size());
+        header.entries_offset = alignSection(sizeof(LibraryHeader));
+        header.constants_offset = alignSection(header.entries_offset + table.size() * sizeof(LibraryEntry));
+        header.terms_offset = alignSection(header.constants_offset + sections.constants.size() * sizeof(double));
+        header.nodes_offset = alignSection(header.terms_offset + sections.terms.size() * sizeof(PolynomialTerm));
+        header.names_offset = alignSection(header.nodes_offset + sections.nodes.size() * sizeof(LibraryNode));
+
+        std::ofstream fout {path, std::ios::binary | std::ios::trunc};
+
+        if (!fout) {
+            return false;
+        }
+
+        fout.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        writeSection(fout, table, header.entries_offset);
+        writeSection(fout, sections.constants, header.constants_offset);
+        writeSection(fout, sections.terms, header.terms_offset);
+        writeSection(fout, sections.nodes, header.nodes_offset);
+        writeSection(fout, std::vector<char> {names.begin(), names.end()}, header.names_offset);
+
+        return static_cast<bool>(fout);
+    }
+
+    /* MappedLibrary impl. */
+
+    /// @note Section counts come from the file, so the bounds math stays in 64 bits where 32-bit counts cannot overflow it.
+    static bool isSectionInside(std::uint64_t offset, std::uint64_t count, std::uint64_t item_size, std::size_t file_size) {
+        return offset % section_align == 0 && offset <= file_size && count * item_size <= file_size - offset;
+    }
+
+    static bool isHeaderSound(const LibraryHeader& header, std::size_t file_size) {
+        return std::memcmp(header.magic, library_magic, sizeof(library_magic)) == 0
+            && header.version == library_version
+            && header.byte_order == byte_order_mark
+            && isSectionInside(header.entries_offset, header.entry_count, sizeof(LibraryEntry), file_size)
+            && isSectionInside(header.constants_offset, header.constant_count, sizeof(double), file_size)
+            && isSectionInside(header.terms_offset, header.term_count, sizeof(PolynomialTerm), file_size)
+            && isSectionInside(header.nodes_offset, header.node_count, sizeof(LibraryNode), file_size)
+            && isSectionInside(header.names_offset, header.name_bytes, 1, file_size);
+    }
+
+    MappedLibrary::MappedLibrary(const std::byte* base_, std::size_t size_)
+    : base {base_}, size {size_} {}
+
+    std::optional<MappedLibrary> MappedLibrary::open(const std::string& path) {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+        if (fd < 0) {
+            return {};
+        }
+
+        struct stat file_info {};
+
+        if (fstat(fd, &file_info) != 0 || static_cast<std::size_t>(file_info.st_size) < sizeof(LibraryHeader)) {
+            close(fd);
+            return {};
+        }
+
+        const auto file_size = static_cast<std::size_t>(file_info.st_size);
+        void* mapping = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        // The mapping keeps its own reference to the file.
+        close(fd);
+
+        if (mapping == MAP_FAILED) {
+            return {};
+        }
+
+        MappedLibrary library {static_cast<const std::byte*>(mapping), file_size};
+
+        if (!isHeaderSound(library.getHeader(), file_size)) {
+            return {};
+        }
+
+        return library;
+    }
+
+    MappedLibrary::~MappedLibrary() {
+        if (base != nullptr) {
+            munmap(const_cast<std::byte*>(base), size);
+        }
+    }
+
+    MappedLibrary::MappedLibrary(MappedLibrary&& x_other) noexcept
+    : base {std::exchange(x_other.base, nullptr)}, size {std::exchange(x_other.size, 0)} {}
+
+    MappedLibrary& MappedLibrary::operator=(MappedLibrary&& x_other) noexcept {
+        if (this != &x_other) {
+            if (base != nullptr) {
+                munmap(const_cast<std::byte*>(base), size);
+            }
+
+            base = std::exchange(x_other.base, nullptr);
+            size = std::exchange(x_other.size, 0);
+        }
+
+        return *this;
+    }
+
+    const LibraryHeader& MappedLibrary::getHeader() const {
+        return *reinterpret_cast<const LibraryHeader*>(base);
+    }
+
+    std::span<const LibraryEntry> MappedLibrary::getEntries() const {
+        const auto& header = getHeader();
+
+        return {reinterpret_cast<const LibraryEntry*>(base + header.entries_offset), header.entry_count};
+    }
+
+    /// @note A name running past the name section reads as empty, so a damaged entry just never matches.
+    std::string_view MappedLibrary::getEntryName(const LibraryEntry& entry) const {
+        const auto& header = getHeader();
+
+        if (static_cast<std::uint64_t>(entry.name_offset) + entry.name_length > header.name_bytes) {
+            return {};
+        }
+
+        return {reinterpret_cast<const char*>(base + header.names_offset + entry.name_offset), entry.name_length};
+    }
+
+    std::optional<LibraryFunction> MappedLibrary::viewFunction(std::uint32_t first, std::uint32_t count, std::uint32_t slot_count) const {
+        const auto& header = getHeader();
+
+        if (static_cast<std::uint64_t>(first) + count > header.node_count) {
+            return {};
+        }
+
+        const std::span<const LibraryNode> nodes {reinterpret_cast<const LibraryNode*>(base + header.nodes_offset) + first, count};
+
+        for (std::uint32_t i = 0; i < count; i++) {
+            const auto& node = nodes[i];
+            bool linked = false;
+
+            if (node.op == TapeOp::constant) {
+                linked = node.lhs < header.constant_count;
+            } else if (node.op == TapeOp::variable) {
+                linked = node.lhs < slot_count;
+            } else if (node.op == TapeOp::polynomial) {
+                linked = static_cast<std::uint64_t>(node.lhs) + node.rhs <= header.term_count;
+            } else if (isBinaryOp(node.op)) {
+                linked = node.lhs < i && node.rhs < i;
+            } else if (node.op <= TapeOp::sqrt) {
+                linked = node.lhs < i;
+            }
+
+            if (!linked) {
+                return {};
+            }
+        }
+
+        return LibraryFunction {
+            nodes,
+            {reinterpret_cast<const double*>(base + header.constants_offset), header.constant_count},
+            {reinterpret_cast<const PolynomialTerm*>(base + header.terms_offset), header.term_count}
+        };
+    }
+
+    std::size_t MappedLibrary::getEntryCount() const { return getHeader().entry_count; }
+
+    std::optional<LibraryItem> MappedLibrary::find(std::string_view name) const {
+        const auto entries = getEntries();
+        auto found = std::lower_bound(entries.begin(), entries.end(), name, [this](const LibraryEntry& entry, std::string_view key) {
+            return getEntryName(entry) < key;
+        });
+
+        if (found == entries.end() || getEntryName(*found) != name || found->function_count == 0) {
+            return {};
+        }
+
+        auto function = viewFunction(found->function_first, found->function_count, found->slot_count);
+        auto derivative = viewFunction(found->derivative_first, found->derivative_count, found->slot_count);
+
+        if (!function || !derivative) {
+            return {};
+        }
+
+        return LibraryItem {*function, *derivative, found->slot_count};
+    }
+}
@@ -0,0 +1,33 @@
+/**
+ * @file Identity.cpp
+ * @author DrkWithT
+ * @brief Implements identity leaf function f(x) = x.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include "Models/Identity.hpp"
+#include "Models/Constant.hpp"
+
+namespace GeneralDeriver::Models {
+    Identity::Identity() {}
+
+    FuncType Identity::getType() const { return FuncType::identity; }
+
+    double Identity::evalAt(double x) const { return x; }
+
+    double Identity::evalAtPoint(std::span<const double> point) const { return point[0]; }
+
+    void Identity::evalBatch(std::span<const double> xs, std::span<double> out) const {
+        std::copy(xs.begin(), xs.end(), out.begin());
+    }
+
+    FunctionAny Identity::makeDerivative() const {
+        return {Constant {1.0}};
+    }
+
+    std::string Identity::toText() const { return "x"; }
+}
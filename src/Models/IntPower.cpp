@@ -0,0 +1,111 @@
+/**
+ * @file IntPower.cpp
+ * @author DrkWithT
+ * @brief Implements whole-number power function u(x)^n.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include "Models/IntPower.hpp"
+#include "Models/Composite.hpp"
+#include "Models/Constant.hpp"
+#include "Models/TextWriter.hpp"
+
+namespace GeneralDeriver::Models {
+    bool isIntPowerExponent(double exponent) {
+        return exponent == std::floor(exponent)
+            && exponent > std::numeric_limits<std::int32_t>::min()
+            && exponent <= std::numeric_limits<std::int32_t>::max();
+    }
+
+    template <typename Scalar>
+    static Scalar raiseScalar(Scalar base, std::int32_t exponent) {
+        Scalar result = 1;
+
+        // Widen before negating, since -INT32_MIN does not fit.
+        for (auto bits = static_cast<std::uint32_t>(std::llabs(exponent)); bits != 0; bits >>= 1) {
+            if (bits & 1) {
+                result *= base;
+            }
+
+            base *= base;
+        }
+
+        return (exponent < 0) ? 1 / result : result;
+    }
+
+    double raiseToInteger(double base, std::int32_t exponent) {
+        return raiseScalar(base, exponent);
+    }
+
+    float raiseToInteger(float base, std::int32_t exponent) {
+        return raiseScalar(base, exponent);
+    }
+
+    IntPower::IntPower()
+    : base {Constant {0.0}}, exponent {1} {}
+
+    IntPower::IntPower(const FunctionAny& base_, std::int32_t exponent_)
+    : base {base_}, exponent {exponent_} {}
+
+    const FunctionAny& IntPower::getBase() const { return base; }
+
+    std::int32_t IntPower::getExponent() const { return exponent; }
+
+    FuncType IntPower::getType() const { return FuncType::int_power; }
+
+    double IntPower::evalAt(double x) const {
+        return raiseToInteger(base.getStoragePtr()->evalAt(x), exponent);
+    }
+
+    double IntPower::evalAtPoint(std::span<const double> point) const {
+        return raiseToInteger(base.getStoragePtr()->evalAtPoint(point), exponent);
+    }
+
+    void IntPower::evalBatch(std::span<const double> xs, std::span<double> out) const {
+        const std::size_t count = xs.size();
+
+        base.getStoragePtr()->evalBatch(xs, out);
+
+        for (std::size_t i = 0; i < count; i++) {
+            out[i] = raiseToInteger(out[i], exponent);
+        }
+    }
+
+    /// @note Skips the factors that are 1, so e.g x^2 derives to `2 * x` and not `2 * x^1 * 1`.
+    FunctionAny IntPower::deriveWith(const FunctionAny& base_derived) const {
+        if (exponent == 0) {
+            return {Constant {0.0}};
+        }
+
+        if (exponent == 1) {
+            return base_derived;
+        }
+
+        FunctionAny reduced = (exponent == 2) ? base : FunctionAny {IntPower {base, exponent - 1}};
+        Composite scaled {Syntax::AstOpType::mul, Constant {static_cast<double>(exponent)}, reduced};
+
+        if (auto slope = getConstantLeaf(base_derived); slope && *slope == 1.0) {
+            return scaled;
+        }
+
+        return {Composite {Syntax::AstOpType::mul, scaled, base_derived}};
+    }
+
+    FunctionAny IntPower::makeDerivative() const {
+        if (exponent == 0) {
+            return {Constant {0.0}};
+        }
+
+        return deriveWith(base.getStoragePtr()->makeDerivative());
+    }
+
+    std::string IntPower::toText() const {
+        return writeText(*this);
+    }
+}
@@ -0,0 +1,235 @@
+/**
+ * @file LazyDerivative.cpp
+ * @author DrkWithT
+ * @brief Implements derivatives that materialize one node at a time.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include "Models/LazyDerivative.hpp"
+#include "Models/Composite.hpp"
+#include "Models/Constant.hpp"
+#include "Models/IntPower.hpp"
+#include "Models/Polynomial.hpp"
+#include "Models/RationalFunction.hpp"
+#include "Models/Variable.hpp"
+
+namespace GeneralDeriver::Models {
+    /// @note Composites of an actual op and integer powers are the nodes whose derivatives grow, so only those get deferred. `none` wrappers defer whatever they wrap.
+    static bool isDeferred(const IFunction& fn) {
+        const IFunction* current = &fn;
+
+        while (current->getType() == FuncType::none) {
+            const auto* wrapper = static_cast<const Composite*>(current);
+
+            if (wrapper->getArity() != CompositeArity::unary) {
+                return false;
+            }
+
+            current = wrapper->getLeft().getStoragePtr();
+        }
+
+        if (current->getType() == FuncType::int_power) {
+            return true;
+        }
+
+        return dynamic_cast<const Composite*>(current) != nullptr;
+    }
+
+    /// @note Follows the same rules as `assembleDerivative`, including its power rule treating the exponent as constant, so the result matches the materialized derivative.
+    static ValueSlope evalCompositeWithSlope(const Composite& fn, std::span<const double> point) {
+        const auto arity = fn.getArity();
+
+        if (arity == CompositeArity::invalid) {
+            return {0.0, 0.0};
+        }
+
+        const ValueSlope lhs = evalWithSlope(*fn.getLeft().getStoragePtr(), point);
+        const ValueSlope rhs = (arity == CompositeArity::binary) ? evalWithSlope(*fn.getRight().getStoragePtr(), point) : ValueSlope {0.0, 0.0};
+
+        switch (fn.getOp()) {
+        case Syntax::AstOpType::add:
+            return {lhs.value + rhs.value, lhs.slope + rhs.slope};
+        case Syntax::AstOpType::sub:
+            return {lhs.value - rhs.value, lhs.slope - rhs.slope};
+        case Syntax::AstOpType::mul:
+            return {lhs.value * rhs.value, lhs.slope * rhs.value + lhs.value * rhs.slope};
+        case Syntax::AstOpType::div:
+            return {lhs.value / rhs.value, (lhs.slope * rhs.value - lhs.value * rhs.slope) / (rhs.value * rhs.value)};
+        case Syntax::AstOpType::power:
+            return {std::pow(lhs.value, rhs.value), rhs.value * std::pow(lhs.value, rhs.value - 1.0) * lhs.slope};
+        case Syntax::AstOpType::neg:
+            return {-lhs.value, -lhs.slope};
+        case Syntax::AstOpType::sin:
+            return {std::sin(lhs.value), std::cos(lhs.value) * lhs.slope};
+        case Syntax::AstOpType::cos:
+            return {std::cos(lhs.value), -std::sin(lhs.value) * lhs.slope};
+        case Syntax::AstOpType::exp: {
+            const double value = std::exp(lhs.value);
+            return {value, value * lhs.slope};
+        }
+        case Syntax::AstOpType::ln:
+            return {std::log(lhs.value), lhs.slope / lhs.value};
+        case Syntax::AstOpType::sqrt: {
+            const double value = std::sqrt(lhs.value);
+            return {value, lhs.slope / (2.0 * value)};
+        }
+        case Syntax::AstOpType::none:
+        default:
+            return lhs;
+        }
+    }
+
+    ValueSlope evalWithSlope(const IFunction& fn, std::span<const double> point) {
+        // A power Composite also reports polynomial, so Composites need the checked cast first.
+        if (const auto* composite = dynamic_cast<const Composite*>(&fn); composite != nullptr) {
+            return evalCompositeWithSlope(*composite, point);
+        }
+
+        switch (fn.getType()) {
+        case FuncType::constant:
+            return {static_cast<const Constant&>(fn).getValue(), 0.0};
+        case FuncType::identity:
+            return {point[0], 1.0};
+        case FuncType::variable: {
+            const std::size_t slot = static_cast<const Variable&>(fn).getSlot();
+            return {(slot < point.size()) ? point[slot] : std::numeric_limits<double>::quiet_NaN(), (slot == 0) ? 1.0 : 0.0};
+        }
+        case FuncType::polynomial: {
+            const auto& poly = static_cast<const Polynomial&>(fn);
+            return {poly.evalAt(point[0]), poly.evalSlopeAt(point[0])};
+        }
+        case FuncType::rational_function: {
+            const auto& quotient = static_cast<const RationalFunction&>(fn);
+            const double top = quotient.getNumerator().evalAt(point[0]);
+            const double bottom = quotient.getDenominator().evalAt(point[0]);
+            const double top_slope = quotient.getNumerator().evalSlopeAt(point[0]);
+            const double bottom_slope = quotient.getDenominator().evalSlopeAt(point[0]);
+
+            return {top / bottom, (top_slope * bottom - top * bottom_slope) / (bottom * bottom)};
+        }
+        case FuncType::int_power: {
+            const auto& power = static_cast<const IntPower&>(fn);
+            const ValueSlope base = evalWithSlope(*power.getBase().getStoragePtr(), point);
+            const std::int32_t exponent = power.getExponent();
+            const double slope = (exponent != 0) ? exponent * raiseToInteger(base.value, exponent - 1) * base.slope : 0.0;
+
+            return {raiseToInteger(base.value, exponent), slope};
+        }
+        default:
+            break;
+        }
+
+        // Other kinds e.g nested lazy derivatives just get derived.
+        const auto derived = fn.makeDerivative();
+        const IFunction* derived_ptr = derived.getStoragePtr();
+
+        return {fn.evalAtPoint(point), (derived_ptr != nullptr) ? derived_ptr->evalAtPoint(point) : 0.0};
+    }
+
+    /// @brief Applies the source's own derivative rule once, with its children's derivatives deferred.
+    static FunctionAny expandDerivative(const FunctionAny& source) {
+        const IFunction* source_ptr = source.getStoragePtr();
+
+        if (const auto* composite = dynamic_cast<const Composite*>(source_ptr); composite != nullptr) {
+            switch (composite->getArity()) {
+            case CompositeArity::binary:
+                return assembleDerivative(composite->getOp(), composite->getLeft(), composite->getRight(), makeLazyDerivative(composite->getLeft()), makeLazyDerivative(composite->getRight()));
+            case CompositeArity::unary:
+                return assembleDerivative(composite->getOp(), composite->getLeft(), makeLazyDerivative(composite->getLeft()));
+            default:
+                return {};
+            }
+        }
+
+        switch (source_ptr->getType()) {
+        case FuncType::int_power: {
+            const auto* power = static_cast<const IntPower*>(source_ptr);
+            return power->deriveWith(makeLazyDerivative(power->getBase()));
+        }
+        case FuncType::lazy_derivative:
+            return makeLazyDerivative(static_cast<const LazyDerivative*>(source_ptr)->getDerived());
+        default:
+            return source_ptr->makeDerivative();
+        }
+    }
+
+    FunctionAny makeLazyDerivative(const FunctionAny& fn) {
+        const IFunction* fn_ptr = fn.getStoragePtr();
+
+        if (fn_ptr == nullptr) {
+            return {};
+        } else if (getConstantLeaf(fn)) {
+            return Constant {0.0};
+        } else if (fn_ptr->getType() == FuncType::lazy_derivative || isDeferred(*fn_ptr)) {
+            return LazyDerivative {fn};
+        }
+
+        return fn_ptr->makeDerivative();
+    }
+
+    LazyDerivative::LazyDerivative()
+    : source {Constant {0.0}}, cache {std::make_shared<Cache>()} {}
+
+    LazyDerivative::LazyDerivative(const FunctionAny& source_)
+    : source {source_}, cache {std::make_shared<Cache>()} {}
+
+    const FunctionAny& LazyDerivative::getSource() const { return source; }
+
+    const FunctionAny& LazyDerivative::getDerived() const {
+        std::call_once(cache->filled, [this]() {
+            cache->derived = expandDerivative(source);
+            cache->ready.store(true, std::memory_order_release);
+        });
+
+        return cache->derived;
+    }
+
+    bool LazyDerivative::isMaterialized() const {
+        return cache->ready.load(std::memory_order_acquire);
+    }
+
+    FuncType LazyDerivative::getType() const { return FuncType::lazy_derivative; }
+
+    double LazyDerivative::evalAt(double x) const {
+        const std::array<double, 1> point {x};
+
+        return evalAtPoint(point);
+    }
+
+    double LazyDerivative::evalAtPoint(std::span<const double> point) const {
+        if (!isMaterialized()) {
+            return evalWithSlope(*source.getStoragePtr(), point).slope;
+        }
+
+        const IFunction* derived_ptr = getDerived().getStoragePtr();
+
+        return (derived_ptr != nullptr) ? derived_ptr->evalAtPoint(point) : 0.0;
+    }
+
+    /// @note Batches amortize building the derivative, so they materialize it instead of walking the source per x.
+    void LazyDerivative::evalBatch(std::span<const double> xs, std::span<double> out) const {
+        if (const IFunction* derived_ptr = getDerived().getStoragePtr(); derived_ptr != nullptr) {
+            derived_ptr->evalBatch(xs, out);
+            return;
+        }
+
+        std::fill(out.begin(), out.begin() + xs.size(), 0.0);
+    }
+
+    FunctionAny LazyDerivative::makeDerivative() const {
+        return makeLazyDerivative(getDerived());
+    }
+
+    std::string LazyDerivative::toText() const {
+        const IFunction* derived_ptr = getDerived().getStoragePtr();
+
+        return (derived_ptr != nullptr) ? derived_ptr->toText() : "";
+    }
+}
@@ -0,0 +1,275 @@
+/**
+ * @file MathKernels.cpp
+ * @author DrkWithT
+ * @brief Implements SIMD batch kernels for elementary functions.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include "Models/MathKernels.hpp"
+
+namespace GeneralDeriver::Models {
+    static constexpr std::size_t lane_count = 4;
+
+    using LaneVec = double __attribute__((vector_size(lane_count * sizeof(double))));
+    using LaneBits = std::int64_t __attribute__((vector_size(lane_count * sizeof(std::int64_t))));
+    using NarrowLaneVec = float __attribute__((vector_size(lane_count * sizeof(float))));
+
+    /* Reduction constants (fdlibm splits) */
+
+    static constexpr double round_shifter = 0x1.8p52; // adding then subtracting this rounds |v| < 2^51 to an integer
+    static constexpr double log2_e = 1.44269504088896338700e+00;
+    static constexpr double ln2_hi = 6.93147180369123816490e-01;
+    static constexpr double ln2_lo = 1.90821492927058770002e-10;
+    static constexpr double exp_overflow = 7.09782712893383973096e+02;
+    static constexpr double exp_underflow = -7.45133219101941108420e+02;
+    static constexpr double two_over_pi = 6.36619772367581382433e-01;
+    static constexpr double pio2_1 = 1.57079632673412561417e+00;
+    static constexpr double pio2_2 = 6.07710050630396597660e-11;
+    static constexpr double pio2_3 = 2.02226624871116645580e-21;
+    static constexpr double pio2_3t = 8.47842766036889956997e-32;
+    static constexpr double sincos_reduction_limit = 1e6;
+    static constexpr double sqrt_two = 1.41421356237309514547e+00;
+
+    /* Polynomial coefficients, highest degree first for Horner's rule */
+
+    /// @note Taylor series of exp(r) through r^13 for |r| <= ln(2) / 2.
+    static constexpr std::array<double, 14> exp_coeffs = {
+        1.6059043836821613e-10, 2.08767569878681e-09, 2.505210838544172e-08, 2.755731922398589e-07,
+        2.7557319223985893e-06, 2.48015873015873e-05, 0.0001984126984126984, 0.001388888888888889,
+        0.008333333333333333, 0.041666666666666664, 0.16666666666666666, 0.5, 1.0, 1.0
+    };
+
+    /// @note sin(r) = r + r * z * P(z) where z = r^2, Taylor series through r^17 for |r| <= pi / 4.
+    static constexpr std::array<double, 8> sin_coeffs = {
+        2.8114572543455206e-15, -7.647163731819816e-13, 1.6059043836821613e-10, -2.505210838544172e-08,
+        2.7557319223985893e-06, -0.0001984126984126984, 0.008333333333333333, -0.16666666666666666
+    };
+
+    /// @note cos(r) = 1 - z / 2 + z^2 * Q(z) where z = r^2, Taylor series through r^18 for |r| <= pi / 4.
+    static constexpr std::array<double, 8> cos_coeffs = {
+        -1.5619206968586225e-16, 4.779477332387385e-14, -1.1470745597729725e-11, 2.08767569878681e-09,
+        -2.755731922398589e-07, 2.48015873015873e-05, -0.001388888888888889, 0.041666666666666664
+    };
+
+    /// @note log(1 + f) = f - (f^2 / 2 - s * (f^2 / 2 + z * L(z))) where s = f / (2 + f) and z = s^2, from the atanh series through s^23.
+    static constexpr std::array<double, 11> ln_coeffs = {
+        0.08695652173913043, 0.09523809523809523, 0.10526315789473684, 0.11764705882352941,
+        0.13333333333333333, 0.15384615384615385, 0.18181818181818182, 0.2222222222222222,
+        0.2857142857142857, 0.4, 0.6666666666666666
+    };
+
+    /* Lane helpers */
+
+    static LaneVec splatLanes(double value) {
+        return LaneVec {value, value, value, value};
+    }
+
+    static LaneBits asBits(LaneVec lanes) {
+        return std::bit_cast<LaneBits>(lanes);
+    }
+
+    static LaneVec asLanes(LaneBits bits) {
+        return std::bit_cast<LaneVec>(bits);
+    }
+
+    /// @note Lane comparisons give all-ones or all-zeros masks, so blending is plain bit logic.
+    static LaneVec selectLanes(LaneBits mask, LaneVec if_set, LaneVec if_clear) {
+        return asLanes((mask & asBits(if_set)) | (~mask & asBits(if_clear)));
+    }
+
+    template <std::size_t N>
+    static LaneVec evalHorner(LaneVec x, const std::array<double, N>& coeffs) {
+        LaneVec result = splatLanes(coeffs[0]);
+
+        for (std::size_t i = 1; i < N; i++) {
+            result = result * x + coeffs[i];
+        }
+
+        return result;
+    }
+
+    /// @note Runs a lane kernel over full lane groups, then over one padded group for the leftover x values. Padding lanes hold 1.0, which is in every kernel's domain.
+    template <typename LaneKernel>
+    static void runLanes(std::span<const double> xs, std::span<double> out, LaneKernel kernel) {
+        const std::size_t count = xs.size();
+        std::size_t pos = 0;
+
+        for (; pos + lane_count <= count; pos += lane_count) {
+            LaneVec lanes;
+            std::memcpy(&lanes, xs.data() + pos, sizeof(LaneVec));
+            lanes = kernel(lanes);
+            std::memcpy(out.data() + pos, &lanes, sizeof(LaneVec));
+        }
+
+        if (pos < count) {
+            LaneVec lanes = splatLanes(1.0);
+            std::memcpy(&lanes, xs.data() + pos, (count - pos) * sizeof(double));
+            lanes = kernel(lanes);
+            std::memcpy(out.data() + pos, &lanes, (count - pos) * sizeof(double));
+        }
+    }
+
+    /// @note Float batches widen each lane group into the double kernels and round the results once, so they land within about half a float ULP without a second set of polynomials.
+    template <typename LaneKernel>
+    static void runNarrowLanes(std::span<const float> xs, std::span<float> out, LaneKernel kernel) {
+        const std::size_t count = xs.size();
+        std::size_t pos = 0;
+
+        for (; pos + lane_count <= count; pos += lane_count) {
+            NarrowLaneVec lanes;
+            std::memcpy(&lanes, xs.data() + pos, sizeof(NarrowLaneVec));
+            lanes = __builtin_convertvector(kernel(__builtin_convertvector(lanes, LaneVec)), NarrowLaneVec);
+            std::memcpy(out.data() + pos, &lanes, sizeof(NarrowLaneVec));
+        }
+
+        if (pos < count) {
+            NarrowLaneVec lanes = {1.0f, 1.0f, 1.0f, 1.0f};
+            std::memcpy(&lanes, xs.data() + pos, (count - pos) * sizeof(float));
+            lanes = __builtin_convertvector(kernel(__builtin_convertvector(lanes, LaneVec)), NarrowLaneVec);
+            std::memcpy(out.data() + pos, &lanes, (count - pos) * sizeof(float));
+        }
+    }
+
+    /* Lane kernels */
+
+    /// @note exp(x) = 2^n * exp(r) with n = round(x / ln 2). The 2^n scaling is split in two factors so that n = 1024 and subnormal results need no special path.
+    static LaneVec expLanes(LaneVec x) {
+        const LaneVec clamped = selectLanes(x > splatLanes(710.0), splatLanes(710.0), selectLanes(x < splatLanes(-746.0), splatLanes(-746.0), x));
+        const LaneVec shifted = clamped * log2_e + round_shifter;
+        const LaneVec n = shifted - round_shifter;
+        const LaneBits whole_n = asBits(shifted) - asBits(splatLanes(round_shifter));
+
+        const LaneVec r = (clamped - n * ln2_hi) - n * ln2_lo;
+        const LaneVec poly = evalHorner(r, exp_coeffs);
+
+        const LaneBits half_n = whole_n >> 1;
+        const LaneVec scale_1 = asLanes((half_n + 1023) << 52);
+        const LaneVec scale_2 = asLanes((whole_n - half_n + 1023) << 52);
+
+        LaneVec result = poly * scale_1 * scale_2;
+        result = selectLanes(x > splatLanes(exp_overflow), splatLanes(std::numeric_limits<double>::infinity()), result);
+        result = selectLanes(x < splatLanes(exp_underflow), splatLanes(0.0), result);
+
+        return selectLanes(x != x, x, result);
+    }
+
+    /// @note ln(x) = k * ln 2 + log(1 + f) with 1 + f in [sqrt(2) / 2, sqrt(2)). Subnormal x get pre-scaled by 2^54.
+    static LaneVec lnLanes(LaneVec x) {
+        const LaneBits tiny = x < splatLanes(0x1p-1022);
+        const LaneBits bits = asBits(selectLanes(tiny, x * 0x1p54, x));
+
+        LaneBits exponent = ((bits >> 52) & 0x7ff) - 1023 - (tiny & 54);
+        LaneVec mantissa = asLanes((bits & 0x000fffffffffffffLL) | 0x3ff0000000000000LL);
+
+        const LaneBits high = mantissa > splatLanes(sqrt_two);
+        mantissa = selectLanes(high, mantissa * 0.5, mantissa);
+        exponent -= high;
+
+        const LaneVec f = mantissa - 1.0;
+        const LaneVec s = f / (f + 2.0);
+        const LaneVec z = s * s;
+        const LaneVec tail = z * evalHorner(z, ln_coeffs);
+        const LaneVec half_f_sq = 0.5 * f * f;
+        const LaneVec k = __builtin_convertvector(exponent, LaneVec);
+
+        LaneVec result = k * ln2_hi - ((half_f_sq - (s * (half_f_sq + tail) + k * ln2_lo)) - f);
+        result = selectLanes(x == splatLanes(std::numeric_limits<double>::infinity()), x, result);
+        result = selectLanes(x == splatLanes(0.0), splatLanes(-std::numeric_limits<double>::infinity()), result);
+
+        return selectLanes((x < splatLanes(0.0)) | (x != x), splatLanes(std::numeric_limits<double>::quiet_NaN()), result);
+    }
+
+    /// @note Reduces x = q * pi / 2 + r, then picks +-sin(r) or +-cos(r) by quadrant. cos(x) is sin(x) shifted by one quadrant.
+    static LaneVec sinCosLanes(LaneVec x, std::int64_t quadrant_shift, double (*fallback)(double)) {
+        const LaneVec shifted = x * two_over_pi + round_shifter;
+        const LaneVec q = shifted - round_shifter;
+        const LaneBits quadrant = asBits(shifted) - asBits(splatLanes(round_shifter)) + quadrant_shift;
+
+        const LaneVec r = (((x - q * pio2_1) - q * pio2_2) - q * pio2_3) - q * pio2_3t;
+        const LaneVec z = r * r;
+
+        const LaneVec sin_r = r + r * z * evalHorner(z, sin_coeffs);
+        const LaneVec half_z = 0.5 * z;
+        const LaneVec w = 1.0 - half_z;
+        const LaneVec cos_r = w + (((1.0 - w) - half_z) + z * z * evalHorner(z, cos_coeffs));
+
+        const LaneBits use_cos = (quadrant & 1) != LaneBits {};
+        const LaneBits negate = (quadrant & 2) != LaneBits {};
+        const LaneBits sign_bit = asBits(splatLanes(-0.0));
+
+        LaneVec result = selectLanes(use_cos, cos_r, sin_r);
+        result = asLanes(asBits(result) ^ (negate & sign_bit));
+
+        const LaneVec magnitude = asLanes(asBits(x) & ~sign_bit);
+        const LaneBits too_big = (magnitude > splatLanes(sincos_reduction_limit)) | (x != x);
+
+        for (std::size_t lane = 0; lane < lane_count; lane++) {
+            if (too_big[lane]) {
+                result[lane] = fallback(x[lane]);
+            }
+        }
+
+        return result;
+    }
+
+    static double scalarSin(double x) { return std::sin(x); }
+
+    static double scalarCos(double x) { return std::cos(x); }
+
+    void sinBatch(std::span<const double> xs, std::span<double> out) {
+        runLanes(xs, out, [](LaneVec x) { return sinCosLanes(x, 0, scalarSin); });
+    }
+
+    void cosBatch(std::span<const double> xs, std::span<double> out) {
+        runLanes(xs, out, [](LaneVec x) { return sinCosLanes(x, 1, scalarCos); });
+    }
+
+    void expBatch(std::span<const double> xs, std::span<double> out) {
+        runLanes(xs, out, expLanes);
+    }
+
+    void lnBatch(std::span<const double> xs, std::span<double> out) {
+        runLanes(xs, out, lnLanes);
+    }
+
+    void sqrtBatch(std::span<const double> xs, std::span<double> out) {
+        const std::size_t count = xs.size();
+
+        for (std::size_t i = 0; i < count; i++) {
+            out[i] = std::sqrt(xs[i]);
+        }
+    }
+
+    void sinBatch(std::span<const float> xs, std::span<float> out) {
+        runNarrowLanes(xs, out, [](LaneVec x) { return sinCosLanes(x, 0, scalarSin); });
+    }
+
+    void cosBatch(std::span<const float> xs, std::span<float> out) {
+        runNarrowLanes(xs, out, [](LaneVec x) { return sinCosLanes(x, 1, scalarCos); });
+    }
+
+    void expBatch(std::span<const float> xs, std::span<float> out) {
+        runNarrowLanes(xs, out, expLanes);
+    }
+
+    void lnBatch(std::span<const float> xs, std::span<float> out) {
+        runNarrowLanes(xs, out, lnLanes);
+    }
+
+    void sqrtBatch(std::span<const float> xs, std::span<float> out) {
+        const std::size_t count = xs.size();
+
+        for (std::size_t i = 0; i < count; i++) {
+            out[i] = std::sqrt(xs[i]);
+        }
+    }
+}
@@ -0,0 +1,191 @@
+/**
+ * @file ParameterEvaluator.cpp
+ * @author DrkWithT
+ * @brief Implements late-bound tape evaluation over parameter blocks, in single or double precision.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include "Models/ParameterEvaluator.hpp"
+#include "Models/IntPower.hpp"
+#include "Models/MathKernels.hpp"
+
+namespace GeneralDeriver::Models {
+    static constexpr std::size_t x_slot = 0;
+
+    std::optional<std::size_t> findParameter(std::span<const std::string> slot_names, std::string_view name) {
+        const auto name_it = std::find(slot_names.begin(), slot_names.end(), name);
+
+        if (name_it == slot_names.end() || name_it == slot_names.begin()) {
+            return {};
+        }
+
+        return static_cast<std::size_t>(name_it - slot_names.begin()) - 1;
+    }
+
+    template <typename Scalar>
+    BasicParameterEvaluator<Scalar>::BasicParameterEvaluator(const Tape& tape_, std::size_t parameter_count_)
+    : tape {&tape_}, constants {}, terms {}, values(tape_.getNodes().size() * lane_width), parameter_count {parameter_count_} {
+        if (tape_.getSlotCount() > parameter_count_ + 1) {
+            throw std::invalid_argument {"ParameterEvaluator: parameter block smaller than the tape's slots"};
+        }
+
+        for (const auto& node : tape_.getNodes()) {
+            constants.push_back(static_cast<Scalar>(node.value));
+        }
+
+        for (auto [coeff, power] : tape_.getTerms()) {
+            terms.push_back({static_cast<Scalar>(coeff), power});
+        }
+    }
+
+    template <typename Scalar>
+    std::size_t BasicParameterEvaluator<Scalar>::getParameterCount() const { return parameter_count; }
+
+    template <typename Scalar>
+    void BasicParameterEvaluator<Scalar>::sweepLanes(std::span<const Scalar> xs, std::span<const Scalar> params, std::size_t param_stride, std::size_t lane_begin, std::size_t lane_count) {
+        const auto& nodes = tape->getNodes();
+        const std::size_t count = nodes.size();
+        const auto lane_xs = xs.subspan(lane_begin, lane_count);
+
+        for (std::size_t i = 0; i < count; i++) {
+            const TapeNode& node = nodes[i];
+            const std::span<Scalar> row {values.data() + i * lane_width, lane_count};
+            // Leaves keep a slot or term range in lhs & rhs, not operand rows.
+            const bool is_leaf = node.op == TapeOp::constant || node.op == TapeOp::variable || node.op == TapeOp::polynomial;
+            const Scalar* lhs = is_leaf ? nullptr : values.data() + static_cast<std::size_t>(node.lhs) * lane_width;
+            const Scalar* rhs = is_leaf ? nullptr : values.data() + static_cast<std::size_t>(node.rhs) * lane_width;
+
+            switch (node.op) {
+            case TapeOp::constant:
+                std::fill(row.begin(), row.end(), constants[i]);
+                break;
+            case TapeOp::variable:
+                if (node.lhs == x_slot) {
+                    std::copy(lane_xs.begin(), lane_xs.end(), row.begin());
+                } else {
+                    // A stride of 0 broadcasts one block to every lane.
+                    for (std::size_t lane = 0; lane < lane_count; lane++) {
+                        row[lane] = params[(lane_begin + lane) * param_stride + node.lhs - 1];
+                    }
+                }
+                break;
+            case TapeOp::polynomial:
+                std::fill(row.begin(), row.end(), Scalar {0});
+
+                for (std::uint32_t t = node.lhs; t < node.lhs + node.rhs; t++) {
+                    const auto [coeff, power] = terms[t];
+
+                    if (power == 0.0) {
+                        for (Scalar& lane_value : row) {
+                            lane_value += coeff;
+                        }
+                    } else if (isIntPowerExponent(power)) {
+                        for (std::size_t lane = 0; lane < lane_count; lane++) {
+                            row[lane] += coeff * raiseToInteger(lane_xs[lane], static_cast<std::int32_t>(power));
+                        }
+                    } else {
+                        for (std::size_t lane = 0; lane < lane_count; lane++) {
+                            row[lane] += coeff * static_cast<Scalar>(std::pow(lane_xs[lane], static_cast<Scalar>(power)));
+                        }
+                    }
+                }
+                break;
+            case TapeOp::add:
+                for (std::size_t lane = 0; lane < lane_count; lane++) {
+                    row[lane] = lhs[lane] + rhs[lane];
+                }
+                break;
+            case TapeOp::sub:
+                for (std::size_t lane = 0; lane < lane_count; lane++) {
+                    row[lane] = lhs[lane] - rhs[lane];
+                }
+                break;
+            case TapeOp::mul:
+                for (std::size_t lane = 0; lane < lane_count; lane++) {
+                    row[lane] = lhs[lane] * rhs[lane];
+                }
+                break;
+            case TapeOp::div:
+                for (std::size_t lane = 0; lane < lane_count; lane++) {
+                    row[lane] = lhs[lane] / rhs[lane];
+                }
+                break;
+            case TapeOp::power:
+                for (std::size_t lane = 0; lane < lane_count; lane++) {
+                    row[lane] = std::pow(lhs[lane], rhs[lane]);
+                }
+                break;
+            case TapeOp::int_power:
+                for (std::size_t lane = 0; lane < lane_count; lane++) {
+                    row[lane] = raiseToInteger(lhs[lane], static_cast<std::int32_t>(node.value));
+                }
+                break;
+            case TapeOp::neg:
+                for (std::size_t lane = 0; lane < lane_count; lane++) {
+                    row[lane] = -lhs[lane];
+                }
+                break;
+            case TapeOp::sin:
+                sinBatch({lhs, lane_count}, row);
+                break;
+            case TapeOp::cos:
+                cosBatch({lhs, lane_count}, row);
+                break;
+            case TapeOp::exp:
+                expBatch({lhs, lane_count}, row);
+                break;
+            case TapeOp::ln:
+                lnBatch({lhs, lane_count}, row);
+                break;
+            case TapeOp::sqrt:
+                sqrtBatch({lhs, lane_count}, row);
+                break;
+            }
+        }
+    }
+
+    template <typename Scalar>
+    void BasicParameterEvaluator<Scalar>::sweepAll(std::span<const Scalar> xs, std::span<const Scalar> params, std::size_t param_stride, std::span<Scalar> out) {
+        if (values.empty()) {
+            std::fill(out.begin(), out.begin() + xs.size(), Scalar {0});
+            return;
+        }
+
+        const std::size_t root_row = values.size() - lane_width;
+
+        for (std::size_t lane_begin = 0; lane_begin < xs.size(); lane_begin += lane_width) {
+            const std::size_t lane_count = std::min(lane_width, xs.size() - lane_begin);
+
+            sweepLanes(xs, params, param_stride, lane_begin, lane_count);
+            std::copy_n(values.begin() + root_row, lane_count, out.begin() + lane_begin);
+        }
+    }
+
+    template <typename Scalar>
+    Scalar BasicParameterEvaluator<Scalar>::evalAt(Scalar x, std::span<const Scalar> params) {
+        Scalar result {0};
+
+        sweepAll({&x, 1}, params, 0, {&result, 1});
+
+        return result;
+    }
+
+    template <typename Scalar>
+    void BasicParameterEvaluator<Scalar>::evalBatch(std::span<const Scalar> xs, std::span<const Scalar> params, std::span<Scalar> out) {
+        sweepAll(xs, params, 0, out);
+    }
+
+    template <typename Scalar>
+    void BasicParameterEvaluator<Scalar>::evalSets(std::span<const Scalar> xs, std::span<const Scalar> param_sets, std::span<Scalar> out) {
+        sweepAll(xs, param_sets, parameter_count, out);
+    }
+
+    template class BasicParameterEvaluator<float>;
+    template class BasicParameterEvaluator<double>;
+}
@@ -0,0 +1,338 @@
+/**
+ * @file PolyAlgebra.cpp
+ * @author DrkWithT
+ * @brief Implements canonical-form arithmetic on Polynomial models.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include "Models/PolyAlgebra.hpp"
+#include "Models/PolyKernels.hpp"
+
+namespace GeneralDeriver::Models {
+    static constexpr double zero_coefficient = 0.0;
+    static constexpr std::size_t max_dense_degree = 1 << 20; // beyond this, sparse terms are the only sane layout anyway
+    static constexpr double gcd_tolerance = 1e-9; // relative size under which a remainder coefficient counts as rounding
+
+    static std::vector<double> toDenseCoefficients(const Polynomial& poly, std::size_t degree) {
+        if (poly.getLayout() == PolyLayout::dense) {
+            const auto dense = poly.getDenseCoeffs();
+
+            return {dense.begin(), dense.end()};
+        }
+
+        std::vector<double> coeffs(degree + 1, zero_coefficient);
+        const auto powers = poly.getSparsePowers();
+        const auto sparse = poly.getSparseCoeffs();
+
+        for (std::size_t i = 0; i < powers.size(); i++) {
+            coeffs[static_cast<std::size_t>(powers[i])] = sparse[i];
+        }
+
+        return coeffs;
+    }
+
+    /// @note Dense products only pay off when the operands are not mostly gaps, e.g x^500 + 1 stays sparse.
+    static bool isWorthDense(const Polynomial& poly, std::size_t degree) {
+        return poly.getLayout() == PolyLayout::dense || Polynomial::prefersDense(degree, poly.getTermCount());
+    }
+
+    /// @note Applies `transform` to each coefficient, keeping dense coefficients dense.
+    template <typename CoeffTransform>
+    static Polynomial mapCoefficients(const Polynomial& poly, CoeffTransform transform) {
+        if (poly.getLayout() == PolyLayout::dense) {
+            std::vector<double> coeffs = toDenseCoefficients(poly, 0);
+
+            for (auto& coeff : coeffs) {
+                coeff = transform(coeff);
+            }
+
+            return Polynomial::fromDense(std::move(coeffs));
+        }
+
+        std::vector<PolynomialTerm> terms = poly.getTerms();
+
+        for (auto& term : terms) {
+            term.coeff = transform(term.coeff);
+        }
+
+        return Polynomial {std::move(terms)};
+    }
+
+    /// @note Dense pairs add by index, any other pair merges terms.
+    static Polynomial combineTerms(const Polynomial& lhs, const Polynomial& rhs, double rhs_sign) {
+        if (lhs.getLayout() == PolyLayout::dense && rhs.getLayout() == PolyLayout::dense) {
+            const auto rhs_coeffs = rhs.getDenseCoeffs();
+            std::vector<double> coeffs = toDenseCoefficients(lhs, 0);
+
+            if (coeffs.size() < rhs_coeffs.size()) {
+                coeffs.resize(rhs_coeffs.size(), zero_coefficient);
+            }
+
+            for (std::size_t i = 0; i < rhs_coeffs.size(); i++) {
+                coeffs[i] += rhs_sign * rhs_coeffs[i];
+            }
+
+            return Polynomial::fromDense(std::move(coeffs));
+        }
+
+        std::vector<PolynomialTerm> terms = lhs.getTerms();
+
+        for (auto [coeff, power] : rhs.getTerms()) {
+            terms.push_back({rhs_sign * coeff, power});
+        }
+
+        return Polynomial {std::move(terms)};
+    }
+
+    Polynomial normalizePolynomial(std::vector<PolynomialTerm> terms) {
+        return Polynomial {std::move(terms)};
+    }
+
+    /// @note Constants always land in the dense layout, as one coefficient or none for zero.
+    std::optional<double> getConstantValue(const Polynomial& poly) {
+        const auto dense = poly.getDenseCoeffs();
+
+        if (poly.getLayout() != PolyLayout::dense || dense.size() > 1) {
+            return {};
+        }
+
+        return dense.empty() ? zero_coefficient : dense[0];
+    }
+
+    std::optional<std::size_t> getDenseDegree(const Polynomial& poly) {
+        switch (poly.getLayout()) {
+        case PolyLayout::dense:
+            return poly.getDenseCoeffs().empty() ? 0 : poly.getDenseCoeffs().size() - 1;
+        case PolyLayout::sparse:
+            if (static_cast<std::size_t>(poly.getSparsePowers().front()) <= max_dense_degree) {
+                return static_cast<std::size_t>(poly.getSparsePowers().front());
+            }
+            return {};
+        case PolyLayout::general:
+        default:
+            return {};
+        }
+    }
+
+    Polynomial addPolynomials(const Polynomial& lhs, const Polynomial& rhs) {
+        return combineTerms(lhs, rhs, 1.0);
+    }
+
+    Polynomial subtractPolynomials(const Polynomial& lhs, const Polynomial& rhs) {
+        return combineTerms(lhs, rhs, -1.0);
+    }
+
+    Polynomial negatePolynomial(const Polynomial& poly) {
+        return mapCoefficients(poly, [](double coeff) { return -coeff; });
+    }
+
+    Polynomial dividePolynomial(const Polynomial& poly, double divisor) {
+        return mapCoefficients(poly, [divisor](double coeff) { return coeff / divisor; });
+    }
+
+    Polynomial multiplyPolynomials(const Polynomial& lhs, const Polynomial& rhs) {
+        const auto lhs_degree = getDenseDegree(lhs);
+        const auto rhs_degree = getDenseDegree(rhs);
+
+        if (lhs_degree && rhs_degree && isWorthDense(lhs, *lhs_degree) && isWorthDense(rhs, *rhs_degree)) {
+            return Polynomial::fromDense(multiplyDense(toDenseCoefficients(lhs, *lhs_degree), toDenseCoefficients(rhs, *rhs_degree)));
+        }
+
+        const auto lhs_terms = lhs.getTerms();
+        const auto rhs_terms = rhs.getTerms();
+        std::vector<PolynomialTerm> terms;
+        terms.reserve(lhs_terms.size() * rhs_terms.size());
+
+        for (auto [lhs_coeff, lhs_power] : lhs_terms) {
+            for (auto [rhs_coeff, rhs_power] : rhs_terms) {
+                terms.push_back({lhs_coeff * rhs_coeff, lhs_power + rhs_power});
+            }
+        }
+
+        return Polynomial {std::move(terms)};
+    }
+
+    Polynomial raisePolynomial(const Polynomial& base, unsigned int exponent) {
+        if (const auto degree = getDenseDegree(base); degree && isWorthDense(base, *degree)) {
+            return Polynomial::fromDense(raiseDense(toDenseCoefficients(base, *degree), exponent));
+        }
+
+        Polynomial result = Polynomial::fromDense({1});
+        Polynomial square = base;
+
+        for (unsigned int bits = exponent; bits != 0; bits >>= 1) {
+            if (bits & 1) {
+                result = multiplyPolynomials(result, square);
+            }
+
+            if (bits > 1) {
+                square = multiplyPolynomials(square, square);
+            }
+        }
+
+        return result;
+    }
+
+    Polynomial derivePolynomial(const Polynomial& poly) {
+        return poly.makeDerivative().unpackFunctionAny<Polynomial>();
+    }
+
+    /// @note Drops leading coefficients within `tolerance` of zero, so `coeffs.back()` is the true leading one.
+    static void trimDense(std::vector<double>& coeffs, double tolerance) {
+        while (!coeffs.empty() && std::fabs(coeffs.back()) <= tolerance) {
+            coeffs.pop_back();
+        }
+    }
+
+    static double getMaxMagnitude(const std::vector<double>& coeffs) {
+        double result = zero_coefficient;
+
+        for (auto coeff : coeffs) {
+            result = std::max(result, std::fabs(coeff));
+        }
+
+        return result;
+    }
+
+    static void makeMonic(std::vector<double>& coeffs) {
+        const double leading = coeffs.back();
+
+        for (auto& coeff : coeffs) {
+            coeff /= leading;
+        }
+
+        coeffs.back() = 1.0;
+    }
+
+    /// @note Leaves the remainder in `dividend` and returns the quotient. The divisor must be trimmed and non-empty.
+    static std::vector<double> divideDense(std::vector<double>& dividend, const std::vector<double>& divisor) {
+        const std::size_t divisor_degree = divisor.size() - 1;
+
+        if (dividend.size() < divisor.size()) {
+            return {};
+        }
+
+        std::vector<double> quotient(dividend.size() - divisor_degree, zero_coefficient);
+
+        for (std::size_t pos = quotient.size(); pos-- > 0;) {
+            const double factor = dividend[pos + divisor_degree] / divisor.back();
+            quotient[pos] = factor;
+
+            for (std::size_t i = 0; i < divisor_degree; i++) {
+                dividend[pos + i] -= factor * divisor[i];
+            }
+
+            dividend[pos + divisor_degree] = zero_coefficient;
+        }
+
+        dividend.resize(divisor_degree);
+
+        return quotient;
+    }
+
+    static std::optional<std::vector<double>> toTrimmedDense(const Polynomial& poly) {
+        const auto degree = getDenseDegree(poly);
+
+        if (!degree) {
+            return {};
+        }
+
+        std::vector<double> coeffs = toDenseCoefficients(poly, *degree);
+        trimDense(coeffs, zero_coefficient);
+
+        return coeffs;
+    }
+
+    std::optional<PolyDivision> dividePolynomials(const Polynomial& dividend, const Polynomial& divisor) {
+        auto dividend_coeffs = toTrimmedDense(dividend);
+        auto divisor_coeffs = toTrimmedDense(divisor);
+
+        if (!dividend_coeffs || !divisor_coeffs || divisor_coeffs->empty()) {
+            return {};
+        }
+
+        auto quotient = divideDense(*dividend_coeffs, *divisor_coeffs);
+
+        return PolyDivision {Polynomial::fromDense(std::move(quotient)), Polynomial::fromDense(std::move(*dividend_coeffs))};
+    }
+
+    std::optional<Polynomial> divideExactly(const Polynomial& dividend, const Polynomial& divisor) {
+        auto dividend_coeffs = toTrimmedDense(dividend);
+        auto divisor_coeffs = toTrimmedDense(divisor);
+
+        if (!dividend_coeffs || !divisor_coeffs || divisor_coeffs->empty()) {
+            return {};
+        }
+
+        const double tolerance = gcd_tolerance * getMaxMagnitude(*dividend_coeffs);
+        auto quotient = divideDense(*dividend_coeffs, *divisor_coeffs);
+
+        if (getMaxMagnitude(*dividend_coeffs) > tolerance) {
+            return {};
+        }
+
+        return Polynomial::fromDense(std::move(quotient));
+    }
+
+    std::optional<Polynomial> gcdPolynomials(const Polynomial& lhs, const Polynomial& rhs) {
+        auto lhs_coeffs = toTrimmedDense(lhs);
+        auto rhs_coeffs = toTrimmedDense(rhs);
+
+        if (!lhs_coeffs || !rhs_coeffs) {
+            return {};
+        }
+
+        // gcd(p, 0) is p itself, made monic. gcd(0, 0) has no monic form, so it stays 0.
+        if (lhs_coeffs->empty() || rhs_coeffs->empty()) {
+            auto& nonzero = (lhs_coeffs->empty()) ? *rhs_coeffs : *lhs_coeffs;
+
+            if (!nonzero.empty()) {
+                makeMonic(nonzero);
+            }
+
+            return Polynomial::fromDense(std::move(nonzero));
+        }
+
+        std::vector<double> current = *lhs_coeffs;
+        std::vector<double> next = *rhs_coeffs;
+        makeMonic(current);
+        makeMonic(next);
+
+        if (current.size() < next.size()) {
+            std::swap(current, next);
+        }
+
+        while (next.size() > 1) {
+            const double tolerance = gcd_tolerance * std::max(getMaxMagnitude(current), getMaxMagnitude(next));
+
+            divideDense(current, next);
+            trimDense(current, tolerance);
+
+            if (current.empty()) {
+                break;
+            }
+
+            makeMonic(current);
+            std::swap(current, next);
+        }
+
+        // A non-zero constant last remainder means the operands are coprime.
+        if (!current.empty() && next.size() == 1) {
+            return Polynomial::fromDense({1.0});
+        }
+
+        Polynomial result = Polynomial::fromDense(std::move(next));
+
+        if (!divideExactly(lhs, result) || !divideExactly(rhs, result)) {
+            return Polynomial::fromDense({1.0});
+        }
+
+        return result;
+    }
+}
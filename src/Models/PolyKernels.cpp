@@ -0,0 +1,318 @@
+/**
+ * @file PolyKernels.cpp
+ * @author DrkWithT
+ * @brief Implements dense polynomial multiplication kernels: schoolbook, Karatsuba and FFT.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <numbers>
+#include "Models/PolyKernels.hpp"
+
+namespace GeneralDeriver::Models {
+    using ComplexValue = std::complex<double>;
+
+    static constexpr std::size_t karatsuba_cutoff = 32;    // shorter operands go schoolbook
+    static constexpr std::size_t fft_cutoff = 512;         // shorter operands go Karatsuba
+    static constexpr double fft_max_relative_error = 1e-9; // allowed fast-method error over the smallest product of coefficients
+    static constexpr double fft_error_factor = 8.0;        // slack over the error models in checkAccuracy
+    static constexpr double exact_whole_limit = 0x1p52;    // whole results below this round back exactly
+
+    /* Accuracy guard */
+
+    struct CoeffRange {
+        double min_abs;  // smallest non-zero magnitude
+        double max_abs;
+        bool whole;
+    };
+
+    static CoeffRange measureRange(std::span<const double> coeffs) {
+        CoeffRange range {std::numeric_limits<double>::infinity(), 0.0, true};
+
+        for (auto coeff : coeffs) {
+            const double magnitude = std::fabs(coeff);
+
+            if (magnitude == 0.0) {
+                continue;
+            }
+
+            range.min_abs = std::min(range.min_abs, magnitude);
+            range.max_abs = std::max(range.max_abs, magnitude);
+            range.whole = range.whole && coeff == std::floor(coeff);
+        }
+
+        return range;
+    }
+
+    /// @brief Which fast methods keep every result coefficient accurate for one pair of operands.
+    struct MulAccuracy {
+        bool karatsuba_ok;
+        bool fft_ok;
+        bool fft_round_whole; // FFT results get rounded back to whole numbers
+    };
+
+    /**
+     * @note Both fast methods have norm-wise error: each result coefficient is off by about eps * max|lhs| * max|rhs| times a growth term, no matter how small that coefficient is. So they are only accurate when that bound stays below `fft_max_relative_error` of the smallest coefficient product.
+     *  - Karatsuba: the growth is the operand length, as each split level doubles the magnitude of the summed halves. Whole-number inputs are exact instead while those sums stay below 2^52.
+     *  - FFT: the growth is log2(n) * sqrt(length) for the transform rounding.
+     */
+    static MulAccuracy checkAccuracy(std::span<const double> lhs, std::span<const double> rhs) {
+        const auto lhs_range = measureRange(lhs);
+        const auto rhs_range = measureRange(rhs);
+
+        if (lhs_range.max_abs == 0.0 || rhs_range.max_abs == 0.0 || !std::isfinite(lhs_range.max_abs) || !std::isfinite(rhs_range.max_abs)) {
+            return {false, false, false};
+        }
+
+        const double eps = std::numeric_limits<double>::epsilon();
+        const double shorter = static_cast<double>(std::min(lhs.size(), rhs.size()));
+        const double fft_size = static_cast<double>(std::bit_ceil(lhs.size() + rhs.size() - 1));
+        const double max_product = lhs_range.max_abs * rhs_range.max_abs;
+        const double allowed_error = fft_max_relative_error * lhs_range.min_abs * rhs_range.min_abs;
+        const bool whole = lhs_range.whole && rhs_range.whole;
+
+        const double karatsuba_error = fft_error_factor * eps * shorter * max_product;
+        const bool karatsuba_exact = whole && max_product * shorter * shorter / static_cast<double>(karatsuba_cutoff) < exact_whole_limit;
+
+        const double fft_error = fft_error_factor * eps * std::log2(fft_size) * std::sqrt(shorter) * max_product;
+        const bool fft_round_whole = whole && fft_error < 0.25 && max_product * shorter < exact_whole_limit;
+
+        return {
+            karatsuba_exact || karatsuba_error <= allowed_error,
+            fft_round_whole || fft_error <= allowed_error,
+            fft_round_whole
+        };
+    }
+
+    /* Kernels */
+
+    static void addSchoolbook(std::span<const double> lhs, std::span<const double> rhs, std::span<double> out) {
+        for (std::size_t i = 0; i < lhs.size(); i++) {
+            const double lhs_coeff = lhs[i];
+
+            if (lhs_coeff == 0.0) {
+                continue;
+            }
+
+            for (std::size_t j = 0; j < rhs.size(); j++) {
+                out[i + j] += lhs_coeff * rhs[j];
+            }
+        }
+    }
+
+    /// @note Adds the product of equal-length operands into `out`. The low halves get `half` coefficients and the high halves the rest, which may be one longer.
+    static void addKaratsuba(std::span<const double> lhs, std::span<const double> rhs, std::span<double> out) {
+        const std::size_t count = lhs.size();
+
+        if (count < karatsuba_cutoff) {
+            addSchoolbook(lhs, rhs, out);
+            return;
+        }
+
+        const std::size_t half = count / 2;
+        const std::size_t high = count - half;
+
+        const auto lhs_low = lhs.first(half);
+        const auto lhs_high = lhs.subspan(half);
+        const auto rhs_low = rhs.first(half);
+        const auto rhs_high = rhs.subspan(half);
+
+        std::vector<double> low_product(2 * half - 1, 0.0);
+        std::vector<double> high_product(2 * high - 1, 0.0);
+        addKaratsuba(lhs_low, rhs_low, low_product);
+        addKaratsuba(lhs_high, rhs_high, high_product);
+
+        std::vector<double> lhs_sum {lhs_high.begin(), lhs_high.end()};
+        std::vector<double> rhs_sum {rhs_high.begin(), rhs_high.end()};
+
+        for (std::size_t i = 0; i < half; i++) {
+            lhs_sum[i] += lhs_low[i];
+            rhs_sum[i] += rhs_low[i];
+        }
+
+        std::vector<double> mid_product(2 * high - 1, 0.0);
+        addKaratsuba(lhs_sum, rhs_sum, mid_product);
+
+        for (std::size_t i = 0; i < low_product.size(); i++) {
+            mid_product[i] -= low_product[i];
+            out[i] += low_product[i];
+        }
+
+        for (std::size_t i = 0; i < high_product.size(); i++) {
+            mid_product[i] -= high_product[i];
+            out[i + 2 * half] += high_product[i];
+        }
+
+        for (std::size_t i = 0; i < mid_product.size(); i++) {
+            out[i + half] += mid_product[i];
+        }
+    }
+
+    /// @note Splits the longer operand into chunks as long as the shorter one, so each chunk product is a balanced Karatsuba call.
+    static void addChunkedKaratsuba(std::span<const double> lhs, std::span<const double> rhs, std::span<double> out) {
+        const auto longer = (lhs.size() >= rhs.size()) ? lhs : rhs;
+        const auto shorter = (lhs.size() >= rhs.size()) ? rhs : lhs;
+        const std::size_t chunk = shorter.size();
+
+        std::vector<double> padded(chunk, 0.0);
+
+        for (std::size_t begin = 0; begin < longer.size(); begin += chunk) {
+            const std::size_t length = std::min(chunk, longer.size() - begin);
+            std::fill(padded.begin(), padded.end(), 0.0);
+            std::copy_n(longer.begin() + begin, length, padded.begin());
+
+            // The padded tail only adds zeros past the real product, so clip the output window to stay in bounds.
+            std::vector<double> chunk_product(2 * chunk - 1, 0.0);
+            addKaratsuba(padded, shorter, chunk_product);
+
+            const std::size_t kept = std::min(chunk_product.size(), out.size() - begin);
+
+            for (std::size_t i = 0; i < kept; i++) {
+                out[begin + i] += chunk_product[i];
+            }
+        }
+    }
+
+    /// @note Iterative radix-2 FFT. Twiddles come from one table of directly computed roots instead of repeated multiplication, which keeps their error at 1 ULP.
+    static void transformFft(std::vector<ComplexValue>& values, const std::vector<ComplexValue>& roots, bool inverse) {
+        const std::size_t size = values.size();
+
+        for (std::size_t i = 1, j = 0; i < size; i++) {
+            std::size_t bit = size >> 1;
+
+            for (; j & bit; bit >>= 1) {
+                j ^= bit;
+            }
+
+            j ^= bit;
+
+            if (i < j) {
+                std::swap(values[i], values[j]);
+            }
+        }
+
+        for (std::size_t span_len = 2; span_len <= size; span_len <<= 1) {
+            const std::size_t half = span_len / 2;
+            const std::size_t root_step = size / span_len;
+
+            for (std::size_t begin = 0; begin < size; begin += span_len) {
+                for (std::size_t k = 0; k < half; k++) {
+                    const auto root = inverse ? std::conj(roots[k * root_step]) : roots[k * root_step];
+                    const auto odd = values[begin + k + half] * root;
+
+                    values[begin + k + half] = values[begin + k] - odd;
+                    values[begin + k] += odd;
+                }
+            }
+        }
+    }
+
+    /// @note Packs lhs as real parts and rhs as imaginary parts, so one forward transform serves both operands: the product spectrum is (Z(k)^2 - conj(Z(n - k))^2) / 4i.
+    static std::vector<double> multiplyFft(std::span<const double> lhs, std::span<const double> rhs, bool round_whole) {
+        const std::size_t result_size = lhs.size() + rhs.size() - 1;
+        const std::size_t size = std::bit_ceil(result_size);
+
+        std::vector<ComplexValue> roots(size / 2);
+
+        for (std::size_t k = 0; k < roots.size(); k++) {
+            roots[k] = std::polar(1.0, -2.0 * std::numbers::pi * static_cast<double>(k) / static_cast<double>(size));
+        }
+
+        std::vector<ComplexValue> packed(size);
+
+        for (std::size_t i = 0; i < lhs.size(); i++) {
+            packed[i].real(lhs[i]);
+        }
+
+        for (std::size_t i = 0; i < rhs.size(); i++) {
+            packed[i].imag(rhs[i]);
+        }
+
+        transformFft(packed, roots, false);
+
+        std::vector<ComplexValue> spectrum(size);
+
+        for (std::size_t k = 0; k < size; k++) {
+            const auto mirrored = std::conj(packed[(size - k) & (size - 1)]);
+            spectrum[k] = (packed[k] * packed[k] - mirrored * mirrored) * ComplexValue {0.0, -0.25};
+        }
+
+        transformFft(spectrum, roots, true);
+
+        std::vector<double> result(result_size);
+
+        for (std::size_t i = 0; i < result_size; i++) {
+            const double value = spectrum[i].real() / static_cast<double>(size);
+            result[i] = round_whole ? std::round(value) : value;
+        }
+
+        return result;
+    }
+
+    MulMethod pickMulMethod(std::span<const double> lhs, std::span<const double> rhs) {
+        const std::size_t shorter = std::min(lhs.size(), rhs.size());
+
+        if (shorter < karatsuba_cutoff) {
+            return MulMethod::schoolbook;
+        }
+
+        const auto accuracy = checkAccuracy(lhs, rhs);
+
+        if (shorter >= fft_cutoff && accuracy.fft_ok) {
+            return MulMethod::fft;
+        } else if (accuracy.karatsuba_ok) {
+            return MulMethod::karatsuba;
+        }
+
+        // Schoolbook sums each coefficient from its own products only, so its error stays relative to that coefficient.
+        return MulMethod::schoolbook;
+    }
+
+    std::vector<double> multiplyDense(std::span<const double> lhs, std::span<const double> rhs) {
+        return multiplyDenseWith(pickMulMethod(lhs, rhs), lhs, rhs);
+    }
+
+    std::vector<double> multiplyDenseWith(MulMethod method, std::span<const double> lhs, std::span<const double> rhs) {
+        if (lhs.empty() || rhs.empty()) {
+            return {};
+        }
+
+        if (method == MulMethod::fft) {
+            return multiplyFft(lhs, rhs, checkAccuracy(lhs, rhs).fft_round_whole);
+        }
+
+        std::vector<double> result(lhs.size() + rhs.size() - 1, 0.0);
+
+        if (method == MulMethod::karatsuba) {
+            addChunkedKaratsuba(lhs, rhs, result);
+        } else {
+            addSchoolbook(lhs, rhs, result);
+        }
+
+        return result;
+    }
+
+    std::vector<double> raiseDense(std::span<const double> base, unsigned int exponent) {
+        std::vector<double> result {1.0};
+        std::vector<double> square {base.begin(), base.end()};
+
+        for (unsigned int bits = exponent; bits != 0; bits >>= 1) {
+            if (bits & 1) {
+                result = multiplyDense(result, square);
+            }
+
+            if (bits > 1) {
+                square = multiplyDense(square, square);
+            }
+        }
+
+        return result;
+    }
+}
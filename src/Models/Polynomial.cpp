@@ -8,74 +8,371 @@
  * 
  */
 
+#include <algorithm>
 #include <cmath>
 #include <utility>
-#include <sstream>
 #include "Models/IFunction.hpp"
 #include "Models/Polynomial.hpp"
+#include "Models/TextWriter.hpp"
 
 namespace GeneralDeriver::Models {
     static constexpr double zero_coefficient = 0.0;
+    static constexpr double max_squaring_power = 1024.0;
+    static constexpr double max_sparse_power = 1 << 30; // keeps powers & gaps between them inside int32
+
+    /// @note Repeated squaring, which vectorizes across x values unlike a `pow` call.
+    static double raiseWhole(double base, std::uint32_t exponent) {
+        double result = 1.0;
+
+        for (std::uint32_t bits = exponent; bits != 0; bits >>= 1) {
+            if (bits & 1) {
+                result *= base;
+            }
+
+            base *= base;
+        }
+
+        return result;
+    }
+
+    /// @note Scales a sparse Horner result by x^lowest.
+    static double scaleByLowest(double value, double x, std::int32_t lowest) {
+        return (lowest > 0) ? value * raiseWhole(x, static_cast<std::uint32_t>(lowest)) : value;
+    }
+
+    bool Polynomial::prefersDense(std::size_t degree, std::size_t term_count) {
+        return degree < 4 * term_count + 16;
+    }
+
+    Polynomial Polynomial::fromDense(std::vector<double> coeffs_) {
+        Polynomial result;
+        result.adoptDense(coeffs_);
+
+        return result;
+    }
+
+    void Polynomial::adoptTerms(std::vector<PolynomialTerm>& terms_) {
+        if (!std::is_sorted(terms_.begin(), terms_.end(), [](const PolynomialTerm& lhs, const PolynomialTerm& rhs) { return lhs.power > rhs.power; })) {
+            std::sort(terms_.begin(), terms_.end(), [](const PolynomialTerm& lhs, const PolynomialTerm& rhs) {
+                return lhs.power > rhs.power;
+            });
+        }
+
+        std::size_t kept = 0;
+
+        for (std::size_t pos = 0; pos < terms_.size(); pos++) {
+            if (kept > 0 && terms_[kept - 1].power == terms_[pos].power) {
+                terms_[kept - 1].coeff += terms_[pos].coeff;
+            } else {
+                terms_[kept++] = terms_[pos];
+            }
+        }
+
+        terms_.resize(kept);
+
+        std::erase_if(terms_, [](const PolynomialTerm& term) {
+            return term.coeff == zero_coefficient;
+        });
+
+        // Negative powers stay general: Horner's rule over x^300 + x^-300 would overflow at x^600 before scaling back down.
+        const bool whole_powers = std::all_of(terms_.begin(), terms_.end(), [](const PolynomialTerm& term) {
+            return term.power == std::floor(term.power) && term.power >= zero_coefficient && term.power <= max_sparse_power;
+        });
+
+        coeffs.clear();
+        powers.clear();
+        terms.clear();
+
+        if (!whole_powers) {
+            terms = std::move(terms_);
+            layout = PolyLayout::general;
+            return;
+        }
+
+        if (terms_.empty() || prefersDense(static_cast<std::size_t>(terms_.front().power), terms_.size())) {
+            coeffs.assign(terms_.empty() ? 0 : static_cast<std::size_t>(terms_.front().power) + 1, zero_coefficient);
+
+            for (auto [coeff, power] : terms_) {
+                coeffs[static_cast<std::size_t>(power)] = coeff;
+            }
+
+            layout = PolyLayout::dense;
+            return;
+        }
+
+        coeffs.reserve(terms_.size());
+        powers.reserve(terms_.size());
+
+        for (auto [coeff, power] : terms_) {
+            coeffs.push_back(coeff);
+            powers.push_back(static_cast<std::int32_t>(power));
+        }
+
+        layout = PolyLayout::sparse;
+    }
+
+    void Polynomial::adoptDense(std::vector<double>& coeffs_) {
+        while (!coeffs_.empty() && coeffs_.back() == zero_coefficient) {
+            coeffs_.pop_back();
+        }
+
+        const auto term_count = static_cast<std::size_t>(std::count_if(coeffs_.begin(), coeffs_.end(), [](double coeff) {
+            return coeff != zero_coefficient;
+        }));
+
+        powers.clear();
+        terms.clear();
+
+        if (coeffs_.empty() || prefersDense(coeffs_.size() - 1, term_count)) {
+            coeffs = std::move(coeffs_);
+            layout = PolyLayout::dense;
+            return;
+        }
+
+        coeffs.clear();
+        coeffs.reserve(term_count);
+        powers.reserve(term_count);
+
+        for (std::size_t power = coeffs_.size(); power-- > 0;) {
+            if (coeffs_[power] != zero_coefficient) {
+                coeffs.push_back(coeffs_[power]);
+                powers.push_back(static_cast<std::int32_t>(power));
+            }
+        }
+
+        layout = PolyLayout::sparse;
+    }
 
     Polynomial::Polynomial()
-    : terms {0} {}
+    : coeffs {}, powers {}, terms {}, layout {PolyLayout::dense} {}
 
     Polynomial::Polynomial(std::vector<PolynomialTerm>& terms_)
-    : terms (terms_) {}
+    : coeffs {}, powers {}, terms {}, layout {PolyLayout::dense} {
+        std::vector<PolynomialTerm> temp {terms_};
+        adoptTerms(temp);
+    }
 
     Polynomial::Polynomial(std::vector<PolynomialTerm>&& x_terms_)
-    : terms (x_terms_) {}
+    : coeffs {}, powers {}, terms {}, layout {PolyLayout::dense} {
+        adoptTerms(x_terms_);
+    }
+
+    PolyLayout Polynomial::getLayout() const { return layout; }
+
+    std::size_t Polynomial::getTermCount() const {
+        switch (layout) {
+        case PolyLayout::dense:
+            return static_cast<std::size_t>(std::count_if(coeffs.begin(), coeffs.end(), [](double coeff) {
+                return coeff != zero_coefficient;
+            }));
+        case PolyLayout::sparse:
+            return coeffs.size();
+        case PolyLayout::general:
+        default:
+            return terms.size();
+        }
+    }
+
+    std::span<const double> Polynomial::getDenseCoeffs() const {
+        return (layout == PolyLayout::dense) ? std::span<const double> {coeffs} : std::span<const double> {};
+    }
+
+    std::span<const std::int32_t> Polynomial::getSparsePowers() const { return powers; }
+
+    std::span<const double> Polynomial::getSparseCoeffs() const {
+        return (layout == PolyLayout::sparse) ? std::span<const double> {coeffs} : std::span<const double> {};
+    }
+
+    std::vector<PolynomialTerm> Polynomial::getTerms() const {
+        std::vector<PolynomialTerm> result;
+
+        switch (layout) {
+        case PolyLayout::dense:
+            for (std::size_t power = coeffs.size(); power-- > 0;) {
+                if (coeffs[power] != zero_coefficient) {
+                    result.push_back({coeffs[power], static_cast<double>(power)});
+                }
+            }
+            break;
+        case PolyLayout::sparse:
+            result.reserve(coeffs.size());
+
+            for (std::size_t i = 0; i < coeffs.size(); i++) {
+                result.push_back({coeffs[i], static_cast<double>(powers[i])});
+            }
+            break;
+        case PolyLayout::general:
+            result = terms;
+            break;
+        }
+
+        if (result.empty()) {
+            result.push_back({zero_coefficient, zero_coefficient});
+        }
+
+        return result;
+    }
 
     FuncType Polynomial::getType() const { return FuncType::polynomial; }
 
     double Polynomial::evalAt(double x) const {
         double result = zero_coefficient;
 
-        for (auto [coeff, power] : terms) {
-            if (coeff == zero_coefficient) {
-                continue;
+        switch (layout) {
+        case PolyLayout::dense:
+            for (std::size_t power = coeffs.size(); power-- > 0;) {
+                result = result * x + coeffs[power];
+            }
+            break;
+        case PolyLayout::sparse:
+            if (coeffs.empty()) {
+                break;
             }
 
-            if (power != zero_coefficient) {
-                result += pow(x, power) * coeff;
-            } else {
-                result += coeff;
+            result = coeffs[0];
+
+            for (std::size_t i = 1; i < coeffs.size(); i++) {
+                result = result * raiseWhole(x, static_cast<std::uint32_t>(powers[i - 1] - powers[i])) + coeffs[i];
+            }
+
+            result = scaleByLowest(result, x, powers.back());
+            break;
+        case PolyLayout::general:
+            for (auto [coeff, power] : terms) {
+                if (power != zero_coefficient) {
+                    result += pow(x, power) * coeff;
+                } else {
+                    result += coeff;
+                }
             }
+            break;
         }
 
         return result;
     }
 
-    /// @note Uses power rule of differentiation.
-    FunctionAny Polynomial::makeDerivative() const {
-        std::vector<PolynomialTerm> new_terms;
+    double Polynomial::evalAtPoint(std::span<const double> point) const {
+        return evalAt(point[0]);
+    }
 
-        for (auto [coeff, power] : terms) {
-            if (coeff == zero_coefficient) {
-                continue;
-            }
+    double Polynomial::evalSlopeAt(double x) const {
+        double result = zero_coefficient;
 
-            if (power != zero_coefficient) {
-                new_terms.push_back( {coeff * power, power - 1.0});
-            } else {
-                new_terms.push_back({zero_coefficient, zero_coefficient});
+        switch (layout) {
+        case PolyLayout::dense:
+            for (std::size_t power = coeffs.size(); power-- > 1;) {
+                result = result * x + coeffs[power] * static_cast<double>(power);
             }
+            break;
+        case PolyLayout::sparse:
+            for (std::size_t i = 0; i < coeffs.size() && powers[i] > 0; i++) {
+                result += coeffs[i] * powers[i] * raiseWhole(x, static_cast<std::uint32_t>(powers[i] - 1));
+            }
+            break;
+        case PolyLayout::general:
+            for (auto [coeff, power] : terms) {
+                if (power != zero_coefficient) {
+                    result += pow(x, power - 1.0) * coeff * power;
+                }
+            }
+            break;
         }
 
-        return {Polynomial {new_terms}};
+        return result;
     }
 
-    std::string Polynomial::toText() const {
-        std::ostringstream sout;
+    /// @note Each layout loops over its terms outside and the x values inside, so the inner loops vectorize.
+    void Polynomial::evalBatch(std::span<const double> xs, std::span<double> out) const {
+        const std::size_t count = xs.size();
+
+        for (std::size_t i = 0; i < count; i++) {
+            out[i] = zero_coefficient;
+        }
+
+        if (layout == PolyLayout::dense) {
+            for (std::size_t power = coeffs.size(); power-- > 0;) {
+                const double coeff = coeffs[power];
+
+                for (std::size_t i = 0; i < count; i++) {
+                    out[i] = out[i] * xs[i] + coeff;
+                }
+            }
+
+            return;
+        }
+
+        if (layout == PolyLayout::sparse) {
+            if (coeffs.empty()) {
+                return;
+            }
+
+            for (std::size_t i = 0; i < count; i++) {
+                out[i] = coeffs[0];
+            }
+
+            for (std::size_t t = 1; t < coeffs.size(); t++) {
+                const auto gap = static_cast<std::uint32_t>(powers[t - 1] - powers[t]);
+                const double coeff = coeffs[t];
+
+                for (std::size_t i = 0; i < count; i++) {
+                    out[i] = out[i] * raiseWhole(xs[i], gap) + coeff;
+                }
+            }
+
+            for (std::size_t i = 0; i < count; i++) {
+                out[i] = scaleByLowest(out[i], xs[i], powers.back());
+            }
+
+            return;
+        }
 
         for (auto [coeff, power] : terms) {
-            if (coeff < zero_coefficient) {
-                sout << '+' << coeff << "x^" << power;
+            if (power == zero_coefficient) {
+                for (std::size_t i = 0; i < count; i++) {
+                    out[i] += coeff;
+                }
+            } else if (power > zero_coefficient && power == std::floor(power) && power <= max_squaring_power) {
+                const auto whole_power = static_cast<std::uint32_t>(power);
+
+                for (std::size_t i = 0; i < count; i++) {
+                    out[i] += raiseWhole(xs[i], whole_power) * coeff;
+                }
             } else {
-                sout << '-' << -coeff << "x^" << power;
+                for (std::size_t i = 0; i < count; i++) {
+                    out[i] += pow(xs[i], power) * coeff;
+                }
+            }
+        }
+    }
+
+    /// @note Uses power rule of differentiation, in the layout's own form.
+    FunctionAny Polynomial::makeDerivative() const {
+        if (layout == PolyLayout::dense) {
+            std::vector<double> new_coeffs;
+
+            if (coeffs.size() > 1) {
+                new_coeffs.resize(coeffs.size() - 1);
+
+                for (std::size_t power = 1; power < coeffs.size(); power++) {
+                    new_coeffs[power - 1] = coeffs[power] * static_cast<double>(power);
+                }
+            }
+
+            return {Polynomial::fromDense(std::move(new_coeffs))};
+        }
+
+        std::vector<PolynomialTerm> new_terms;
+
+        for (auto [coeff, power] : getTerms()) {
+            if (power != zero_coefficient) {
+                new_terms.push_back({coeff * power, power - 1.0});
             }
         }
 
-        return sout.str();
+        return {Polynomial {std::move(new_terms)}};
+    }
+
+    std::string Polynomial::toText() const {
+        return writeText(*this);
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,131 @@
+/**
+ * @file RationalFunction.cpp
+ * @author DrkWithT
+ * @brief Implements polynomial quotients in lowest terms.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <array>
+#include <utility>
+#include "Models/RationalFunction.hpp"
+#include "Models/PolyAlgebra.hpp"
+#include "Models/TextWriter.hpp"
+
+namespace GeneralDeriver::Models {
+    static constexpr std::size_t batch_chunk_size = 64;
+
+    std::optional<RationalFunction> RationalFunction::fromQuotient(const Polynomial& numerator_, const Polynomial& denominator_) {
+        if (!getDenseDegree(numerator_) || !getDenseDegree(denominator_) || getConstantValue(denominator_) == 0.0) {
+            return {};
+        }
+
+        Polynomial reduced_numerator = numerator_;
+        Polynomial reduced_denominator = denominator_;
+
+        if (auto common = gcdPolynomials(numerator_, denominator_); common && !getConstantValue(*common)) {
+            auto numerator_part = divideExactly(numerator_, *common);
+            auto denominator_part = divideExactly(denominator_, *common);
+
+            if (numerator_part && denominator_part) {
+                reduced_numerator = std::move(*numerator_part);
+                reduced_denominator = std::move(*denominator_part);
+            }
+        }
+
+        const double leading = reduced_denominator.getTerms().front().coeff;
+
+        if (leading != 1.0) {
+            reduced_numerator = dividePolynomial(reduced_numerator, leading);
+            reduced_denominator = dividePolynomial(reduced_denominator, leading);
+        }
+
+        return RationalFunction {reduced_numerator, reduced_denominator};
+    }
+
+    RationalFunction::RationalFunction()
+    : numerator {}, denominator {Polynomial::fromDense({1.0})} {}
+
+    RationalFunction::RationalFunction(const Polynomial& numerator_, const Polynomial& denominator_)
+    : numerator {numerator_}, denominator {denominator_} {}
+
+    const Polynomial& RationalFunction::getNumerator() const { return numerator; }
+
+    const Polynomial& RationalFunction::getDenominator() const { return denominator; }
+
+    bool RationalFunction::isPolynomial() const {
+        return getConstantValue(denominator) == 1.0;
+    }
+
+    FuncType RationalFunction::getType() const { return FuncType::rational_function; }
+
+    double RationalFunction::evalAt(double x) const {
+        return numerator.evalAt(x) / denominator.evalAt(x);
+    }
+
+    double RationalFunction::evalAtPoint(std::span<const double> point) const {
+        return evalAt(point[0]);
+    }
+
+    void RationalFunction::evalBatch(std::span<const double> xs, std::span<double> out) const {
+        const std::size_t count = xs.size();
+        std::array<double, batch_chunk_size> denominator_buffer;
+
+        numerator.evalBatch(xs, out);
+
+        for (std::size_t chunk_begin = 0; chunk_begin < count; chunk_begin += batch_chunk_size) {
+            const std::size_t chunk_len = std::min(batch_chunk_size, count - chunk_begin);
+            std::span<double> denominator_vals {denominator_buffer.data(), chunk_len};
+
+            denominator.evalBatch(xs.subspan(chunk_begin, chunk_len), denominator_vals);
+
+            for (std::size_t i = 0; i < chunk_len; i++) {
+                out[chunk_begin + i] /= denominator_vals[i];
+            }
+        }
+    }
+
+    FunctionAny RationalFunction::makeDerivative() const {
+        const Polynomial numerator_derived = derivePolynomial(numerator);
+
+        if (isPolynomial()) {
+            return numerator_derived;
+        }
+
+        const Polynomial denominator_derived = derivePolynomial(denominator);
+
+        // With no usable GCD, g = 1 leaves the plain quotient rule (N'D - ND') / D^2.
+        Polynomial free_part = denominator;
+        Polynomial slope_part = denominator_derived;
+
+        if (auto common = gcdPolynomials(denominator, denominator_derived); common && !getConstantValue(*common)) {
+            auto denominator_part = divideExactly(denominator, *common);
+            auto slope_quotient = divideExactly(denominator_derived, *common);
+
+            if (denominator_part && slope_quotient) {
+                free_part = std::move(*denominator_part);
+                slope_part = std::move(*slope_quotient);
+            }
+        }
+
+        Polynomial result_numerator = subtractPolynomials(multiplyPolynomials(numerator_derived, free_part), multiplyPolynomials(numerator, slope_part));
+        Polynomial result_denominator = multiplyPolynomials(denominator, free_part);
+        auto result = fromQuotient(result_numerator, result_denominator);
+
+        // Products past the dense degree limit cannot be reduced, but the quotient is still right.
+        if (!result) {
+            return RationalFunction {result_numerator, result_denominator};
+        } else if (result->isPolynomial()) {
+            return result->getNumerator();
+        }
+
+        return std::move(*result);
+    }
+
+    std::string RationalFunction::toText() const {
+        return writeText(*this);
+    }
+}
@@ -0,0 +1,360 @@
+/**
+ * @file Tape.cpp
+ * @author DrkWithT
+ * @brief Implements flat function tape and its reverse-mode gradient evaluator.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <stdexcept>
+#include <unordered_map>
+#include "Models/Tape.hpp"
+#include "Models/Composite.hpp"
+#include "Models/Constant.hpp"
+#include "Models/IntPower.hpp"
+#include "Models/LazyDerivative.hpp"
+#include "Models/RationalFunction.hpp"
+#include "Models/Variable.hpp"
+
+namespace GeneralDeriver::Models {
+    static constexpr std::size_t x_slot = 0;
+
+    static TapeOp getTapeOp(Syntax::AstOpType op) {
+        switch (op) {
+        case Syntax::AstOpType::add:
+            return TapeOp::add;
+        case Syntax::AstOpType::sub:
+            return TapeOp::sub;
+        case Syntax::AstOpType::mul:
+            return TapeOp::mul;
+        case Syntax::AstOpType::div:
+            return TapeOp::div;
+        case Syntax::AstOpType::power:
+            return TapeOp::power;
+        case Syntax::AstOpType::neg:
+            return TapeOp::neg;
+        case Syntax::AstOpType::sin:
+            return TapeOp::sin;
+        case Syntax::AstOpType::cos:
+            return TapeOp::cos;
+        case Syntax::AstOpType::exp:
+            return TapeOp::exp;
+        case Syntax::AstOpType::ln:
+            return TapeOp::ln;
+        case Syntax::AstOpType::sqrt:
+            return TapeOp::sqrt;
+        default:
+            throw std::invalid_argument {"Tape: unsupported Composite op"};
+        }
+    }
+
+    /// @brief Post-order flattening with one node per distinct function object.
+    class TapeBuilder {
+    private:
+        std::vector<TapeNode>& nodes;
+        std::vector<PolynomialTerm>& terms;
+        std::unordered_map<const IFunction*, std::uint32_t> visited;
+        std::size_t slot_count;
+
+        std::uint32_t pushNode(const TapeNode& node) {
+            nodes.push_back(node);
+
+            return static_cast<std::uint32_t>(nodes.size() - 1);
+        }
+
+        std::uint32_t flattenComposite(const Composite& fn) {
+            switch (fn.getArity()) {
+            case CompositeArity::invalid:
+                return pushNode({0.0, 0, 0, TapeOp::constant});
+            case CompositeArity::unary: {
+                auto inner = flatten(*fn.getLeft().getStoragePtr());
+
+                if (fn.getOp() == Syntax::AstOpType::none) {
+                    return inner;
+                }
+
+                return pushNode({0.0, inner, 0, getTapeOp(fn.getOp())});
+            }
+            case CompositeArity::binary:
+            default: {
+                auto lhs = flatten(*fn.getLeft().getStoragePtr());
+
+                if (fn.getOp() == Syntax::AstOpType::none) {
+                    return lhs;
+                }
+
+                auto rhs = flatten(*fn.getRight().getStoragePtr());
+
+                return pushNode({0.0, lhs, rhs, getTapeOp(fn.getOp())});
+            }
+            }
+        }
+
+        /// @note Polynomials of only constant terms, like emitted number leaves, become one constant node.
+        std::uint32_t flattenPolynomial(const Polynomial& fn) {
+            const auto& poly_terms = fn.getTerms();
+
+            if (std::all_of(poly_terms.begin(), poly_terms.end(), [](PolynomialTerm term) { return term.power == 0.0; })) {
+                double sum = 0.0;
+
+                for (auto term : poly_terms) {
+                    sum += term.coeff;
+                }
+
+                return pushNode({sum, 0, 0, TapeOp::constant});
+            }
+
+            const auto term_begin = static_cast<std::uint32_t>(terms.size());
+
+            std::copy_if(poly_terms.begin(), poly_terms.end(), std::back_inserter(terms), [](PolynomialTerm term) {
+                return term.coeff != 0.0;
+            });
+
+            return pushNode({0.0, term_begin, static_cast<std::uint32_t>(terms.size()) - term_begin, TapeOp::polynomial});
+        }
+
+    public:
+        TapeBuilder(std::vector<TapeNode>& nodes_, std::vector<PolynomialTerm>& terms_)
+        : nodes {nodes_}, terms {terms_}, visited {}, slot_count {1} {}
+
+        std::uint32_t flatten(const IFunction& fn) {
+            if (auto visited_it = visited.find(&fn); visited_it != visited.end()) {
+                return visited_it->second;
+            }
+
+            std::uint32_t result;
+
+            if (const auto* composite = dynamic_cast<const Composite*>(&fn); composite != nullptr) {
+                result = flattenComposite(*composite);
+            } else if (const auto* polynomial = dynamic_cast<const Polynomial*>(&fn); polynomial != nullptr) {
+                result = flattenPolynomial(*polynomial);
+            } else if (const auto* variable = dynamic_cast<const Variable*>(&fn); variable != nullptr) {
+                slot_count = std::max(slot_count, variable->getSlot() + 1);
+                result = pushNode({0.0, static_cast<std::uint32_t>(variable->getSlot()), 0, TapeOp::variable});
+            } else if (fn.getType() == FuncType::constant) {
+                result = pushNode({static_cast<const Constant&>(fn).getValue(), 0, 0, TapeOp::constant});
+            } else if (fn.getType() == FuncType::identity) {
+                result = pushNode({0.0, static_cast<std::uint32_t>(x_slot), 0, TapeOp::variable});
+            } else if (fn.getType() == FuncType::int_power) {
+                const auto& power = static_cast<const IntPower&>(fn);
+                auto base = flatten(*power.getBase().getStoragePtr());
+                result = pushNode({static_cast<double>(power.getExponent()), base, 0, TapeOp::int_power});
+            } else if (fn.getType() == FuncType::lazy_derivative) {
+                // Compiling reaches every node, so a lazy derivative materializes all of its levels here.
+                const auto* derived_ptr = static_cast<const LazyDerivative&>(fn).getDerived().getStoragePtr();
+
+                if (derived_ptr == nullptr) {
+                    throw std::invalid_argument {"Tape: derivative without a rule"};
+                }
+
+                result = flatten(*derived_ptr);
+            } else if (fn.getType() == FuncType::rational_function) {
+                const auto& quotient = static_cast<const RationalFunction&>(fn);
+                auto numerator = flattenPolynomial(quotient.getNumerator());
+                auto denominator = flattenPolynomial(quotient.getDenominator());
+                result = pushNode({0.0, numerator, denominator, TapeOp::div});
+            } else {
+                throw std::invalid_argument {"Tape: unsupported function kind"};
+            }
+
+            visited[&fn] = result;
+
+            return result;
+        }
+
+        [[nodiscard]] std::size_t getSlotCount() const { return slot_count; }
+    };
+
+    Tape::Tape()
+    : nodes {}, terms {}, slot_count {1} {}
+
+    Tape::Tape(const IFunction& root)
+    : nodes {}, terms {}, slot_count {1} {
+        TapeBuilder builder {nodes, terms};
+
+        builder.flatten(root);
+        slot_count = builder.getSlotCount();
+    }
+
+    const std::vector<TapeNode>& Tape::getNodes() const { return nodes; }
+
+    const std::vector<PolynomialTerm>& Tape::getTerms() const { return terms; }
+
+    std::size_t Tape::getSlotCount() const { return slot_count; }
+
+
+    AdjointEvaluator::AdjointEvaluator(const Tape& tape_)
+    : tape {&tape_}, values(tape_.getNodes().size()), adjoints(tape_.getNodes().size()) {}
+
+    void AdjointEvaluator::sweepForward(std::span<const double> point) {
+        const auto& nodes = tape->getNodes();
+        const auto& terms = tape->getTerms();
+        const std::size_t count = nodes.size();
+
+        for (std::size_t i = 0; i < count; i++) {
+            const TapeNode& node = nodes[i];
+
+            switch (node.op) {
+            case TapeOp::constant:
+                values[i] = node.value;
+                break;
+            case TapeOp::variable:
+                values[i] = point[node.lhs];
+                break;
+            case TapeOp::polynomial: {
+                double result = 0.0;
+
+                for (std::uint32_t t = node.lhs; t < node.lhs + node.rhs; t++) {
+                    result += (terms[t].power != 0.0) ? std::pow(point[x_slot], terms[t].power) * terms[t].coeff : terms[t].coeff;
+                }
+
+                values[i] = result;
+                break;
+            }
+            case TapeOp::add:
+                values[i] = values[node.lhs] + values[node.rhs];
+                break;
+            case TapeOp::sub:
+                values[i] = values[node.lhs] - values[node.rhs];
+                break;
+            case TapeOp::mul:
+                values[i] = values[node.lhs] * values[node.rhs];
+                break;
+            case TapeOp::div:
+                values[i] = values[node.lhs] / values[node.rhs];
+                break;
+            case TapeOp::power:
+                values[i] = std::pow(values[node.lhs], values[node.rhs]);
+                break;
+            case TapeOp::int_power:
+                values[i] = raiseToInteger(values[node.lhs], static_cast<std::int32_t>(node.value));
+                break;
+            case TapeOp::neg:
+                values[i] = -values[node.lhs];
+                break;
+            case TapeOp::sin:
+                values[i] = std::sin(values[node.lhs]);
+                break;
+            case TapeOp::cos:
+                values[i] = std::cos(values[node.lhs]);
+                break;
+            case TapeOp::exp:
+                values[i] = std::exp(values[node.lhs]);
+                break;
+            case TapeOp::ln:
+                values[i] = std::log(values[node.lhs]);
+                break;
+            case TapeOp::sqrt:
+                values[i] = std::sqrt(values[node.lhs]);
+                break;
+            }
+        }
+    }
+
+    double AdjointEvaluator::evalAt(std::span<const double> point) {
+        if (values.empty()) {
+            return 0.0;
+        }
+
+        sweepForward(point);
+
+        return values.back();
+    }
+
+    double AdjointEvaluator::gradientAt(std::span<const double> point, std::span<double> gradient) {
+        std::fill(gradient.begin(), gradient.begin() + tape->getSlotCount(), 0.0);
+
+        if (values.empty()) {
+            return 0.0;
+        }
+
+        sweepForward(point);
+
+        const auto& nodes = tape->getNodes();
+        const auto& terms = tape->getTerms();
+
+        std::fill(adjoints.begin(), adjoints.end(), 0.0);
+        adjoints.back() = 1.0;
+
+        for (std::size_t i = nodes.size(); i-- > 0;) {
+            const TapeNode& node = nodes[i];
+            const double adjoint = adjoints[i];
+
+            if (adjoint == 0.0) {
+                continue;
+            }
+
+            switch (node.op) {
+            case TapeOp::constant:
+                break;
+            case TapeOp::variable:
+                gradient[node.lhs] += adjoint;
+                break;
+            case TapeOp::polynomial: {
+                double slope = 0.0;
+
+                for (std::uint32_t t = node.lhs; t < node.lhs + node.rhs; t++) {
+                    if (terms[t].power != 0.0) {
+                        slope += terms[t].coeff * terms[t].power * std::pow(point[x_slot], terms[t].power - 1.0);
+                    }
+                }
+
+                gradient[x_slot] += adjoint * slope;
+                break;
+            }
+            case TapeOp::add:
+                adjoints[node.lhs] += adjoint;
+                adjoints[node.rhs] += adjoint;
+                break;
+            case TapeOp::sub:
+                adjoints[node.lhs] += adjoint;
+                adjoints[node.rhs] -= adjoint;
+                break;
+            case TapeOp::mul:
+                adjoints[node.lhs] += adjoint * values[node.rhs];
+                adjoints[node.rhs] += adjoint * values[node.lhs];
+                break;
+            case TapeOp::div:
+                adjoints[node.lhs] += adjoint / values[node.rhs];
+                adjoints[node.rhs] -= adjoint * values[i] / values[node.rhs];
+                break;
+            case TapeOp::power:
+                adjoints[node.lhs] += adjoint * values[node.rhs] * std::pow(values[node.lhs], values[node.rhs] - 1.0);
+
+                // d(u^v)/dv = u^v ln u only exists for u > 0, and constant exponents never need it.
+                if (values[node.lhs] > 0.0) {
+                    adjoints[node.rhs] += adjoint * values[i] * std::log(values[node.lhs]);
+                }
+                break;
+            case TapeOp::int_power:
+                adjoints[node.lhs] += adjoint * node.value * raiseToInteger(values[node.lhs], static_cast<std::int32_t>(node.value) - 1);
+                break;
+            case TapeOp::neg:
+                adjoints[node.lhs] -= adjoint;
+                break;
+            case TapeOp::sin:
+                adjoints[node.lhs] += adjoint * std::cos(values[node.lhs]);
+                break;
+            case TapeOp::cos:
+                adjoints[node.lhs] -= adjoint * std::sin(values[node.lhs]);
+                break;
+            case TapeOp::exp:
+                adjoints[node.lhs] += adjoint * values[i];
+                break;
+            case TapeOp::ln:
+                adjoints[node.lhs] += adjoint / values[node.lhs];
+                break;
+            case TapeOp::sqrt:
+                adjoints[node.lhs] += adjoint * 0.5 / values[i];
+                break;
+            }
+        }
+
+        return values.back();
+    }
+}
@@ -0,0 +1,430 @@
+/**
+ * @file TextWriter.cpp
+ * @author DrkWithT
+ * @brief Implements DAG-aware function to text serializer with let bindings for shared sub-functions.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Models/TextWriter.hpp"
+#include "Models/Composite.hpp"
+#include "Models/Constant.hpp"
+#include "Models/IntPower.hpp"
+#include "Models/LazyDerivative.hpp"
+#include "Models/Polynomial.hpp"
+#include "Models/RationalFunction.hpp"
+#include "Models/Variable.hpp"
+
+namespace GeneralDeriver::Models {
+    /* Precedence levels, loosest first */
+
+    static constexpr int sum_level = 1;
+    static constexpr int product_level = 2;
+    static constexpr int negation_level = 3;
+    static constexpr int power_level = 4;
+    static constexpr int atom_level = 5;
+
+    /* Upper bounds of written chars, for reserving the buffer */
+
+    static constexpr std::size_t max_number_chars = 24; // shortest round-trip double, e.g -2.2250738585072014e-308
+    static constexpr std::size_t max_name_chars = 11;   // 't' + a 32-bit binding id
+    static constexpr std::size_t max_node_chars = 16;   // operator or call syntax plus one pair of parentheses
+    static constexpr std::size_t max_binding_chars = 8; // "let " " = " ";\n" around the name
+    static constexpr std::size_t max_term_chars = 2 * max_number_chars + 8;
+
+    static constexpr std::string_view undefined_text = "undefined";
+
+    static std::string_view getCallName(Syntax::AstOpType op) {
+        switch (op) {
+        case Syntax::AstOpType::sin:
+            return "sin";
+        case Syntax::AstOpType::cos:
+            return "cos";
+        case Syntax::AstOpType::exp:
+            return "exp";
+        case Syntax::AstOpType::ln:
+            return "ln";
+        case Syntax::AstOpType::sqrt:
+        default:
+            return "sqrt";
+        }
+    }
+
+    static std::string_view getInfixText(Syntax::AstOpType op) {
+        switch (op) {
+        case Syntax::AstOpType::add:
+            return " + ";
+        case Syntax::AstOpType::sub:
+            return " - ";
+        case Syntax::AstOpType::mul:
+            return " * ";
+        case Syntax::AstOpType::div:
+            return " / ";
+        case Syntax::AstOpType::power:
+        default:
+            return "^";
+        }
+    }
+
+    static int getInfixLevel(Syntax::AstOpType op) {
+        switch (op) {
+        case Syntax::AstOpType::add:
+        case Syntax::AstOpType::sub:
+            return sum_level;
+        case Syntax::AstOpType::mul:
+        case Syntax::AstOpType::div:
+            return product_level;
+        case Syntax::AstOpType::power:
+        default:
+            return power_level;
+        }
+    }
+
+    static int getPolynomialLevel(const std::vector<PolynomialTerm>& terms) {
+        std::size_t written_count = 0;
+        PolynomialTerm only_term {0.0, 0.0};
+
+        for (auto term : terms) {
+            if (term.coeff != 0.0) {
+                written_count++;
+                only_term = term;
+            }
+        }
+
+        if (written_count > 1) {
+            return sum_level;
+        } else if (written_count == 0) {
+            return atom_level;
+        } else if (only_term.coeff < 0.0) {
+            return negation_level;
+        } else if (only_term.power == 0.0 || (only_term.coeff == 1.0 && only_term.power == 1.0)) {
+            return atom_level;
+        }
+
+        return (only_term.coeff != 1.0) ? product_level : power_level;
+    }
+
+    /// @brief Plans bindings by counting handles per distinct node, then writes bindings & the root in one post-order pass.
+    class TextWriter {
+    private:
+        struct NodeInfo {
+            std::uint32_t refs;
+            std::int64_t binding; // -1 until a let line names it
+        };
+
+        std::unordered_map<const IFunction*, NodeInfo> infos;
+        std::vector<const IFunction*> post_order; // distinct non-leaf nodes, operands first
+        std::string out;
+        std::size_t length_bound;
+
+        /// @note Unwraps what has no text of its own: `none` wrappers and lazy derivatives, which write as their expansion.
+        [[nodiscard]] static const IFunction* resolveNode(const IFunction* fn) {
+            while (fn != nullptr) {
+                if (fn->getType() == FuncType::lazy_derivative) {
+                    fn = static_cast<const LazyDerivative*>(fn)->getDerived().getStoragePtr();
+                } else if (const auto* composite = dynamic_cast<const Composite*>(fn); composite != nullptr && composite->getArity() != CompositeArity::invalid && composite->getOp() == Syntax::AstOpType::none) {
+                    fn = composite->getLeft().getStoragePtr();
+                } else {
+                    break;
+                }
+            }
+
+            return fn;
+        }
+
+        [[nodiscard]] static bool isLeaf(const IFunction* fn) {
+            return fn == nullptr || fn->getType() == FuncType::constant || fn->getType() == FuncType::identity || fn->getType() == FuncType::variable;
+        }
+
+        [[nodiscard]] static std::size_t getOwnLengthBound(const IFunction* fn) {
+            if (fn == nullptr) {
+                return undefined_text.size();
+            } else if (fn->getType() == FuncType::variable) {
+                return static_cast<const Variable*>(fn)->getName().size();
+            } else if (fn->getType() == FuncType::rational_function) {
+                const auto* quotient = static_cast<const RationalFunction*>(fn);
+
+                return max_node_chars * 3 + max_term_chars * (quotient->getNumerator().getTerms().size() + quotient->getDenominator().getTerms().size());
+            } else if (const auto* polynomial = dynamic_cast<const Polynomial*>(fn); polynomial != nullptr) {
+                return max_node_chars + max_term_chars * polynomial->getTerms().size();
+            }
+
+            return max_node_chars + max_number_chars;
+        }
+
+        void countRefs(const IFunction* fn) {
+            fn = resolveNode(fn);
+
+            // Each handle costs at most one binding name, or the whole leaf when written inline.
+            length_bound += isLeaf(fn) ? getOwnLengthBound(fn) + 2 : max_name_chars + 2;
+
+            if (isLeaf(fn)) {
+                return;
+            }
+
+            auto [info_it, inserted] = infos.try_emplace(fn, NodeInfo {0, -1});
+            info_it->second.refs++;
+
+            if (!inserted) {
+                return;
+            }
+
+            length_bound += getOwnLengthBound(fn) + max_binding_chars + max_name_chars;
+
+            if (const auto* composite = dynamic_cast<const Composite*>(fn); composite != nullptr) {
+                if (composite->getArity() != CompositeArity::invalid) {
+                    countRefs(composite->getLeft().getStoragePtr());
+                }
+
+                if (composite->getArity() == CompositeArity::binary) {
+                    countRefs(composite->getRight().getStoragePtr());
+                }
+            } else if (fn->getType() == FuncType::int_power) {
+                countRefs(static_cast<const IntPower*>(fn)->getBase().getStoragePtr());
+            }
+
+            post_order.push_back(fn);
+        }
+
+        void writeNumber(double value) {
+            std::array<char, max_number_chars + 8> digits;
+            const auto [digits_end, errc] = std::to_chars(digits.data(), digits.data() + digits.size(), value);
+
+            out.append(digits.data(), (errc == std::errc {}) ? digits_end : digits.data());
+        }
+
+        void writePolynomial(const std::vector<PolynomialTerm>& terms) {
+            bool first = true;
+
+            for (auto [coeff, power] : terms) {
+                if (coeff == 0.0) {
+                    continue;
+                }
+
+                if (first) {
+                    out.append((coeff < 0.0) ? "-" : "");
+                } else {
+                    out.append((coeff < 0.0) ? " - " : " + ");
+                }
+
+                first = false;
+
+                const double magnitude = std::abs(coeff);
+
+                if (power == 0.0) {
+                    writeNumber(magnitude);
+                    continue;
+                }
+
+                if (magnitude != 1.0) {
+                    writeNumber(magnitude);
+                    out.push_back('*');
+                }
+
+                out.push_back('x');
+
+                if (power != 1.0) {
+                    out.push_back('^');
+                    out.append((power < 0.0) ? "(" : "");
+                    writeNumber(power);
+                    out.append((power < 0.0) ? ")" : "");
+                }
+            }
+
+            if (first) {
+                out.push_back('0');
+            }
+        }
+
+        [[nodiscard]] int getLevel(const IFunction* fn) const {
+            if (fn == nullptr) {
+                return atom_level;
+            }
+
+            if (auto info_it = infos.find(fn); info_it != infos.end() && info_it->second.binding >= 0) {
+                return atom_level;
+            }
+
+            switch (fn->getType()) {
+            case FuncType::constant:
+                return std::signbit(static_cast<const Constant*>(fn)->getValue()) ? negation_level : atom_level;
+            case FuncType::identity:
+            case FuncType::variable:
+                return atom_level;
+            case FuncType::int_power:
+                return power_level;
+            case FuncType::rational_function:
+                return product_level;
+            default:
+                break;
+            }
+
+            if (const auto* composite = dynamic_cast<const Composite*>(fn); composite != nullptr) {
+                if (composite->getArity() == CompositeArity::binary) {
+                    return getInfixLevel(composite->getOp());
+                }
+
+                return (composite->getOp() == Syntax::AstOpType::neg) ? negation_level : atom_level;
+            } else if (const auto* polynomial = dynamic_cast<const Polynomial*>(fn); polynomial != nullptr) {
+                return getPolynomialLevel(polynomial->getTerms());
+            }
+
+            return atom_level;
+        }
+
+        /// @note Writes `fn` in parentheses when it binds looser than `min_level`.
+        void writeOperand(const IFunction* fn, int min_level) {
+            fn = resolveNode(fn);
+
+            const bool wrap = getLevel(fn) < min_level;
+
+            out.append(wrap ? "(" : "");
+            writeNode(fn);
+            out.append(wrap ? ")" : "");
+        }
+
+        void writeNode(const IFunction* fn) {
+            if (fn == nullptr) {
+                out.append(undefined_text);
+                return;
+            }
+
+            if (auto info_it = infos.find(fn); info_it != infos.end() && info_it->second.binding >= 0) {
+                out.push_back('t');
+                out.append(std::to_string(info_it->second.binding));
+                return;
+            }
+
+            writeDefinition(fn);
+        }
+
+        /// @brief Writes the node's own expression, even when a binding names it.
+        void writeDefinition(const IFunction* fn) {
+            switch (fn->getType()) {
+            case FuncType::constant:
+                writeNumber(static_cast<const Constant*>(fn)->getValue());
+                return;
+            case FuncType::identity:
+                out.push_back('x');
+                return;
+            case FuncType::variable:
+                out.append(static_cast<const Variable*>(fn)->getName());
+                return;
+            case FuncType::int_power: {
+                const auto* power = static_cast<const IntPower*>(fn);
+                writeOperand(power->getBase().getStoragePtr(), power_level + 1);
+                out.push_back('^');
+                out.append((power->getExponent() < 0) ? "(" : "");
+                out.append(std::to_string(power->getExponent()));
+                out.append((power->getExponent() < 0) ? ")" : "");
+                return;
+            }
+            case FuncType::rational_function: {
+                const auto* quotient = static_cast<const RationalFunction*>(fn);
+                const auto numerator_terms = quotient->getNumerator().getTerms();
+                const auto denominator_terms = quotient->getDenominator().getTerms();
+                const bool wrap_numerator = getPolynomialLevel(numerator_terms) < product_level;
+                const bool wrap_denominator = getPolynomialLevel(denominator_terms) <= product_level;
+
+                out.append(wrap_numerator ? "(" : "");
+                writePolynomial(numerator_terms);
+                out.append(wrap_numerator ? ") / " : " / ");
+                out.append(wrap_denominator ? "(" : "");
+                writePolynomial(denominator_terms);
+                out.append(wrap_denominator ? ")" : "");
+                return;
+            }
+            default:
+                break;
+            }
+
+            if (const auto* composite = dynamic_cast<const Composite*>(fn); composite != nullptr) {
+                writeComposite(*composite);
+            } else if (const auto* polynomial = dynamic_cast<const Polynomial*>(fn); polynomial != nullptr) {
+                writePolynomial(polynomial->getTerms());
+            } else {
+                // Kinds without infix syntax e.g dual-number derivatives write their own text.
+                out.append(fn->toText());
+            }
+        }
+
+        void writeComposite(const Composite& fn) {
+            const auto op = fn.getOp();
+
+            switch (fn.getArity()) {
+            case CompositeArity::invalid:
+                // Same reading as `Tape`, which flattens an empty Composite to the constant 0.
+                out.push_back('0');
+                return;
+            case CompositeArity::unary:
+                if (op == Syntax::AstOpType::neg) {
+                    out.push_back('-');
+                    writeOperand(fn.getLeft().getStoragePtr(), negation_level + 1);
+                } else {
+                    out.append(getCallName(op));
+                    out.push_back('(');
+                    writeOperand(fn.getLeft().getStoragePtr(), sum_level);
+                    out.push_back(')');
+                }
+                return;
+            case CompositeArity::binary:
+            default: {
+                const int level = getInfixLevel(op);
+
+                // Sums & products chain to the left, while `^` groups to the right.
+                writeOperand(fn.getLeft().getStoragePtr(), (op == Syntax::AstOpType::power) ? level + 1 : level);
+                out.append(getInfixText(op));
+                writeOperand(fn.getRight().getStoragePtr(), (op == Syntax::AstOpType::power || op == Syntax::AstOpType::sub || op == Syntax::AstOpType::div) ? level + (op != Syntax::AstOpType::power) : level);
+                return;
+            }
+            }
+        }
+
+    public:
+        TextWriter()
+        : infos {}, post_order {}, out {}, length_bound {0} {}
+
+        [[nodiscard]] std::string write(const IFunction& root) {
+            const IFunction* root_node = resolveNode(&root);
+
+            countRefs(root_node);
+            out.reserve(length_bound);
+
+            std::int64_t next_binding = 0;
+
+            for (const IFunction* fn : post_order) {
+                auto& info = infos.at(fn);
+
+                if (info.refs < 2) {
+                    continue;
+                }
+
+                out.append("let t");
+                out.append(std::to_string(next_binding));
+                out.append(" = ");
+                writeDefinition(fn);
+                out.append(";\n");
+                info.binding = next_binding++;
+            }
+
+            writeOperand(root_node, sum_level);
+
+            return std::move(out);
+        }
+    };
+
+    std::string writeText(const IFunction& root) {
+        TextWriter writer;
+
+        return writer.write(root);
+    }
+}
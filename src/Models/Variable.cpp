@@ -0,0 +1,55 @@
+/**
+ * @file Variable.cpp
+ * @author DrkWithT
+ * @brief Implements named variable leaf function.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <limits>
+#include "Models/Variable.hpp"
+#include "Models/Constant.hpp"
+
+namespace GeneralDeriver::Models {
+    static constexpr std::size_t x_slot = 0;
+    static constexpr double unbound_value = std::numeric_limits<double>::quiet_NaN();
+
+    Variable::Variable()
+    : name {"x"}, slot {x_slot} {}
+
+    Variable::Variable(const std::string& name_, std::size_t slot_)
+    : name {name_}, slot {slot_} {}
+
+    const std::string& Variable::getName() const { return name; }
+
+    std::size_t Variable::getSlot() const { return slot; }
+
+    FuncType Variable::getType() const { return FuncType::variable; }
+
+    double Variable::evalAt(double x) const {
+        return (slot == x_slot) ? x : unbound_value;
+    }
+
+    double Variable::evalAtPoint(std::span<const double> point) const {
+        return point[slot];
+    }
+
+    void Variable::evalBatch(std::span<const double> xs, std::span<double> out) const {
+        if (slot == x_slot) {
+            std::copy(xs.begin(), xs.end(), out.begin());
+        } else {
+            std::fill(out.begin(), out.begin() + xs.size(), unbound_value);
+        }
+    }
+
+    FunctionAny Variable::makeDerivative() const {
+        const double slope = (slot == x_slot) ? 1.0 : 0.0;
+
+        return {Constant {slope}};
+    }
+
+    std::string Variable::toText() const { return name; }
+}
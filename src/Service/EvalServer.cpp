@@ -0,0 +1,455 @@
+/**
+ * @file EvalServer.cpp
+ * @author DrkWithT
+ * @brief Implements the Unix socket evaluation service: epoll loop, formula cache & batched evaluation.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <format>
+#include <limits>
+#include <utility>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "Service/EvalServer.hpp"
+#include "Frontend/Parser.hpp"
+#include "Backend/AstValidator.hpp"
+#include "Backend/FuncEmitter.hpp"
+
+namespace GeneralDeriver::Service {
+    static constexpr std::size_t max_events = 64;
+    static constexpr std::size_t read_chunk_size = 4096;
+    static constexpr std::size_t max_request_bytes = 64 * 1024;
+    static constexpr std::size_t max_cached_formulas = 4096;
+    static constexpr std::size_t latency_window = 1 << 16;
+    static constexpr std::string_view eval_prefix = "eval ";
+    static constexpr std::uint32_t read_interest = EPOLLIN | EPOLLRDHUP;
+
+    static std::string_view trimSpaces(std::string_view text) {
+        const auto first = text.find_first_not_of(" \t\r");
+
+        if (first == std::string_view::npos) {
+            return {};
+        }
+
+        return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+    }
+
+    /// @note Percentile by nearest rank over sorted samples.
+    static double getPercentile(const std::vector<double>& sorted, double fraction) {
+        if (sorted.empty()) {
+            return 0.0;
+        }
+
+        const auto rank = static_cast<std::size_t>(std::ceil(fraction * static_cast<double>(sorted.size())));
+
+        return sorted[std::clamp<std::size_t>(rank, 1, sorted.size()) - 1];
+    }
+
+    EvalServer::EvalServer(std::string socket_path_, Models::DerivativeBudget derivative_budget_)
+    : socket_path {std::move(socket_path_)}, derivative_budget {derivative_budget_}, formulas {}, connections {}, pending {}, latency_samples_us {}, latency_next {0}, stats {}, listen_fd {-1}, epoll_fd {-1}, stop_fd {-1} {}
+
+    EvalServer::~EvalServer() {
+        for (const auto& [fd, conn] : connections) {
+            close(fd);
+        }
+
+        if (listen_fd >= 0) {
+            close(listen_fd);
+            unlink(socket_path.c_str());
+        }
+
+        if (epoll_fd >= 0) {
+            close(epoll_fd);
+        }
+
+        if (stop_fd >= 0) {
+            close(stop_fd);
+        }
+    }
+
+    bool EvalServer::start() {
+        sockaddr_un address {};
+
+        if (socket_path.empty() || socket_path.size() >= sizeof(address.sun_path)) {
+            errno = ENAMETOOLONG;
+            return false;
+        }
+
+        address.sun_family = AF_UNIX;
+        std::memcpy(address.sun_path, socket_path.c_str(), socket_path.size() + 1);
+
+        // Only a leftover socket gets replaced, never some other file at the path.
+        if (struct stat path_info {}; stat(socket_path.c_str(), &path_info) == 0 && S_ISSOCK(path_info.st_mode)) {
+            unlink(socket_path.c_str());
+        }
+
+        listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+        if (listen_fd < 0) {
+            return false;
+        }
+
+        if (bind(listen_fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 || listen(listen_fd, SOMAXCONN) != 0) {
+            const int saved_errno = errno;
+            close(listen_fd);
+            listen_fd = -1;
+            errno = saved_errno;
+
+            return false;
+        }
+
+        epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        stop_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+        if (epoll_fd < 0 || stop_fd < 0) {
+            return false;
+        }
+
+        epoll_event listen_event {EPOLLIN, {.fd = listen_fd}};
+        epoll_event stop_event {EPOLLIN, {.fd = stop_fd}};
+
+        return epoll_ctl(epoll_fd, EPOLL_CTL_ADD, listen_fd, &listen_event) == 0 && epoll_ctl(epoll_fd, EPOLL_CTL_ADD, stop_fd, &stop_event) == 0;
+    }
+
+    void EvalServer::requestStop() {
+        const std::uint64_t signal_count = 1;
+
+        if (stop_fd >= 0) {
+            [[maybe_unused]] const auto written = write(stop_fd, &signal_count, sizeof(signal_count));
+        }
+    }
+
+    const EvalServer::CompiledFormula& EvalServer::compileFormula(std::string_view source) {
+        std::string key {source};
+
+        if (auto found = formulas.find(key); found != formulas.end()) {
+            return found->second;
+        }
+
+        CompiledFormula compiled {{}, {}, {}};
+
+        try {
+            Frontend::Parser parser;
+            auto parsed = parser.parseAll(key);
+
+            if (!parsed.ok) {
+                compiled.error = "syntax error";
+            } else if (parsed.variables.size() > 1) {
+                compiled.error = "only x may appear";
+            } else if (Backend::AstValidator validator; !validator.foldAst(parsed.root)) {
+                compiled.error = "expression folds to NaN";
+            } else {
+                Backend::FunctionEmitter emitter;
+                compiled.function = emitter.emitFunction(parsed.root);
+                auto derived = Models::deriveWithinBudget(compiled.function, derivative_budget);
+                compiled.derivative = std::move(derived.derivative);
+                stats.numeric_derivatives += (derived.strategy == Models::DerivativeStrategy::dual_number) ? 1 : 0;
+            }
+        } catch (const std::exception& compile_err) {
+            compiled.error = compile_err.what();
+            std::replace(compiled.error.begin(), compiled.error.end(), '\n', ' ');
+        }
+
+        return formulas.emplace(std::move(key), std::move(compiled)).first->second;
+    }
+
+    void EvalServer::acceptClients() {
+        while (true) {
+            const int client_fd = accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+            if (client_fd < 0) {
+                return;
+            }
+
+            epoll_event client_event {read_interest, {.fd = client_fd}};
+
+            if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, client_fd, &client_event) != 0) {
+                close(client_fd);
+                continue;
+            }
+
+            connections[client_fd] = Connection {{}, {}, {}, read_interest, false};
+        }
+    }
+
+    void EvalServer::readClient(int fd, Connection& conn, Clock::time_point now) {
+        std::array<char, read_chunk_size> chunk;
+
+        while (!conn.closing) {
+            const auto got = recv(fd, chunk.data(), chunk.size(), 0);
+
+            if (got > 0) {
+                conn.input.append(chunk.data(), static_cast<std::size_t>(got));
+            } else if (got < 0 && errno == EINTR) {
+                continue;
+            } else if (got < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                break;
+            } else {
+                // End of input or a broken socket: answer what already arrived, then close.
+                conn.closing = true;
+            }
+        }
+
+        std::size_t line_begin = 0;
+
+        for (auto line_end = conn.input.find('\n'); line_end != std::string::npos; line_end = conn.input.find('\n', line_begin)) {
+            handleLine(fd, conn, std::string_view {conn.input}.substr(line_begin, line_end - line_begin), now);
+            line_begin = line_end + 1;
+        }
+
+        conn.input.erase(0, line_begin);
+
+        if (conn.input.size() > max_request_bytes) {
+            conn.replies.push_back("error request too long");
+            conn.input.clear();
+            conn.closing = true;
+            stats.errors++;
+        }
+    }
+
+    void EvalServer::handleLine(int fd, Connection& conn, std::string_view line, Clock::time_point now) {
+        line = trimSpaces(line);
+
+        if (line.empty()) {
+            return;
+        }
+
+        stats.requests++;
+
+        const std::size_t slot = conn.replies.size();
+        conn.replies.emplace_back();
+
+        if (line == "stats") {
+            conn.replies[slot] = formatStats();
+            noteLatency(now);
+            return;
+        }
+
+        std::string_view error;
+        double x = 0.0;
+
+        if (!line.starts_with(eval_prefix)) {
+            error = "unknown request";
+        } else {
+            const auto args = trimSpaces(line.substr(eval_prefix.size()));
+            const auto [x_end, x_errc] = std::from_chars(args.data(), args.data() + args.size(), x);
+            const auto source = trimSpaces(args.substr(static_cast<std::size_t>(x_end - args.data())));
+
+            if (x_errc != std::errc {} || (x_end != args.data() + args.size() && *x_end != ' ' && *x_end != '\t')) {
+                error = "bad x value";
+            } else if (source.empty()) {
+                error = "missing expression";
+            } else if (const auto& formula = compileFormula(source); !formula.error.empty()) {
+                error = formula.error;
+            } else {
+                pending.push_back({fd, slot, x, &formula, now});
+                return;
+            }
+        }
+
+        conn.replies[slot] = std::format("error {}", error);
+        stats.errors++;
+        noteLatency(now);
+    }
+
+    void EvalServer::runBatches() {
+        if (pending.empty()) {
+            return;
+        }
+
+        std::unordered_map<const CompiledFormula*, std::vector<std::size_t>> groups;
+
+        for (std::size_t i = 0; i < pending.size(); i++) {
+            groups[pending[i].formula].push_back(i);
+        }
+
+        std::vector<double> xs;
+        std::vector<double> ys;
+        std::vector<double> slopes;
+
+        for (const auto& [formula, ids] : groups) {
+            xs.clear();
+
+            for (auto id : ids) {
+                xs.push_back(pending[id].x);
+            }
+
+            ys.resize(xs.size());
+            slopes.resize(xs.size());
+            formula->function.evalBatch(xs, ys);
+
+            if (const auto* derivative = formula->derivative.getStoragePtr(); derivative != nullptr) {
+                derivative->evalBatch(xs, slopes);
+            } else {
+                std::fill(slopes.begin(), slopes.end(), std::numeric_limits<double>::quiet_NaN());
+            }
+
+            stats.batches++;
+            stats.evaluations += xs.size();
+            stats.largest_batch = std::max<std::uint64_t>(stats.largest_batch, xs.size());
+
+            for (std::size_t k = 0; k < ids.size(); k++) {
+                const auto& request = pending[ids[k]];
+
+                if (auto conn_it = connections.find(request.fd); conn_it != connections.end()) {
+                    conn_it->second.replies[request.reply_slot] = std::format("ok {:.17g} {:.17g}", ys[k], slopes[k]);
+                }
+
+                noteLatency(request.received);
+            }
+        }
+
+        pending.clear();
+    }
+
+    void EvalServer::noteLatency(Clock::time_point received) {
+        const double latency_us = std::chrono::duration<double, std::micro>(Clock::now() - received).count();
+
+        if (latency_samples_us.size() < latency_window) {
+            latency_samples_us.push_back(latency_us);
+        } else {
+            latency_samples_us[latency_next] = latency_us;
+        }
+
+        latency_next = (latency_next + 1) % latency_window;
+        stats.max_us = std::max(stats.max_us, latency_us);
+    }
+
+    void EvalServer::flushClient(int fd, Connection& conn) {
+        for (const auto& reply : conn.replies) {
+            conn.output += reply;
+            conn.output += '\n';
+        }
+
+        conn.replies.clear();
+
+        std::size_t sent_total = 0;
+
+        while (sent_total < conn.output.size()) {
+            const auto sent = send(fd, conn.output.data() + sent_total, conn.output.size() - sent_total, MSG_NOSIGNAL);
+
+            if (sent > 0) {
+                sent_total += static_cast<std::size_t>(sent);
+            } else if (sent < 0 && errno == EINTR) {
+                continue;
+            } else if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                break;
+            } else {
+                closeClient(fd);
+                return;
+            }
+        }
+
+        conn.output.erase(0, sent_total);
+
+        if (conn.output.empty() && conn.closing) {
+            closeClient(fd);
+            return;
+        }
+
+        // A closing client is only waited on for write space, or its hangup would wake every pass.
+        const std::uint32_t interest = (conn.closing ? 0 : read_interest) | (conn.output.empty() ? 0 : static_cast<std::uint32_t>(EPOLLOUT));
+
+        if (interest != conn.interest) {
+            epoll_event client_event {interest, {.fd = fd}};
+            epoll_ctl(epoll_fd, EPOLL_CTL_MOD, fd, &client_event);
+            conn.interest = interest;
+        }
+    }
+
+    void EvalServer::closeClient(int fd) {
+        epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+        close(fd);
+        connections.erase(fd);
+    }
+
+    ServiceStats EvalServer::run() {
+        std::array<epoll_event, max_events> events;
+        std::vector<int> flush_fds;
+        bool stopping = false;
+
+        while (epoll_fd >= 0 && !stopping) {
+            // No request holds a cached formula between passes, so this is the one safe point to drop the cache.
+            if (formulas.size() >= max_cached_formulas) {
+                formulas.clear();
+            }
+
+            const int ready = epoll_wait(epoll_fd, events.data(), static_cast<int>(events.size()), -1);
+
+            if (ready < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+
+                break;
+            }
+
+            const auto now = Clock::now();
+
+            for (int i = 0; i < ready; i++) {
+                const int fd = events[i].data.fd;
+
+                if (fd == stop_fd) {
+                    stopping = true;
+                } else if (fd == listen_fd) {
+                    acceptClients();
+                } else if (auto conn_it = connections.find(fd); conn_it != connections.end() && (events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) != 0) {
+                    readClient(fd, conn_it->second, now);
+                }
+            }
+
+            runBatches();
+
+            flush_fds.clear();
+
+            for (const auto& [fd, conn] : connections) {
+                if (!conn.replies.empty() || !conn.output.empty() || conn.closing) {
+                    flush_fds.push_back(fd);
+                }
+            }
+
+            for (int fd : flush_fds) {
+                flushClient(fd, connections.at(fd));
+            }
+        }
+
+        return readStats();
+    }
+
+    ServiceStats EvalServer::readStats() const {
+        ServiceStats result = stats;
+        std::vector<double> sorted = latency_samples_us;
+        std::sort(sorted.begin(), sorted.end());
+
+        result.cached_formulas = formulas.size();
+        result.p50_us = getPercentile(sorted, 0.50);
+        result.p90_us = getPercentile(sorted, 0.90);
+        result.p99_us = getPercentile(sorted, 0.99);
+
+        return result;
+    }
+
+    std::string EvalServer::formatStats() const {
+        const auto current = readStats();
+
+        return std::format(
+            "ok requests={} evaluations={} batches={} largest_batch={} errors={} numeric_derivatives={} formulas={} p50_us={:.1f} p90_us={:.1f} p99_us={:.1f} max_us={:.1f}",
+            current.requests, current.evaluations, current.batches, current.largest_batch, current.errors, current.numeric_derivatives, current.cached_formulas,
+            current.p50_us, current.p90_us, current.p99_us, current.max_us
+        );
+    }
+}
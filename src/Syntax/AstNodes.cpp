@@ -13,6 +13,7 @@
 #include "Syntax/IAstVisitor.hpp"
 #include "Syntax/IAstNode.hpp"
 #include "Models/Composite.hpp"
+#include "Utils/Instrument.hpp"
 
 namespace GeneralDeriver::Syntax {
     static constexpr double placeholder_z = 0.0;
@@ -22,7 +23,9 @@ namespace GeneralDeriver::Syntax {
     : value {placeholder_z} {}
 
     Constant::Constant(double value_)
-    : value {value_} {}
+    : value {value_} {
+        Utils::noteNodes(1);
+    }
 
     double Constant::getValue() const { return value; }
 
@@ -35,6 +38,18 @@ namespace GeneralDeriver::Syntax {
     Models::Composite Constant::acceptVisitor(IAstVisitor<Models::Composite>& visitor) const { return visitor.visitConstant(*this); }
 
 
+    VarStub::VarStub()
+    : name {"x"}, slot {0} {}
+
+    VarStub::VarStub(const std::string& name_, std::size_t slot_)
+    : name {name_}, slot {slot_} {
+        Utils::noteNodes(1);
+    }
+
+    const std::string& VarStub::getName() const { return name; }
+
+    std::size_t VarStub::getSlot() const { return slot; }
+
     AstNodeType VarStub::getType() const { return AstNodeType::literal; }
 
     AstOpType VarStub::getOp() const { return AstOpType::none; }
@@ -45,10 +60,14 @@ namespace GeneralDeriver::Syntax {
 
 
     Unary::Unary(AstOpType op_, std::unique_ptr<IAstNode>&& x_inner)
-    : inner (std::move(x_inner)), op {op_} {}
+    : inner (std::move(x_inner)), op {op_} {
+        Utils::noteNodes(1);
+    }
 
     const std::unique_ptr<IAstNode>& Unary::getInnerPtr() const { return inner; }
 
+    std::unique_ptr<IAstNode>& Unary::getInnerPtr() { return inner; }
+
     AstNodeType Unary::getType() const { return AstNodeType::unary; }
 
     AstOpType Unary::getOp() const { return op; }
@@ -59,12 +78,18 @@ namespace GeneralDeriver::Syntax {
 
 
     Binary::Binary(AstOpType op_, std::unique_ptr<IAstNode>&& x_lhs, std::unique_ptr<IAstNode>&& x_rhs)
-    : lhs (std::move(x_lhs)), rhs (std::move(x_rhs)), op {op_} {}
+    : lhs (std::move(x_lhs)), rhs (std::move(x_rhs)), op {op_} {
+        Utils::noteNodes(1);
+    }
 
     const std::unique_ptr<IAstNode>& Binary::getLeft() const { return lhs; }
 
     const std::unique_ptr<IAstNode>& Binary::getRight() const { return rhs; }
 
+    std::unique_ptr<IAstNode>& Binary::getLeft() { return lhs; }
+
+    std::unique_ptr<IAstNode>& Binary::getRight() { return rhs; }
+
     AstNodeType Binary::getType() const { return AstNodeType::binary; };
 
     AstOpType Binary::getOp() const { return op; }
@@ -0,0 +1,87 @@
+/**
+ * @file FlatAst.cpp
+ * @author DrkWithT
+ * @brief Implements structure-of-arrays AST buffer.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "Syntax/FlatAst.hpp"
+
+namespace GeneralDeriver::Syntax {
+    FlatAst::FlatAst()
+    : tags {}, ops {}, lefts {}, rights {}, constants {}, variable_names {} {}
+
+    FlatIndex FlatAst::pushNode(FlatTag tag, AstOpType op, FlatIndex left, FlatIndex right) {
+        tags.push_back(tag);
+        ops.push_back(op);
+        lefts.push_back(left);
+        rights.push_back(right);
+
+        return static_cast<FlatIndex>(tags.size() - 1);
+    }
+
+    FlatIndex FlatAst::addConstant(double value) {
+        constants.push_back(value);
+
+        return pushNode(FlatTag::constant, AstOpType::none, static_cast<FlatIndex>(constants.size() - 1), 0);
+    }
+
+    FlatIndex FlatAst::addVariable(std::size_t slot) {
+        return pushNode(FlatTag::variable, AstOpType::none, static_cast<FlatIndex>(slot), 0);
+    }
+
+    FlatIndex FlatAst::addUnary(AstOpType op, FlatIndex inner) {
+        return pushNode(FlatTag::unary, op, inner, 0);
+    }
+
+    FlatIndex FlatAst::addBinary(AstOpType op, FlatIndex lhs, FlatIndex rhs) {
+        return pushNode(FlatTag::binary, op, lhs, rhs);
+    }
+
+    void FlatAst::rewriteConstant(FlatIndex node, double value) {
+        constants.push_back(value);
+
+        tags[node] = FlatTag::constant;
+        ops[node] = AstOpType::none;
+        lefts[node] = static_cast<FlatIndex>(constants.size() - 1);
+        rights[node] = 0;
+    }
+
+    void FlatAst::setVariableNames(const std::vector<std::string>& names) {
+        variable_names = names;
+    }
+
+    std::size_t FlatAst::getSize() const { return tags.size(); }
+
+    bool FlatAst::isEmpty() const { return tags.empty(); }
+
+    std::size_t FlatAst::getCapacity() const { return tags.capacity(); }
+
+    FlatIndex FlatAst::getRoot() const { return static_cast<FlatIndex>(tags.size() - 1); }
+
+    FlatTag FlatAst::getTag(FlatIndex node) const { return tags[node]; }
+
+    AstOpType FlatAst::getOp(FlatIndex node) const { return ops[node]; }
+
+    FlatIndex FlatAst::getLeft(FlatIndex node) const { return lefts[node]; }
+
+    FlatIndex FlatAst::getRight(FlatIndex node) const { return rights[node]; }
+
+    double FlatAst::getConstant(FlatIndex node) const { return constants[lefts[node]]; }
+
+    std::size_t FlatAst::getSlot(FlatIndex node) const { return lefts[node]; }
+
+    const std::vector<std::string>& FlatAst::getVariableNames() const { return variable_names; }
+
+    void FlatAst::clear() {
+        tags.clear();
+        ops.clear();
+        lefts.clear();
+        rights.clear();
+        constants.clear();
+        variable_names.clear();
+    }
+}
@@ -0,0 +1,153 @@
+/**
+ * @file TestAllocBudget.cpp
+ * @author DrkWithT
+ * @brief Implements allocation budget tests for each pipeline stage.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <format>
+#include <iostream>
+#include <string_view>
+#include <vector>
+#include "Benchmarks/AllocTracking.hpp"
+#include "Frontend/Lexer.hpp"
+#include "Frontend/Parser.hpp"
+#include "Backend/AstValidator.hpp"
+#include "Backend/FuncEmitter.hpp"
+#include "Models/Composite.hpp"
+#include "Models/Polynomial.hpp"
+#include "Utils/Instrument.hpp"
+
+using MyAllocScope = GeneralDeriver::Benchmarks::AllocScope;
+using MyAllocStats = GeneralDeriver::Benchmarks::AllocStats;
+using MyStage = GeneralDeriver::Utils::Stage;
+using MyStageTimer = GeneralDeriver::Utils::StageTimer;
+using MyPolynomial = GeneralDeriver::Models::Polynomial;
+
+static constexpr const char* test_source = "sin(x) * x + exp(x) / (x + 2) - ln(x) * cos(x) ^ 2";
+static constexpr std::size_t test_ast_nodes = 19;
+static constexpr std::size_t eval_rounds = 1000;
+
+/* Budgets per stage. Raising one should come with a reason in review, as allocation is most of the cost of these paths. */
+
+static constexpr std::size_t parse_extra_allocs = 4;    // beyond one per AST node: variable table & result bookkeeping
+static constexpr std::size_t emit_allocs_per_node = 4;
+static constexpr std::size_t derive_allocs_per_node = 5;
+
+[[nodiscard]] bool checkBudget(std::string_view label, const MyAllocStats& used, std::size_t budget) {
+    if (used.count <= budget) {
+        return true;
+    }
+
+    std::cerr << std::format("{} made {} allocations ({} bytes), over its budget of {}\n", label, used.count, used.bytes, budget);
+    return false;
+}
+
+int main() {
+    GeneralDeriver::Benchmarks::attachStageAllocTracking();
+    GeneralDeriver::Utils::resetStats();
+
+    GeneralDeriver::Frontend::Lexer lexer {test_source};
+    {
+        MyAllocScope scope;
+
+        while (lexer.lexNext().tag != GeneralDeriver::Frontend::TokenType::eos) {}
+
+        if (!checkBudget("Lexer::lexNext", scope.read(), 0)) {
+            return 1;
+        }
+    }
+
+    GeneralDeriver::Frontend::Parser parser;
+    GeneralDeriver::Frontend::ParseResult parsed {nullptr, {}, false};
+    MyAllocStats parse_used {};
+    {
+        MyAllocScope scope;
+        MyStageTimer timer {MyStage::parse};
+        parsed = parser.parseAll(test_source);
+        parse_used = scope.read();
+    }
+
+    if (!parsed.ok || !checkBudget("Parser::parseAll", parse_used, test_ast_nodes + parse_extra_allocs)) {
+        return 1;
+    }
+
+    // The stage timer should attribute the same count & bytes to the parse stage.
+    if constexpr (GeneralDeriver::Utils::instrument_enabled) {
+        const auto stats = GeneralDeriver::Utils::readStats();
+        const auto& parse_stage = stats.stages[static_cast<std::size_t>(MyStage::parse)];
+
+        if (parse_stage.allocations != parse_used.count || parse_stage.alloc_bytes != parse_used.bytes) {
+            std::cerr << std::format("Parse stage counted {} allocations / {} bytes, scope counted {} / {}\n", parse_stage.allocations, parse_stage.alloc_bytes, parse_used.count, parse_used.bytes);
+            return 1;
+        }
+    }
+
+    {
+        GeneralDeriver::Backend::AstValidator validator;
+        MyAllocScope scope;
+
+        // Nothing here folds, so validation only walks the tree.
+        if (!validator.foldAst(parsed.root) || !checkBudget("AstValidator::foldAst", scope.read(), 0)) {
+            return 1;
+        }
+    }
+
+    GeneralDeriver::Backend::FunctionEmitter emitter;
+    GeneralDeriver::Models::Composite fn;
+    {
+        MyAllocScope scope;
+        fn = emitter.emitFunction(parsed.root);
+
+        if (!checkBudget("FunctionEmitter::emitFunction", scope.read(), emit_allocs_per_node * test_ast_nodes)) {
+            return 1;
+        }
+    }
+
+    GeneralDeriver::Models::FunctionAny derivative;
+    {
+        MyAllocScope scope;
+        derivative = fn.makeDerivative();
+
+        if (derivative.getStoragePtr() == nullptr || !checkBudget("Composite::makeDerivative", scope.read(), derive_allocs_per_node * test_ast_nodes)) {
+            return 1;
+        }
+    }
+
+    {
+        MyAllocScope scope;
+        GeneralDeriver::Models::FunctionAny copy = derivative;
+        GeneralDeriver::Models::FunctionAny moved = std::move(copy);
+
+        if (!checkBudget("FunctionAny copy & move", scope.read(), 0)) {
+            return 1;
+        }
+    }
+
+    // Steady state: the first calls may set up lazily built state, every later call must not allocate.
+    const MyPolynomial poly {{{3.0, 4.0}, {-2.0, 1.0}, {1.0, 0.0}}};
+    const std::vector<double> point {0.5};
+    double checksum = fn.evalAt(0.5) + derivative.getStoragePtr()->evalAt(0.5) + poly.evalAt(0.5);
+    {
+        MyAllocScope scope;
+        MyStageTimer timer {MyStage::eval};
+
+        for (std::size_t i = 0; i < eval_rounds; i++) {
+            const double x = 0.5 + 1e-3 * static_cast<double>(i);
+
+            checksum += fn.evalAt(x) + derivative.getStoragePtr()->evalAt(x) + poly.evalAt(x) + fn.evalAtPoint(point);
+        }
+
+        if (!checkBudget("steady-state evalAt", scope.read(), 0)) {
+            return 1;
+        }
+    }
+
+    if (checksum == 0.0) {
+        std::cerr << "Evaluation checksum should not vanish\n";
+        return 1;
+    }
+}
@@ -0,0 +1,153 @@
+/**
+ * @file TestDerivativeBudget.cpp
+ * @author DrkWithT
+ * @brief Implements tests for derivative cost estimates and the switch to dual-number derivatives.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <array>
+#include <cmath>
+#include <format>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "Benchmarks/AllocTracking.hpp"
+#include "Models/Composite.hpp"
+#include "Models/DerivativeBudget.hpp"
+#include "Models/Identity.hpp"
+#include "Models/Polynomial.hpp"
+#include "Models/Tape.hpp"
+#include "Tests/TestSupport.hpp"
+
+using MyAllocScope = GeneralDeriver::Benchmarks::AllocScope;
+using MyCompFunc = GeneralDeriver::Models::Composite;
+using MyFunctionAny = GeneralDeriver::Models::FunctionAny;
+using MyIdentity = GeneralDeriver::Models::Identity;
+using MyPoly = GeneralDeriver::Models::Polynomial;
+using MyDualDerivative = GeneralDeriver::Models::DualDerivative;
+using MyBudget = GeneralDeriver::Models::DerivativeBudget;
+using MyStrategy = GeneralDeriver::Models::DerivativeStrategy;
+using MyTape = GeneralDeriver::Models::Tape;
+using MyEvaluator = GeneralDeriver::Models::AdjointEvaluator;
+using MyOp = GeneralDeriver::Syntax::AstOpType;
+
+using GeneralDeriver::Tests::emitSource;
+using GeneralDeriver::Tests::isClose;
+
+static constexpr const char* test_source = "x * sin(x) + exp(x^2) / (x + 1) + cos(x)^3 - ln(x + 2) + sqrt(x + 1) * x^2.5";
+static constexpr std::array<double, 4> test_xs = {0.25, 0.7, 1.5, 3.0};
+static constexpr int test_dag_depth = 64;
+
+/// @note Estimates should bound what deriving really allocates, without being so loose that budgets turn meaningless.
+static constexpr std::size_t estimate_slack = 4;
+
+/// @brief Builds g_k = sin(g_{k-1}) * cos(g_{k-1}) with g_0 = x, sharing each level between both calls. The eager derivative re-derives every level twice per handle, so it would need about 2^depth nodes.
+[[nodiscard]] MyFunctionAny buildSharedChain(int depth) {
+    MyFunctionAny level = MyIdentity {};
+
+    for (int k = 0; k < depth; k++) {
+        level = MyCompFunc {MyOp::mul, MyCompFunc {MyOp::sin, level, {}}, MyCompFunc {MyOp::cos, level, {}}};
+    }
+
+    return level;
+}
+
+int main() {
+    GeneralDeriver::Benchmarks::attachStageAllocTracking();
+
+    MyFunctionAny fn = emitSource(test_source);
+    const auto cost = fn.unpackFunctionAny<MyCompFunc>().estimateCost();
+
+    MyFunctionAny symbolic;
+    GeneralDeriver::Benchmarks::AllocStats derive_used {};
+    {
+        MyAllocScope scope;
+        symbolic = fn.getStoragePtr()->makeDerivative();
+        derive_used = scope.read();
+    }
+
+    if (cost.derivative_bytes < derive_used.bytes || cost.derivative_bytes > estimate_slack * derive_used.bytes || cost.derivative_nodes > estimate_slack * derive_used.count) {
+        std::cerr << std::format("Estimate of {} nodes & {} bytes does not fit the {} allocations & {} bytes deriving made\n", cost.derivative_nodes, cost.derivative_bytes, derive_used.count, derive_used.bytes);
+        return 1;
+    }
+
+    if (auto within = GeneralDeriver::Models::deriveWithinBudget(fn, MyBudget {}); within.strategy != MyStrategy::symbolic) {
+        std::cerr << std::format("Derivative of {} nodes should fit the default budget\n", within.cost.derivative_nodes);
+        return 1;
+    }
+
+    // Forcing the numeric strategy must not change f'.
+    const auto numeric = GeneralDeriver::Models::deriveWithinBudget(fn, MyBudget {cost.derivative_nodes - 1, cost.derivative_bytes});
+
+    if (numeric.strategy != MyStrategy::dual_number) {
+        std::cerr << "Derivative over its node budget should use dual numbers\n";
+        return 1;
+    }
+
+    std::vector<double> numeric_out(test_xs.size());
+    numeric.derivative.getStoragePtr()->evalBatch(test_xs, numeric_out);
+
+    for (std::size_t i = 0; i < test_xs.size(); i++) {
+        const double expected = symbolic.getStoragePtr()->evalAt(test_xs[i]);
+
+        if (!isClose(numeric.derivative.getStoragePtr()->evalAt(test_xs[i]), expected) || !isClose(numeric_out[i], expected)) {
+            std::cerr << std::format("Dual-number d/dx = {} vs symbolic {} at x = {}\n", numeric_out[i], expected, test_xs[i]);
+            return 1;
+        }
+    }
+
+    // A polynomial leaf tapes to one node whose term range runs past the node count. Sweeping on a fresh thread gives a buffer no bigger than that tape, so reading operands of leaves would go out of bounds.
+    const MyFunctionAny many_terms = MyPoly::fromDense({1, -2, 3, -4, 5, -6, 7, -8, 9, -10});
+    const MyFunctionAny many_terms_symbolic = many_terms.getStoragePtr()->makeDerivative();
+    const MyFunctionAny many_terms_dual = MyDualDerivative {many_terms};
+    std::vector<double> many_terms_out(test_xs.size());
+
+    std::thread {[&many_terms_dual, &many_terms_out]() {
+        many_terms_dual.getStoragePtr()->evalBatch(test_xs, many_terms_out);
+    }}.join();
+
+    for (std::size_t i = 0; i < test_xs.size(); i++) {
+        if (!isClose(many_terms_out[i], many_terms_symbolic.getStoragePtr()->evalAt(test_xs[i]))) {
+            std::cerr << std::format("Dual-number d/dx of a 10-term polynomial = {} at x = {}\n", many_terms_out[i], test_xs[i]);
+            return 1;
+        }
+    }
+
+    // A shared chain has few nodes but an exponential eager derivative, so the default budget must refuse it, and the fallback must stay linear.
+    MyFunctionAny chain = buildSharedChain(test_dag_depth);
+    GeneralDeriver::Models::BudgetedDerivative chain_derived {{}, {}, MyStrategy::symbolic};
+    GeneralDeriver::Benchmarks::AllocStats fallback_used {};
+    {
+        MyAllocScope scope;
+        chain_derived = GeneralDeriver::Models::deriveWithinBudget(chain, MyBudget {});
+        fallback_used = scope.read();
+    }
+
+    if (chain_derived.strategy != MyStrategy::dual_number || chain_derived.cost.node_count != 3 * test_dag_depth + 1) {
+        std::cerr << std::format("Shared chain of {} nodes, estimated at {} derivative nodes, should use dual numbers\n", chain_derived.cost.node_count, chain_derived.cost.derivative_nodes);
+        return 1;
+    }
+
+    // Estimating & taping each walk the distinct nodes once, so together they stay within a small multiple of the source.
+    if (fallback_used.bytes > 2 * chain_derived.cost.bytes) {
+        std::cerr << std::format("Dual-number fallback allocated {} bytes, over twice the {} byte source\n", fallback_used.bytes, chain_derived.cost.bytes);
+        return 1;
+    }
+
+    MyTape chain_tape {*chain.getStoragePtr()};
+    MyEvaluator chain_adjoints {chain_tape};
+
+    for (double x : test_xs) {
+        std::array<double, 1> point {x};
+        std::array<double, 1> gradient {};
+        chain_adjoints.gradientAt(point, gradient);
+
+        if (!isClose(chain_derived.derivative.getStoragePtr()->evalAt(x), gradient[0])) {
+            std::cerr << std::format("Dual-number d/dx of the shared chain = {} vs adjoint {} at x = {}\n", chain_derived.derivative.getStoragePtr()->evalAt(x), gradient[0], x);
+            return 1;
+        }
+    }
+}
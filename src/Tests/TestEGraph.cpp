@@ -0,0 +1,121 @@
+/**
+ * @file TestEGraph.cpp
+ * @author DrkWithT
+ * @brief Implements tests for the e-graph optimizer's rewrites and cost-based extraction.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <format>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include "Backend/EGraphOptimizer.hpp"
+#include "Models/Composite.hpp"
+#include "Models/Polynomial.hpp"
+#include "Tests/TestSupport.hpp"
+
+using MyFunctionAny = GeneralDeriver::Models::FunctionAny;
+using MyPoly = GeneralDeriver::Models::Polynomial;
+using MyOptimizer = GeneralDeriver::Backend::EGraphOptimizer;
+using MyOptions = GeneralDeriver::Backend::EGraphOptions;
+
+using GeneralDeriver::Tests::emitSource;
+using GeneralDeriver::Tests::isClose;
+
+static constexpr const char* test_shared_factor_source = "sin(x) * exp(x) + sin(x) * cos(x)";
+static constexpr const char* test_derive_source = "x * sin(x) + exp(x^2) / (x + 1) + cos(x)^3 - ln(x + 2) + (x^2 + 1)^3";
+static constexpr std::array<double, 4> test_xs = {0.25, 0.7, 1.5, 3.0};
+static constexpr std::chrono::microseconds test_time_budget {20000};
+static constexpr double test_tolerance = 1e-9; // rewrites re-associate & factor, so rounding differs more than in other tests
+
+[[nodiscard]] std::size_t countMatches(std::string_view text, std::string_view part) {
+    std::size_t count = 0;
+
+    for (auto pos = text.find(part); pos != std::string_view::npos; pos = text.find(part, pos + 1)) {
+        count++;
+    }
+
+    return count;
+}
+
+/// @note Checks the optimized function against its input at every test x, and that extraction never made it costlier.
+[[nodiscard]] bool checkOptimized(std::string_view label, const MyFunctionAny& input, const GeneralDeriver::Backend::OptimizeResult& result) {
+    for (double x : test_xs) {
+        const double expected = input.getStoragePtr()->evalAt(x);
+        const double actual = result.function.getStoragePtr()->evalAt(x);
+
+        if (!isClose(actual, expected, test_tolerance)) {
+            std::cerr << std::format("{}: optimized '{}' gives {} vs {} at x = {}\n", label, result.function.getStoragePtr()->toText(), actual, expected, x);
+            return false;
+        }
+    }
+
+    if (result.stats.cost_after > result.stats.cost_before) {
+        std::cerr << std::format("{}: cost grew from {} to {}\n", label, result.stats.cost_before, result.stats.cost_after);
+        return false;
+    }
+
+    return true;
+}
+
+int main() {
+    const auto measured = GeneralDeriver::Backend::measureOpCosts();
+
+    if (!(measured.dispatch > 0.0 && measured.sin > 0.0 && measured.poly_term > 0.0 && measured.int_power_step > 0.0)) {
+        std::cerr << "Measured op costs should all be positive\n";
+        return 1;
+    }
+
+    MyOptions options;
+    options.time_budget = test_time_budget;
+    MyOptimizer optimizer {options};
+
+    // 3(x - 1)^8 expands to 9 terms, but factors back into one line & three squarings.
+    MyFunctionAny expanded = MyPoly::fromDense({3, -24, 84, -168, 210, -168, 84, -24, 3});
+    const auto factored = optimizer.optimize(expanded);
+
+    if (!checkOptimized("3(x - 1)^8", expanded, factored)) {
+        return 1;
+    }
+
+    if (const auto text = factored.function.getStoragePtr()->toText(); text.find("^8") == std::string::npos || factored.stats.cost_after >= factored.stats.cost_before) {
+        std::cerr << std::format("Expanded 3(x - 1)^8 should factor, but became '{}'\n", text);
+        return 1;
+    }
+
+    // Pulling out the common factor leaves one sine instead of two.
+    MyFunctionAny shared_factor = emitSource(test_shared_factor_source);
+    const auto pulled = optimizer.optimize(shared_factor);
+
+    if (!checkOptimized(test_shared_factor_source, shared_factor, pulled)) {
+        return 1;
+    }
+
+    if (const auto text = pulled.function.getStoragePtr()->toText(); countMatches(text, "sin(") != 1 || pulled.stats.cost_after >= pulled.stats.cost_before) {
+        std::cerr << std::format("Common sin(x) factor should come out once, but got '{}'\n", text);
+        return 1;
+    }
+
+    // Derivatives are what the optimizer is for, so one must come out equivalent, cheaper, and within the time budget plus rebuild slack.
+    MyFunctionAny fn = emitSource(test_derive_source);
+    MyFunctionAny derivative = fn.getStoragePtr()->makeDerivative();
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto derived = optimizer.optimize(derivative);
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    if (!checkOptimized("derivative", derivative, derived)) {
+        return 1;
+    }
+
+    if (derived.stats.cost_after >= derived.stats.cost_before || elapsed > 10 * test_time_budget) {
+        std::cerr << std::format("Derivative cost {} -> {} after {} iterations in {} us\n", derived.stats.cost_before, derived.stats.cost_after, derived.stats.iterations, elapsed.count());
+        return 1;
+    }
+}
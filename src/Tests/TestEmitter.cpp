@@ -9,12 +9,19 @@
  */
 
 #include <iostream>
+#include <cmath>
 #include <format>
+#include <vector>
 #include "Models/Composite.hpp"
+#include "Models/Polynomial.hpp"
 #include "Frontend/Parser.hpp"
 #include "Backend/FuncEmitter.hpp"
 
 using MyCompFunc = GeneralDeriver::Models::Composite;
+using MyPoly = GeneralDeriver::Models::Polynomial;
+using MyPolyTerm = GeneralDeriver::Models::PolynomialTerm;
+using MyOpType = GeneralDeriver::Syntax::AstOpType;
+using MyFuncType = GeneralDeriver::Models::FuncType;
 using MyParser = GeneralDeriver::Frontend::Parser;
 using MyParseResult = GeneralDeriver::Frontend::ParseResult;
 using MyFuncEmitter = GeneralDeriver::Backend::FunctionEmitter;
@@ -24,6 +31,52 @@ static constexpr double test_x_1 = 2;
 static constexpr double test_output_1 = 3;
 static constexpr double test_dx_output_1 = 4;
 
+static constexpr const char* test_source_2 = "(x + 1)^2 - (x + 1)";
+static constexpr const char* test_source_3 = "-(x - 2) * 3 + x^3 / 2";
+static constexpr const char* test_source_4 = "sin(x) + (x + 1)^2";
+static constexpr const char* test_source_5 = "sin(x)^3";
+static constexpr const char* test_source_6 = "(x + 1)^2 - x^2 - 2 * x";
+static constexpr const char* test_source_7 = "x * sin(x)";
+static constexpr const char* test_source_8 = "sin(x) / (x + 1)";
+static constexpr const char* test_source_9 = "-sin(x)";
+static constexpr double test_x_5 = 0.5;
+
+/// @note Derives the source's function the given number of times, then evaluates at x.
+static double evalNthDerivative(MyParser& parser, MyFuncEmitter& emitter, const char* source, int order, double x) {
+    MyCompFunc fn = emitter.emitFunction(parser.parseAll(source).root);
+
+    for (int i = 0; i < order; i++) {
+        fn = fn.makeDerivative().unpackFunctionAny<MyCompFunc>();
+    }
+
+    return fn.evalAt(x);
+}
+
+/// @note Checks that the source emits one polynomial leaf with exactly the expected canonical terms.
+static bool emitsNormalForm(MyParser& parser, MyFuncEmitter& emitter, const char* source, const std::vector<MyPolyTerm>& expected) {
+    MyCompFunc fn = emitter.emitFunction(parser.parseAll(source).root);
+
+    const auto* poly = dynamic_cast<const MyPoly*>(fn.getLeft().getStoragePtr());
+
+    if (fn.getOp() != MyOpType::none || !poly) {
+        return false;
+    }
+
+    const auto& terms = poly->getTerms();
+
+    if (terms.size() != expected.size()) {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < terms.size(); i++) {
+        if (terms[i].coeff != expected[i].coeff || terms[i].power != expected[i].power) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 int main() {
     MyParser parser;
     MyParseResult parse_result = parser.parseAll(test_source_1);
@@ -49,4 +102,61 @@ int main() {
         std::cerr << std::format("Unexpected output of d/dx({}): {}\n", test_source_1, dx_y_1);
         return 1;
     }
-}
\ No newline at end of file
+
+    if (!emitsNormalForm(parser, emitter, test_source_2, {{1, 2}, {1, 1}})) {
+        std::cerr << std::format("Unexpected normal form of f(x) = {}\n", test_source_2);
+        return 1;
+    }
+
+    if (!emitsNormalForm(parser, emitter, test_source_3, {{0.5, 3}, {-3, 1}, {6, 0}})) {
+        std::cerr << std::format("Unexpected normal form of f(x) = {}\n", test_source_3);
+        return 1;
+    }
+
+    MyCompFunc mixed_4 = emitter.emitFunction(parser.parseAll(test_source_4).root);
+    MyCompFunc squared_4 = mixed_4.getRight().unpackFunctionAny<MyCompFunc>();
+
+    if (mixed_4.getOp() != MyOpType::add || squared_4.getOp() != MyOpType::none || !dynamic_cast<const MyPoly*>(squared_4.getLeft().getStoragePtr())) {
+        std::cerr << std::format("Unexpected partial normal form of f(x) = {}\n", test_source_4);
+        return 1;
+    }
+
+    // sin(x)^3 has no polynomial form, so its power becomes an IntPower leaf deriving to 3 * sin(x)^2 * cos(x).
+    MyCompFunc cubed_5 = emitter.emitFunction(parser.parseAll(test_source_5).root);
+    const double expected_5 = std::pow(std::sin(test_x_5), 3);
+    const double expected_dx_5 = 3 * std::pow(std::sin(test_x_5), 2) * std::cos(test_x_5);
+    const double dx_5 = cubed_5.makeDerivative().unpackFunctionAny<MyCompFunc>().evalAt(test_x_5);
+
+    if (cubed_5.getLeft().getStoragePtr()->getType() != MyFuncType::int_power || std::fabs(cubed_5.evalAt(test_x_5) - expected_5) > 1e-15 || std::fabs(dx_5 - expected_dx_5) > 1e-15) {
+        std::cerr << std::format("Unexpected integer power of f(x) = {}\n", test_source_5);
+        return 1;
+    }
+
+    MyCompFunc constant_6 = emitter.emitFunction(parser.parseAll(test_source_6).root);
+
+    if (constant_6.getLeft().getStoragePtr()->getType() != MyFuncType::constant || constant_6.evalAt(test_x_5) != 1) {
+        std::cerr << std::format("Unexpected constant leaf of f(x) = {}\n", test_source_6);
+        return 1;
+    }
+
+    // Product & quotient rules, plus the second derivative of a negation which the emitter turns into a product.
+    const double sin_5 = std::sin(test_x_5);
+    const double cos_5 = std::cos(test_x_5);
+    const double expected_dx_7 = sin_5 + test_x_5 * cos_5;
+    const double expected_dx_8 = (cos_5 * (test_x_5 + 1) - sin_5) / ((test_x_5 + 1) * (test_x_5 + 1));
+
+    if (std::fabs(evalNthDerivative(parser, emitter, test_source_7, 1, test_x_5) - expected_dx_7) > 1e-15) {
+        std::cerr << std::format("Unexpected product rule output of d/dx({})\n", test_source_7);
+        return 1;
+    }
+
+    if (std::fabs(evalNthDerivative(parser, emitter, test_source_8, 1, test_x_5) - expected_dx_8) > 1e-15) {
+        std::cerr << std::format("Unexpected quotient rule output of d/dx({})\n", test_source_8);
+        return 1;
+    }
+
+    if (std::fabs(evalNthDerivative(parser, emitter, test_source_9, 2, test_x_5) - sin_5) > 1e-15) {
+        std::cerr << std::format("Unexpected output of d2/dx2({})\n", test_source_9);
+        return 1;
+    }
+}
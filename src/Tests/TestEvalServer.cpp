@@ -0,0 +1,182 @@
+/**
+ * @file TestEvalServer.cpp
+ * @author DrkWithT
+ * @brief Implements tests for the Unix socket evaluation service and its request batching.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "Models/Composite.hpp"
+#include "Service/EvalServer.hpp"
+#include "Tests/TestSupport.hpp"
+
+using MyEvalServer = GeneralDeriver::Service::EvalServer;
+
+using GeneralDeriver::Tests::isClose;
+
+static constexpr const char* test_source = "x * sin(x) + exp(x) / (x + 2)";
+static constexpr std::size_t client_count = 4;
+static constexpr std::size_t requests_per_client = 64;
+
+[[nodiscard]] int connectTo(const std::string& path) {
+    const int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    sockaddr_un address {};
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    if (fd >= 0 && connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+/// @note Sends all requests in one write, then half-closes so the server sees the end, and reads every reply line.
+[[nodiscard]] std::vector<std::string> sendRequests(const std::string& path, const std::string& requests) {
+    const int fd = connectTo(path);
+    std::vector<std::string> lines;
+
+    if (fd < 0) {
+        return lines;
+    }
+
+    for (std::size_t sent = 0; sent < requests.size();) {
+        const auto count = send(fd, requests.data() + sent, requests.size() - sent, MSG_NOSIGNAL);
+
+        if (count <= 0) {
+            close(fd);
+            return lines;
+        }
+
+        sent += static_cast<std::size_t>(count);
+    }
+
+    shutdown(fd, SHUT_WR);
+
+    std::string received;
+    std::array<char, 4096> chunk;
+
+    for (auto count = recv(fd, chunk.data(), chunk.size(), 0); count > 0; count = recv(fd, chunk.data(), chunk.size(), 0)) {
+        received.append(chunk.data(), static_cast<std::size_t>(count));
+    }
+
+    close(fd);
+
+    std::istringstream sin {received};
+
+    for (std::string line; std::getline(sin, line);) {
+        lines.push_back(line);
+    }
+
+    return lines;
+}
+
+[[nodiscard]] double getTestX(std::size_t client, std::size_t request) {
+    return 0.1 + 0.05 * static_cast<double>(request) + 0.01 * static_cast<double>(client);
+}
+
+int main() {
+    const auto path = (std::filesystem::temp_directory_path() / std::format("gd_eval_test_{}.sock", static_cast<unsigned long>(getpid()))).string();
+    MyEvalServer server {path};
+
+    if (!server.start()) {
+        std::cerr << std::format("Cannot listen on {}: {}\n", path, std::strerror(errno));
+        return 1;
+    }
+
+    GeneralDeriver::Service::ServiceStats final_stats {};
+    std::thread server_thread {[&server, &final_stats]() { final_stats = server.run(); }};
+
+    const auto fn = GeneralDeriver::Tests::emitSource(test_source);
+    const auto derivative = fn.makeDerivative();
+
+    std::atomic<std::size_t> failures {0};
+    std::vector<std::thread> clients;
+
+    for (std::size_t c = 0; c < client_count; c++) {
+        clients.emplace_back([&, c]() {
+            std::string requests;
+
+            for (std::size_t r = 0; r < requests_per_client; r++) {
+                requests += std::format("eval {} {}\n", getTestX(c, r), test_source);
+            }
+
+            requests += "eval 1 sin(\nbogus\n";
+
+            const auto lines = sendRequests(path, requests);
+
+            if (lines.size() != requests_per_client + 2 || !lines[requests_per_client].starts_with("error ") || !lines.back().starts_with("error ")) {
+                failures++;
+                return;
+            }
+
+            for (std::size_t r = 0; r < requests_per_client; r++) {
+                std::istringstream reply {lines[r]};
+                std::string status;
+                double y = 0.0;
+                double dy = 0.0;
+                const double x = getTestX(c, r);
+
+                if (!(reply >> status >> y >> dy) || status != "ok" || !isClose(y, fn.evalAt(x)) || !isClose(dy, derivative.getStoragePtr()->evalAt(x))) {
+                    failures++;
+                    return;
+                }
+            }
+        });
+    }
+
+    for (auto& client : clients) {
+        client.join();
+    }
+
+    const auto stats_lines = sendRequests(path, "stats\n");
+    server.requestStop();
+    server_thread.join();
+
+    if (failures > 0) {
+        std::cerr << std::format("{} client(s) got wrong or missing replies\n", failures.load());
+        return 1;
+    }
+
+    if (stats_lines.size() != 1 || !stats_lines[0].starts_with("ok requests=")) {
+        std::cerr << "Unexpected stats reply\n";
+        return 1;
+    }
+
+    // Every client's pipelined requests arrive in one read, so they must share batches, and the formula compiles once.
+    const std::size_t eval_count = client_count * requests_per_client;
+
+    if (final_stats.evaluations != eval_count || final_stats.batches >= eval_count || final_stats.largest_batch < requests_per_client || final_stats.cached_formulas != 2) {
+        std::cerr << std::format("Expected batched evaluations: {} evaluations, {} batches, largest {}, {} formulas\n", final_stats.evaluations, final_stats.batches, final_stats.largest_batch, final_stats.cached_formulas);
+        return 1;
+    }
+
+    if (final_stats.errors != 2 * client_count || final_stats.p50_us > final_stats.p99_us || final_stats.p99_us > final_stats.max_us) {
+        std::cerr << "Unexpected error count or latency percentiles\n";
+        return 1;
+    }
+
+    if (std::filesystem::exists(path)) {
+        return 0;
+    }
+
+    std::cerr << "Socket should stay until the server is destroyed\n";
+    return 1;
+}
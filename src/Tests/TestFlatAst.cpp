@@ -0,0 +1,94 @@
+/**
+ * @file TestFlatAst.cpp
+ * @author DrkWithT
+ * @brief Implements tests for flat AST parsing, folding & emission.
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#include <array>
+#include <iostream>
+#include <format>
+#include "Syntax/FlatAst.hpp"
+#include "Frontend/FlatParser.hpp"
+#include "Frontend/Parser.hpp"
+#include "Backend/FlatPasses.hpp"
+#include "Backend/FuncEmitter.hpp"
+#include "Models/Composite.hpp"
+
+using MyCompFunc = GeneralDeriver::Models::Composite;
+using MyFlatAst = GeneralDeriver::Syntax::FlatAst;
+using MyFlatTag = GeneralDeriver::Syntax::FlatTag;
+using MyFlatParser = GeneralDeriver::Frontend::FlatParser;
+using MyParser = GeneralDeriver::Frontend::Parser;
+using MyFlatValidator = GeneralDeriver::Backend::FlatValidator;
+using MyFlatEmitter = GeneralDeriver::Backend::FlatEmitter;
+using MyFuncEmitter = GeneralDeriver::Backend::FunctionEmitter;
+
+static constexpr std::array<const char*, 4> test_sources = {
+    "(x + 1)^2 - (x + 1)",
+    "sin(x^2) * (3 - 1) / 4 - ln(x + 3)",
+    "-(2 * 3)^2 + x * y - exp(z / 2)",
+    "((x))"
+};
+static constexpr const char* test_source_folded = "(2 * 3 - 1) / 4 + x * (8 / 2)";
+static constexpr const char* test_source_nan = "x / (3 * 2 - 6)";
+static constexpr std::array<double, 3> test_point = {0.75, -1.5, 2.0};
+
+int main() {
+    MyFlatAst buffer;
+    MyFlatParser flat_parser;
+    MyFlatValidator flat_validator;
+    MyFlatEmitter flat_emitter;
+    MyParser parser;
+    MyFuncEmitter emitter;
+
+    /// @note Flat output must agree with the tree pipeline.
+    for (const auto* source : test_sources) {
+        if (!flat_parser.parseAll(source, buffer) || !flat_validator.foldAst(buffer)) {
+            std::cerr << std::format("Unexpected flat parse or fold failure for \"{}\"\n", source);
+            return 1;
+        }
+
+        MyCompFunc flat_fn = flat_emitter.emitFunction(buffer);
+        MyCompFunc tree_fn = emitter.emitFunction(parser.parseAll(source).root);
+
+        if (flat_fn.evalAtPoint(test_point) != tree_fn.evalAtPoint(test_point)) {
+            std::cerr << std::format("Flat vs. tree mismatch for \"{}\": {} vs. {}\n", source, flat_fn.evalAtPoint(test_point), tree_fn.evalAtPoint(test_point));
+            return 1;
+        }
+    }
+
+    /// @note (2 * 3 - 1) / 4 + x * (8 / 2) should fold into 1.25 + x * 4, leaving only those nodes reachable.
+    if (!flat_parser.parseAll(test_source_folded, buffer) || !flat_validator.foldAst(buffer)) {
+        std::cerr << "Unexpected flat fold failure.\n";
+        return 1;
+    }
+
+    const auto root = buffer.getRoot();
+    const auto product = buffer.getRight(root);
+
+    if (buffer.getTag(buffer.getLeft(root)) != MyFlatTag::constant || buffer.getConstant(buffer.getLeft(root)) != 1.25
+        || buffer.getTag(product) != MyFlatTag::binary || buffer.getConstant(buffer.getRight(product)) != 4.0) {
+        std::cerr << "Constant sub-trees of the flat AST were not rewritten.\n";
+        return 1;
+    }
+
+    if (!flat_parser.parseAll(test_source_nan, buffer) || flat_validator.foldAst(buffer)) {
+        std::cerr << "Unexpected flat validation of NaN source.\n";
+        return 1;
+    }
+
+    /// @note Re-parsing a source no larger than before must reuse the buffer's storage.
+    [[maybe_unused]] bool warm_ok = flat_parser.parseAll(test_sources[1], buffer);
+    const auto first_size = buffer.getSize();
+    const auto first_capacity = buffer.getCapacity();
+
+    if (!flat_parser.parseAll(test_sources[0], buffer) || !flat_parser.parseAll(test_sources[1], buffer)
+        || buffer.getSize() != first_size || buffer.getCapacity() != first_capacity) {
+        std::cerr << "Flat AST buffer was not reused across parses.\n";
+        return 1;
+    }
+}
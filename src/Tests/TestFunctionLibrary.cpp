@@ -0,0 +1,117 @@
+/**
+ * @file TestFunctionLibrary.cpp
+ * @author DrkWithT
+ * @brief Implements tests for writing, mapping & evaluating compiled function libraries.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <array>
+#include <cmath>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "Models/Composite.hpp"
+#include "Models/FunctionLibrary.hpp"
+#include "Tests/TestSupport.hpp"
+
+using MyCompFunc = GeneralDeriver::Models::Composite;
+using MyLibraryWriter = GeneralDeriver::Models::LibraryWriter;
+using MyMappedLibrary = GeneralDeriver::Models::MappedLibrary;
+
+using GeneralDeriver::Tests::emitSource;
+using GeneralDeriver::Tests::isClose;
+
+struct NamedSource {
+    const char* name;
+    const char* source;
+};
+
+static constexpr std::array<NamedSource, 5> test_sources {{
+    {"trig_product", "x * sin(x) + cos(x) ^ 3"},
+    {"rational", "1 / (x^2 + 1)"},
+    {"mixed", "exp(x) * ln(x + 2) - sqrt(x) / (x - 3)"},
+    {"poly", "3 * x^4 - 2 * x + 7"},
+    {"exp_power", "2 ^ x + x ^ x"}
+}};
+static constexpr std::array<double, 4> test_xs = {0.25, 0.5, 1.5, 2.75};
+
+int main() {
+    const auto path = (std::filesystem::temp_directory_path() / std::format("gd_library_test_{}.bin", static_cast<unsigned long>(::getpid()))).string();
+    std::vector<MyCompFunc> functions;
+    MyLibraryWriter writer;
+
+    for (const auto& [name, source] : test_sources) {
+        functions.push_back(emitSource(source));
+        writer.addFunction(name, functions.back(), functions.back().makeDerivative());
+    }
+
+    if (!writer.writeFile(path)) {
+        std::cerr << "Could not write library to " << path << '\n';
+        return 1;
+    }
+
+    {
+        auto library = MyMappedLibrary::open(path);
+
+        if (!library || library->getEntryCount() != test_sources.size()) {
+            std::cerr << "Written library should map with every entry\n";
+            return 1;
+        }
+
+        for (std::size_t i = 0; i < test_sources.size(); i++) {
+            const auto item = library->find(test_sources[i].name);
+
+            if (!item || item->derivative.isEmpty()) {
+                std::cerr << std::format("Missing entry or derivative for {}\n", test_sources[i].name);
+                return 1;
+            }
+
+            const auto derivative = functions[i].makeDerivative();
+            std::vector<double> scratch (std::max(item->function.getNodeCount(), item->derivative.getNodeCount()));
+
+            for (double x : test_xs) {
+                const std::array<double, 1> point {x};
+                const double fx = item->function.evalAt(point, scratch);
+                const double dfx = item->derivative.evalAt(point, scratch);
+
+                if (!isClose(fx, functions[i].evalAt(x)) || !isClose(dfx, derivative.getStoragePtr()->evalAt(x))) {
+                    std::cerr << std::format("{} at {}: mapped f = {}, f' = {}, expected {} & {}\n", test_sources[i].name, x, fx, dfx, functions[i].evalAt(x), derivative.getStoragePtr()->evalAt(x));
+                    return 1;
+                }
+            }
+        }
+
+        if (library->find("unknown") || library->find("")) {
+            std::cerr << "Unknown names should not match\n";
+            return 1;
+        }
+    }
+
+    // Truncating the image past its header leaves sections out of bounds, which opening must catch.
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) / 2);
+
+    if (MyMappedLibrary::open(path)) {
+        std::cerr << "Truncated library should not map\n";
+        return 1;
+    }
+
+    {
+        std::ofstream fout {path, std::ios::binary | std::ios::trunc};
+        fout << std::string(256, 'z');
+    }
+
+    const bool opened_garbage = MyMappedLibrary::open(path).has_value();
+    std::filesystem::remove(path);
+
+    if (opened_garbage || MyMappedLibrary::open(path)) {
+        std::cerr << "Foreign or missing files should not map\n";
+        return 1;
+    }
+}
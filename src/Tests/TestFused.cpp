@@ -0,0 +1,87 @@
+/**
+ * @file TestFused.cpp
+ * @author DrkWithT
+ * @brief Implements single-pass compiler tests: folding, NaN rejection & parity with the AST pipeline.
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#include <iostream>
+#include <format>
+#include "Models/Composite.hpp"
+#include "Frontend/Parser.hpp"
+#include "Backend/FuncEmitter.hpp"
+#include "Backend/FusedCompiler.hpp"
+
+using MyCompFunc = GeneralDeriver::Models::Composite;
+using MyParser = GeneralDeriver::Frontend::Parser;
+using MyFuncEmitter = GeneralDeriver::Backend::FunctionEmitter;
+using MyFusedCompiler = GeneralDeriver::Backend::FusedCompiler;
+
+static constexpr const char* test_source_1 = "(x + 1)^2 - (x + 1)";
+static constexpr const char* test_source_2 = "(1 + 2)^2 - x";
+static constexpr const char* test_source_3 = "x + 0^(2 - 2)";
+static constexpr const char* test_source_4 = "x + 0^-1";
+static constexpr const char* test_source_5 = "(2 * x + 6 / 4) / (x - 1)";
+static constexpr const char* test_source_6 = "x / (4 - 2 * 2)";
+static constexpr double test_x = 3;
+static constexpr double test_output_2 = 6;
+
+int main() {
+    MyFusedCompiler compiler;
+
+    /// @note Fused output must agree with the multi-pass parse & emit output, including the derivative.
+    auto fused_1 = compiler.compileAll(test_source_1);
+
+    MyParser parser;
+    auto parse_result_1 = parser.parseAll(test_source_1);
+    MyFuncEmitter emitter;
+    MyCompFunc emitted_1 = emitter.emitFunction(parse_result_1.root);
+
+    if (!fused_1.ok || fused_1.function.evalAt(test_x) != emitted_1.evalAt(test_x)) {
+        std::cerr << std::format("Unexpected fused output of f(x) = {}\n", test_source_1);
+        return 1;
+    }
+
+    double fused_dx = fused_1.function.makeDerivative().unpackFunctionAny<MyCompFunc>().evalAt(test_x);
+    double emitted_dx = emitted_1.makeDerivative().unpackFunctionAny<MyCompFunc>().evalAt(test_x);
+
+    if (fused_dx != emitted_dx) {
+        std::cerr << std::format("Unexpected fused output of d/dx({}): {} vs. {}\n", test_source_1, fused_dx, emitted_dx);
+        return 1;
+    }
+
+    /// @note The constant subtree `(1 + 2)^2` must fold to one leaf, leaving only the subtraction.
+    auto fused_2 = compiler.compileAll(test_source_2);
+
+    if (!fused_2.ok || fused_2.function.getOp() != GeneralDeriver::Syntax::AstOpType::sub || fused_2.function.evalAt(test_x) != test_output_2) {
+        std::cerr << std::format("Unexpected fold of f(x) = {}\n", test_source_2);
+        return 1;
+    }
+
+    if (compiler.compileAll(test_source_3).ok) {
+        std::cerr << std::format("Unexpected compile of NaN source \"{}\"\n", test_source_3);
+        return 1;
+    }
+
+    if (compiler.compileAll(test_source_4).ok) {
+        std::cerr << std::format("Unexpected compile of NaN source \"{}\"\n", test_source_4);
+        return 1;
+    }
+
+    /// @note Factors follow the same precedence in both pipelines.
+    auto fused_5 = compiler.compileAll(test_source_5);
+    MyCompFunc emitted_5 = emitter.emitFunction(parser.parseAll(test_source_5).root);
+
+    if (!fused_5.ok || fused_5.function.evalAt(test_x) != emitted_5.evalAt(test_x) || fused_5.function.evalAt(test_x) != 3.75) {
+        std::cerr << std::format("Unexpected fused output of f(x) = {}\n", test_source_5);
+        return 1;
+    }
+
+    if (compiler.compileAll(test_source_6).ok) {
+        std::cerr << std::format("Unexpected compile of NaN source \"{}\"\n", test_source_6);
+        return 1;
+    }
+}
@@ -0,0 +1,128 @@
+/**
+ * @file TestGradient.cpp
+ * @author DrkWithT
+ * @brief Implements tests for multi-variable functions & reverse-mode gradients.
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <format>
+#include <string>
+#include <vector>
+#include "Models/Composite.hpp"
+#include "Models/Tape.hpp"
+#include "Frontend/Parser.hpp"
+#include "Backend/FuncEmitter.hpp"
+#include "Backend/FusedCompiler.hpp"
+#include "Tests/TestSupport.hpp"
+
+using MyCompFunc = GeneralDeriver::Models::Composite;
+using MyTape = GeneralDeriver::Models::Tape;
+using MyEvaluator = GeneralDeriver::Models::AdjointEvaluator;
+using MyParser = GeneralDeriver::Frontend::Parser;
+using MyFuncEmitter = GeneralDeriver::Backend::FunctionEmitter;
+using MyFusedCompiler = GeneralDeriver::Backend::FusedCompiler;
+
+using GeneralDeriver::Tests::isClose;
+
+static constexpr const char* test_source_1 = "x^2 + sin(y) - ln(z + 2) + y^3 - exp(x - z)";
+static constexpr std::array<double, 3> test_point = {0.5, 1.25, 0.3};
+
+[[nodiscard]] double getExpectedValue(double x, double y, double z) {
+    return x * x + std::sin(y) - std::log(z + 2) + y * y * y - std::exp(x - z);
+}
+
+[[nodiscard]] std::array<double, 3> getExpectedGradient(double x, double y, double z) {
+    return {
+        2 * x - std::exp(x - z),
+        std::cos(y) + 3 * y * y,
+        -1 / (z + 2) + std::exp(x - z)
+    };
+}
+
+[[nodiscard]] bool checkGradient(const MyCompFunc& fn, const char* label) {
+    MyTape tape {fn};
+    MyEvaluator evaluator {tape};
+    std::array<double, 3> gradient {};
+
+    if (tape.getSlotCount() != gradient.size()) {
+        std::cerr << std::format("{}: expected 3 slots, got {}\n", label, tape.getSlotCount());
+        return false;
+    }
+
+    const auto [x, y, z] = test_point;
+    const auto expected = getExpectedGradient(x, y, z);
+    double value = evaluator.gradientAt(test_point, gradient);
+
+    if (!isClose(value, getExpectedValue(x, y, z))) {
+        std::cerr << std::format("{}: gradient sweep gave f = {}\n", label, value);
+        return false;
+    }
+
+    for (std::size_t slot = 0; slot < gradient.size(); slot++) {
+        if (!isClose(gradient[slot], expected[slot])) {
+            std::cerr << std::format("{}: partial {} is {}, expected {}\n", label, slot, gradient[slot], expected[slot]);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int main() {
+    MyParser parser;
+    MyFuncEmitter emitter;
+
+    auto [ast, variables, parse_ok] = parser.parseAll(test_source_1);
+
+    if (!parse_ok) {
+        std::cerr << "Unexpected parse failure of test_source_1\n";
+        return 1;
+    }
+
+    if (variables != std::vector<std::string> {"x", "y", "z"}) {
+        std::cerr << "Unexpected variable slots of test_source_1\n";
+        return 1;
+    }
+
+    MyCompFunc fn = emitter.emitFunction(ast);
+    const auto [x, y, z] = test_point;
+
+    if (!isClose(fn.evalAtPoint(test_point), getExpectedValue(x, y, z))) {
+        std::cerr << std::format("Point evaluation gave {}\n", fn.evalAtPoint(test_point));
+        return 1;
+    }
+
+    if (!std::isnan(fn.evalAt(x))) {
+        std::cerr << "x-only evaluation should be NaN with y & z unbound\n";
+        return 1;
+    }
+
+    if (!checkGradient(fn, "emitted")) {
+        return 1;
+    }
+
+    MyFusedCompiler fused;
+    auto [fused_fn, fused_variables, fused_ok] = fused.compileAll(test_source_1);
+
+    if (!fused_ok || fused_variables != variables || !checkGradient(fused_fn, "fused")) {
+        std::cerr << "Fused compile disagrees with the parse & emit pipeline\n";
+        return 1;
+    }
+
+    // d/dx from the symbolic rules must match the slot-0 partial, and its shared sub-trees must flatten to single tape nodes.
+    auto derivative = fn.makeDerivative();
+    MyTape derivative_tape {*derivative.getStoragePtr()};
+    MyEvaluator derivative_eval {derivative_tape};
+    double symbolic_dx = derivative.getStoragePtr()->evalAtPoint(test_point);
+
+    if (!isClose(symbolic_dx, getExpectedGradient(x, y, z)[0]) || !isClose(derivative_eval.evalAt(test_point), symbolic_dx)) {
+        std::cerr << std::format("Symbolic d/dx = {}, tape d/dx = {}\n", symbolic_dx, derivative_eval.evalAt(test_point));
+        return 1;
+    }
+}
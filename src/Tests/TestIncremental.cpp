@@ -0,0 +1,122 @@
+/**
+ * @file TestIncremental.cpp
+ * @author DrkWithT
+ * @brief Implements incremental compiler tests: edited sources must match a fresh compile while reusing unchanged sub-expressions.
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#include <iostream>
+#include <format>
+#include <limits>
+#include <string>
+#include "Models/Composite.hpp"
+#include "Backend/FusedCompiler.hpp"
+#include "Backend/IncrementalCompiler.hpp"
+
+using MyCompFunc = GeneralDeriver::Models::Composite;
+using MyFusedCompiler = GeneralDeriver::Backend::FusedCompiler;
+using MyIncrementalCompiler = GeneralDeriver::Backend::IncrementalCompiler;
+
+static constexpr const char* test_source_1 = "(x - 1)^3 + (x + 2)^2 - (x - 3)^2 + (x + 4)^3 - x^2";
+static constexpr const char* test_source_2 = "(x - 1)^3 + (x + 2)^2 - (x - 5)^2 + (x + 4)^3 - x^2";
+static constexpr const char* test_source_3 = "(x - 1)^3 + (x + 2)^2 - (x - 5 + 0^0)^2 + (x + 4)^3 - x^2";
+static constexpr const char* test_source_4 = "(x - 1)^3 + (x + 2)^2 - (x - 15 + 7)^2 + (x + 4)^3 - x^2";
+static constexpr double test_x = 1.5;
+static constexpr std::size_t flat_sum_terms = 200;
+static constexpr std::size_t any_count = std::numeric_limits<std::size_t>::max();
+
+/// @note Gives `(x + 1)^2 + (x + 2)^2 + ...`, whose top-level chain is one flat sum.
+[[nodiscard]] std::string makeFlatSum(std::size_t term_count) {
+    std::string source = "(x + 1)^2";
+
+    for (std::size_t k = 2; k <= term_count; k++) {
+        source += std::format(" + (x + {})^2", k);
+    }
+
+    return source;
+}
+
+[[nodiscard]] bool matchesFreshCompile(MyIncrementalCompiler& compiler, const std::string& source, std::size_t min_reused, std::size_t max_combined) {
+    auto result = compiler.compile(source);
+    MyFusedCompiler fresh_compiler;
+    auto fresh = fresh_compiler.compileAll(source);
+
+    if (!result.ok || !fresh.ok) {
+        std::cerr << std::format("Unexpected compile failure for \"{}\"\n", source);
+        return false;
+    }
+
+    double y = result.function.evalAt(test_x);
+    double dy = result.derivative.getStoragePtr()->evalAt(test_x);
+    double fresh_y = fresh.function.evalAt(test_x);
+    double fresh_dy = fresh.function.makeDerivative().getStoragePtr()->evalAt(test_x);
+
+    if (y != fresh_y || dy != fresh_dy) {
+        std::cerr << std::format("Mismatch vs. fresh compile of \"{}\": f = {} vs. {}, f' = {} vs. {}\n", source, y, fresh_y, dy, fresh_dy);
+        return false;
+    }
+
+    if (result.reused_tokens < min_reused) {
+        std::cerr << std::format("Too few reused tokens for \"{}\": {}\n", source, result.reused_tokens);
+        return false;
+    }
+
+    if (result.combined_count > max_combined) {
+        std::cerr << std::format("Too many folds for \"{}\": {}\n", source.substr(0, 40), result.combined_count);
+        return false;
+    }
+
+    return true;
+}
+
+int main() {
+    MyIncrementalCompiler compiler;
+
+    if (!matchesFreshCompile(compiler, test_source_1, 0, any_count)) {
+        return 1;
+    }
+
+    /// @note Only `(x - 3)^2` changed, so the 4 other powers (24 tokens) are reused.
+    if (!matchesFreshCompile(compiler, test_source_2, 24, any_count)) {
+        return 1;
+    }
+
+    if (compiler.compile(test_source_3).ok) {
+        std::cerr << std::format("Unexpected compile of NaN source \"{}\"\n", test_source_3);
+        return 1;
+    }
+
+    if (!matchesFreshCompile(compiler, test_source_2, 0, any_count)) {
+        return 1;
+    }
+
+    /// @note This edit grows the source, so the reused tail powers are found at shifted token spans.
+    if (!matchesFreshCompile(compiler, test_source_4, 24, any_count)) {
+        return 1;
+    }
+
+    // Long flat sum of 7-token powers: every edit below keeps at least the other 199 powers.
+    MyIncrementalCompiler sum_compiler;
+    const std::string flat_sum = makeFlatSum(flat_sum_terms) + " + x";
+    const std::size_t kept_power_tokens = 7 * (flat_sum_terms - 1);
+
+    if (!matchesFreshCompile(sum_compiler, makeFlatSum(flat_sum_terms), 0, any_count)) {
+        return 1;
+    }
+
+    /// @note Appending resumes the sum from its step before the last power, whose `^2` may have grown into the edit. So only that power, the last step & the new one get folded, not all 200 steps.
+    if (!matchesFreshCompile(sum_compiler, flat_sum, kept_power_tokens, 4)) {
+        return 1;
+    }
+
+    /// @note Editing the 150th term refolds it and the 51 steps after it, including `+ x`, but resumes from the 149 steps before it.
+    std::string middle_edit = flat_sum;
+    middle_edit.replace(middle_edit.find("(x + 150)"), 9, "(x - 150)");
+
+    if (!matchesFreshCompile(sum_compiler, middle_edit, kept_power_tokens, 60)) {
+        return 1;
+    }
+}
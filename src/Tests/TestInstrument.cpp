@@ -0,0 +1,86 @@
+/**
+ * @file TestInstrument.cpp
+ * @author DrkWithT
+ * @brief Implements tests for pipeline stage timers, node counts & trace export.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <iostream>
+#include <sstream>
+#include "Frontend/Parser.hpp"
+#include "Backend/FuncEmitter.hpp"
+#include "Models/Composite.hpp"
+#include "Utils/Instrument.hpp"
+
+using MyStage = GeneralDeriver::Utils::Stage;
+using MyStageTimer = GeneralDeriver::Utils::StageTimer;
+using MyParser = GeneralDeriver::Frontend::Parser;
+using MyFuncEmitter = GeneralDeriver::Backend::FunctionEmitter;
+
+static constexpr const char* test_source = "sin(x) * x + exp(x)";
+static constexpr std::size_t test_ast_nodes = 7; // sin, x, *, x, +, exp, x
+
+[[nodiscard]] const GeneralDeriver::Utils::StageStats& getStage(const GeneralDeriver::Utils::PipelineStats& stats, MyStage stage) {
+    return stats.stages[static_cast<std::size_t>(stage)];
+}
+
+int main() {
+    if constexpr (!GeneralDeriver::Utils::instrument_enabled) {
+        return 0;
+    }
+
+    GeneralDeriver::Utils::resetStats();
+    GeneralDeriver::Utils::startTrace();
+
+    MyParser parser;
+    MyFuncEmitter emitter;
+    GeneralDeriver::Frontend::ParseResult parsed {nullptr, {}, false};
+    GeneralDeriver::Models::Composite fn;
+
+    {
+        MyStageTimer timer {MyStage::parse};
+        parsed = parser.parseAll(test_source);
+    }
+
+    {
+        MyStageTimer timer {MyStage::emit};
+        fn = emitter.emitFunction(parsed.root);
+    }
+
+    {
+        MyStageTimer timer {MyStage::derive};
+        auto derivative = fn.makeDerivative();
+    }
+
+    const auto stats = GeneralDeriver::Utils::readStats();
+
+    if (getStage(stats, MyStage::parse).calls != 1 || getStage(stats, MyStage::parse).nodes != test_ast_nodes) {
+        std::cerr << "Parse stage should count one call and every AST node\n";
+        return 1;
+    }
+
+    // Function nodes made while emitting & deriving land on their own stages, not on the parse stage.
+    if (getStage(stats, MyStage::emit).nodes == 0 || getStage(stats, MyStage::derive).nodes == 0 || getStage(stats, MyStage::lex).calls != 0) {
+        std::cerr << "Emit & derive stages should count their own nodes\n";
+        return 1;
+    }
+
+    std::ostringstream trace;
+    GeneralDeriver::Utils::writeChromeTrace(trace);
+    const std::string trace_text = trace.str();
+
+    if (!trace_text.starts_with("{\"traceEvents\":[{") || trace_text.find("\"name\":\"derive\"") == std::string::npos) {
+        std::cerr << "Unexpected Chrome trace: " << trace_text;
+        return 1;
+    }
+
+    GeneralDeriver::Utils::resetStats();
+
+    if (GeneralDeriver::Utils::readStats().stages[static_cast<std::size_t>(MyStage::emit)].nodes != 0) {
+        std::cerr << "Reset should clear every counter\n";
+        return 1;
+    }
+}
@@ -0,0 +1,142 @@
+/**
+ * @file TestKernels.cpp
+ * @author DrkWithT
+ * @brief Implements tests for elementary function kernels, batch evaluation & their derivative rules.
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <format>
+#include <vector>
+#include "Models/MathKernels.hpp"
+#include "Models/Composite.hpp"
+#include "Tests/TestSupport.hpp"
+
+using MyCompFunc = GeneralDeriver::Models::Composite;
+using MyKernel = void (*)(std::span<const double>, std::span<double>);
+using MyFloatKernel = void (*)(std::span<const float>, std::span<float>);
+using MyReference = double (*)(double);
+
+using GeneralDeriver::Tests::emitSource;
+
+static constexpr std::size_t sample_count = 100003; // odd count, so the padded lane group gets used
+
+static constexpr const char* test_source_1 = "sin(x)^2 + cos(x)^2 - exp(ln(x + 2)) + sqrt(x + 4)";
+static constexpr const char* test_source_2 = "sin(x^2) - ln(x + 3)";
+static constexpr double test_x = 0.75;
+
+[[nodiscard]] std::int64_t getUlpDistance(double a, double b) {
+    if (std::isnan(a) || std::isnan(b)) {
+        return (std::isnan(a) && std::isnan(b)) ? 0 : INT64_MAX;
+    }
+
+    auto a_bits = std::bit_cast<std::int64_t>(a);
+    auto b_bits = std::bit_cast<std::int64_t>(b);
+    a_bits = (a_bits < 0) ? INT64_MIN - a_bits : a_bits;
+    b_bits = (b_bits < 0) ? INT64_MIN - b_bits : b_bits;
+
+    return (a_bits > b_bits) ? a_bits - b_bits : b_bits - a_bits;
+}
+
+/// @note Error bounds must match the ones documented in MathKernels.hpp.
+[[nodiscard]] bool checkKernel(const char* name, MyKernel kernel, MyReference reference, double lo, double hi, std::int64_t max_ulp) {
+    std::vector<double> xs (sample_count);
+    std::vector<double> ys (sample_count);
+
+    for (std::size_t i = 0; i < sample_count; i++) {
+        xs[i] = lo + (hi - lo) * static_cast<double>(i) / (sample_count - 1);
+    }
+
+    kernel(xs, ys);
+
+    for (std::size_t i = 0; i < sample_count; i++) {
+        if (getUlpDistance(ys[i], reference(xs[i])) > max_ulp) {
+            std::cerr << std::format("{} kernel is off at x = {}: {} vs. {}\n", name, xs[i], ys[i], reference(xs[i]));
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/// @note Float kernels get checked against the double reference rounded to float, in float ULPs.
+[[nodiscard]] bool checkFloatKernel(const char* name, MyFloatKernel kernel, MyReference reference, double lo, double hi, std::int32_t max_ulp) {
+    std::vector<float> xs (sample_count);
+    std::vector<float> ys (sample_count);
+
+    for (std::size_t i = 0; i < sample_count; i++) {
+        xs[i] = static_cast<float>(lo + (hi - lo) * static_cast<double>(i) / (sample_count - 1));
+    }
+
+    kernel(xs, ys);
+
+    for (std::size_t i = 0; i < sample_count; i++) {
+        const auto expected = static_cast<float>(reference(xs[i]));
+        auto actual_bits = std::bit_cast<std::int32_t>(ys[i]);
+        auto expected_bits = std::bit_cast<std::int32_t>(expected);
+        actual_bits = (actual_bits < 0) ? INT32_MIN - actual_bits : actual_bits;
+        expected_bits = (expected_bits < 0) ? INT32_MIN - expected_bits : expected_bits;
+
+        if (std::abs(static_cast<std::int64_t>(actual_bits) - expected_bits) > max_ulp) {
+            std::cerr << std::format("{} float kernel is off at x = {}: {} vs. {}\n", name, xs[i], ys[i], expected);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int main() {
+    if (!checkKernel("exp", GeneralDeriver::Models::expBatch, [](double x) { return std::exp(x); }, -700.0, 700.0, 1)
+        || !checkKernel("ln", GeneralDeriver::Models::lnBatch, [](double x) { return std::log(x); }, 1e-300, 1e6, 1)
+        || !checkKernel("ln near 1", GeneralDeriver::Models::lnBatch, [](double x) { return std::log(x); }, 0.5, 2.0, 1)
+        || !checkKernel("sin", GeneralDeriver::Models::sinBatch, [](double x) { return std::sin(x); }, -100.0, 100.0, 1)
+        || !checkKernel("cos", GeneralDeriver::Models::cosBatch, [](double x) { return std::cos(x); }, -100.0, 100.0, 1)
+        || !checkKernel("sin (wide)", GeneralDeriver::Models::sinBatch, [](double x) { return std::sin(x); }, -1e6, 1e6, 2)
+        || !checkKernel("cos (wide)", GeneralDeriver::Models::cosBatch, [](double x) { return std::cos(x); }, -1e6, 1e6, 2)
+        || !checkKernel("sqrt", GeneralDeriver::Models::sqrtBatch, [](double x) { return std::sqrt(x); }, 0.0, 1e6, 0)) {
+        return 1;
+    }
+
+    if (!checkFloatKernel("exp", GeneralDeriver::Models::expBatch, [](double x) { return std::exp(x); }, -87.0, 88.0, 1)
+        || !checkFloatKernel("ln", GeneralDeriver::Models::lnBatch, [](double x) { return std::log(x); }, 1e-30, 1e6, 1)
+        || !checkFloatKernel("sin", GeneralDeriver::Models::sinBatch, [](double x) { return std::sin(x); }, -100.0, 100.0, 1)
+        || !checkFloatKernel("cos", GeneralDeriver::Models::cosBatch, [](double x) { return std::cos(x); }, -100.0, 100.0, 1)
+        || !checkFloatKernel("sqrt", GeneralDeriver::Models::sqrtBatch, [](double x) { return std::sqrt(x); }, 0.0, 1e6, 0)) {
+        return 1;
+    }
+
+    /// @note Batch evaluation of a function tree must agree with point-wise evaluation.
+    MyCompFunc fn_1 = emitSource(test_source_1);
+    std::vector<double> xs (sample_count);
+    std::vector<double> ys (sample_count);
+
+    for (std::size_t i = 0; i < sample_count; i++) {
+        xs[i] = -1.5 + 10.0 * static_cast<double>(i) / sample_count;
+    }
+
+    fn_1.evalBatch(xs, ys);
+
+    for (std::size_t i = 0; i < sample_count; i++) {
+        if (std::abs(ys[i] - fn_1.evalAt(xs[i])) > 1e-12) {
+            std::cerr << std::format("Batch mismatch for f(x) = {} at x = {}: {} vs. {}\n", test_source_1, xs[i], ys[i], fn_1.evalAt(xs[i]));
+            return 1;
+        }
+    }
+
+    /// @note d/dx(sin(x^2) - ln(x + 3)) = 2x cos(x^2) - 1 / (x + 3)
+    MyCompFunc fn_2 = emitSource(test_source_2);
+    double dx_y = fn_2.makeDerivative().getStoragePtr()->evalAt(test_x);
+    double expected_dx_y = 2 * test_x * std::cos(test_x * test_x) - 1 / (test_x + 3);
+
+    if (std::abs(dx_y - expected_dx_y) > 1e-12) {
+        std::cerr << std::format("Unexpected output of d/dx({}): {} vs. {}\n", test_source_2, dx_y, expected_dx_y);
+        return 1;
+    }
+}
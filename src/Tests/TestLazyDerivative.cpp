@@ -0,0 +1,91 @@
+/**
+ * @file TestLazyDerivative.cpp
+ * @author DrkWithT
+ * @brief Implements tests for derivatives materialized on demand.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <array>
+#include <cmath>
+#include <format>
+#include <iostream>
+#include <vector>
+#include "Models/Composite.hpp"
+#include "Models/LazyDerivative.hpp"
+#include "Models/Tape.hpp"
+#include "Tests/TestSupport.hpp"
+
+using MyCompFunc = GeneralDeriver::Models::Composite;
+using MyFunctionAny = GeneralDeriver::Models::FunctionAny;
+using MyLazy = GeneralDeriver::Models::LazyDerivative;
+using MyTape = GeneralDeriver::Models::Tape;
+using MyEvaluator = GeneralDeriver::Models::AdjointEvaluator;
+
+using GeneralDeriver::Tests::emitSource;
+using GeneralDeriver::Tests::isClose;
+
+static constexpr const char* test_source = "x * sin(x) + exp(x^2) / (x + 1) + cos(x)^3 - ln(x + 2) + sqrt(x + 1)";
+static constexpr std::array<double, 4> test_xs = {0.25, 0.7, 1.5, 3.0};
+
+[[nodiscard]] const MyLazy* asLazy(const MyFunctionAny& fn) {
+    return dynamic_cast<const MyLazy*>(fn.getStoragePtr());
+}
+
+int main() {
+    MyFunctionAny fn = emitSource(test_source);
+    MyFunctionAny eager = fn.getStoragePtr()->makeDerivative();
+    MyFunctionAny lazy = GeneralDeriver::Models::makeLazyDerivative(fn);
+
+    // Point evaluations walk the source forward-mode, so they match the eager derivative without building one.
+    for (double x : test_xs) {
+        if (!isClose(lazy.getStoragePtr()->evalAt(x), eager.getStoragePtr()->evalAt(x))) {
+            std::cerr << std::format("Lazy d/dx = {} vs eager {} at x = {}\n", lazy.getStoragePtr()->evalAt(x), eager.getStoragePtr()->evalAt(x), x);
+            return 1;
+        }
+    }
+
+    if (!asLazy(lazy) || asLazy(lazy)->isMaterialized()) {
+        std::cerr << "Point evaluations should not materialize the derivative\n";
+        return 1;
+    }
+
+    // Materializing the root builds one level: the top sum's children stay deferred until reached.
+    const auto& derived = asLazy(lazy)->getDerived().unpackFunctionAny<MyCompFunc>();
+    const auto* deferred_child = asLazy(derived.getRight());
+
+    if (!asLazy(lazy)->isMaterialized() || !deferred_child || deferred_child->isMaterialized()) {
+        std::cerr << "Materializing the root should defer its children\n";
+        return 1;
+    }
+
+    std::vector<double> lazy_out(test_xs.size());
+    std::vector<double> eager_out(test_xs.size());
+    lazy.getStoragePtr()->evalBatch(test_xs, lazy_out);
+    eager.getStoragePtr()->evalBatch(test_xs, eager_out);
+
+    for (std::size_t i = 0; i < test_xs.size(); i++) {
+        if (!isClose(lazy_out[i], eager_out[i])) {
+            std::cerr << std::format("Lazy batch d/dx = {} vs eager {} at x = {}\n", lazy_out[i], eager_out[i], test_xs[i]);
+            return 1;
+        }
+    }
+
+    // Second derivatives stay lazy, and compiling one to a tape materializes every level it reaches.
+    MyFunctionAny lazy_2 = lazy.getStoragePtr()->makeDerivative();
+    MyFunctionAny eager_2 = eager.getStoragePtr()->makeDerivative();
+    MyTape tape_2 {*lazy_2.getStoragePtr()};
+    MyEvaluator evaluator_2 {tape_2};
+
+    for (double x : test_xs) {
+        const std::array<double, 1> point {x};
+        const double expected = eager_2.getStoragePtr()->evalAt(x);
+
+        if (!isClose(lazy_2.getStoragePtr()->evalAt(x), expected) || !isClose(evaluator_2.evalAt(point), expected)) {
+            std::cerr << std::format("Lazy d2/dx2 = {}, tape d2/dx2 = {} vs eager {} at x = {}\n", lazy_2.getStoragePtr()->evalAt(x), evaluator_2.evalAt(point), expected, x);
+            return 1;
+        }
+    }
+}
@@ -49,7 +49,7 @@ int main() {
     };
 
     std::vector<MyToken> expected_tokens_2 = {
-        MyToken {0, 1, MyTokenTag::unknown},
+        MyToken {0, 1, MyTokenTag::variable},
         {1, 1, MyTokenTag::spacing},
         {2, 1, MyTokenTag::op_plus},
         {3, 1, MyTokenTag::spacing},
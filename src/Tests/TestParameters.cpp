@@ -0,0 +1,153 @@
+/**
+ * @file TestParameters.cpp
+ * @author DrkWithT
+ * @brief Implements tests for late-bound parameter evaluation of one compiled function & derivative, in double & single precision.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <cmath>
+#include <format>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Models/Composite.hpp"
+#include "Models/ParameterEvaluator.hpp"
+#include "Models/Tape.hpp"
+#include "Frontend/Parser.hpp"
+#include "Backend/FuncEmitter.hpp"
+#include "Tests/TestSupport.hpp"
+
+using MyCompFunc = GeneralDeriver::Models::Composite;
+using MyTape = GeneralDeriver::Models::Tape;
+using MyParamEvaluator = GeneralDeriver::Models::ParameterEvaluator;
+using MySingleEvaluator = GeneralDeriver::Models::SingleParameterEvaluator;
+using MyParser = GeneralDeriver::Frontend::Parser;
+using MyFuncEmitter = GeneralDeriver::Backend::FunctionEmitter;
+
+using GeneralDeriver::Tests::isClose;
+
+static constexpr const char* test_source_1 = "a*(x - b)^2 + c + sin(a*x)";
+static constexpr std::size_t test_set_count = 1000; // not a multiple of the lane width, so the last block is partial
+static constexpr double single_tolerance = 1e-5; // a few float roundings per node, relative to the largest term
+
+[[nodiscard]] double getExpectedValue(double x, double a, double b, double c) {
+    return a * (x - b) * (x - b) + c + std::sin(a * x);
+}
+
+[[nodiscard]] double getExpectedSlope(double x, double a, double b) {
+    return 2 * a * (x - b) + a * std::cos(a * x);
+}
+
+int main() {
+    MyParser parser;
+    MyFuncEmitter emitter;
+
+    auto [ast, variables, parse_ok] = parser.parseAll(test_source_1);
+
+    if (!parse_ok || variables != std::vector<std::string> {"x", "a", "b", "c"}) {
+        std::cerr << "Unexpected parse or variable slots of test_source_1\n";
+        return 1;
+    }
+
+    const auto a_index = GeneralDeriver::Models::findParameter(variables, "a");
+    const auto c_index = GeneralDeriver::Models::findParameter(variables, "c");
+
+    if (a_index != 0 || c_index != 2 || GeneralDeriver::Models::findParameter(variables, "x") || GeneralDeriver::Models::findParameter(variables, "q")) {
+        std::cerr << "findParameter should give block indices of a, b & c only\n";
+        return 1;
+    }
+
+    // Compile f & f' once, then bind every parameter set late.
+    MyCompFunc fn = emitter.emitFunction(ast);
+    auto derivative = fn.makeDerivative();
+    MyTape fn_tape {fn};
+    MyTape derivative_tape {*derivative.getStoragePtr()};
+    const std::size_t parameter_count = variables.size() - 1;
+
+    if (derivative_tape.getSlotCount() >= fn_tape.getSlotCount()) {
+        std::cerr << "f' should not read c, so its tape should have fewer slots\n";
+        return 1;
+    }
+
+    MyParamEvaluator fn_eval {fn_tape, parameter_count};
+    MyParamEvaluator derivative_eval {derivative_tape, parameter_count};
+
+    std::vector<double> xs(test_set_count);
+    std::vector<double> param_sets(test_set_count * parameter_count);
+
+    for (std::size_t i = 0; i < test_set_count; i++) {
+        xs[i] = -2.0 + 0.004 * static_cast<double>(i);
+        param_sets[i * parameter_count] = 0.5 + 0.001 * static_cast<double>(i);
+        param_sets[i * parameter_count + 1] = 1.0 - 0.002 * static_cast<double>(i);
+        param_sets[i * parameter_count + 2] = 0.01 * static_cast<double>(i % 17);
+    }
+
+    std::vector<double> values(test_set_count);
+    std::vector<double> slopes(test_set_count);
+
+    fn_eval.evalSets(xs, param_sets, values);
+    derivative_eval.evalSets(xs, param_sets, slopes);
+
+    for (std::size_t i = 0; i < test_set_count; i++) {
+        const double x = xs[i];
+        const double a = param_sets[i * parameter_count];
+        const double b = param_sets[i * parameter_count + 1];
+        const double c = param_sets[i * parameter_count + 2];
+        const std::vector<double> point {x, a, b, c};
+
+        if (!isClose(values[i], getExpectedValue(x, a, b, c)) || !isClose(values[i], fn.evalAtPoint(point))) {
+            std::cerr << std::format("Set {}: f = {}, expected {}\n", i, values[i], getExpectedValue(x, a, b, c));
+            return 1;
+        }
+
+        if (!isClose(slopes[i], getExpectedSlope(x, a, b))) {
+            std::cerr << std::format("Set {}: f' = {}, expected {}\n", i, slopes[i], getExpectedSlope(x, a, b));
+            return 1;
+        }
+    }
+
+    // One parameter block over many x, and the single-point form of it.
+    const std::vector<double> block {2.0, -0.5, 3.0};
+    fn_eval.evalBatch(xs, block, values);
+
+    for (std::size_t i = 0; i < test_set_count; i++) {
+        if (!isClose(values[i], getExpectedValue(xs[i], 2.0, -0.5, 3.0)) || values[i] != fn_eval.evalAt(xs[i], block)) {
+            std::cerr << std::format("Block batch at x = {} gave {}\n", xs[i], values[i]);
+            return 1;
+        }
+    }
+
+    // The same tapes in single precision, over float copies of the parameter sets.
+    MySingleEvaluator single_fn_eval {fn_tape, parameter_count};
+    MySingleEvaluator single_derivative_eval {derivative_tape, parameter_count};
+    const std::vector<float> single_xs(xs.begin(), xs.end());
+    const std::vector<float> single_param_sets(param_sets.begin(), param_sets.end());
+    std::vector<float> single_values(test_set_count);
+    std::vector<float> single_slopes(test_set_count);
+
+    single_fn_eval.evalSets(single_xs, single_param_sets, single_values);
+    single_derivative_eval.evalSets(single_xs, single_param_sets, single_slopes);
+
+    for (std::size_t i = 0; i < test_set_count; i++) {
+        const double x = single_xs[i];
+        const double a = single_param_sets[i * parameter_count];
+        const double b = single_param_sets[i * parameter_count + 1];
+        const double c = single_param_sets[i * parameter_count + 2];
+        const double scale = 1.0 + std::abs(a) * (x - b) * (x - b) + std::abs(c);
+
+        if (std::abs(single_values[i] - getExpectedValue(x, a, b, c)) > single_tolerance * scale || std::abs(single_slopes[i] - getExpectedSlope(x, a, b)) > single_tolerance * scale) {
+            std::cerr << std::format("Set {} in single precision: f = {}, f' = {}\n", i, single_values[i], single_slopes[i]);
+            return 1;
+        }
+    }
+
+    try {
+        MyParamEvaluator too_small {fn_tape, 1};
+        std::cerr << "A parameter block without room for c should be rejected\n";
+        return 1;
+    } catch (const std::invalid_argument&) {}
+}
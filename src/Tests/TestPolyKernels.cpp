@@ -0,0 +1,90 @@
+/**
+ * @file TestPolyKernels.cpp
+ * @author DrkWithT
+ * @brief Implements tests for dense polynomial multiplication kernels.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <format>
+#include <iostream>
+#include <vector>
+#include "Models/PolyAlgebra.hpp"
+#include "Models/PolyKernels.hpp"
+
+using MyMulMethod = GeneralDeriver::Models::MulMethod;
+using MyPoly = GeneralDeriver::Models::Polynomial;
+
+static constexpr std::size_t test_short_length = 100;
+static constexpr std::size_t test_long_length = 1500;
+static constexpr unsigned int test_binomial_power = 200;
+static constexpr double test_binomial_tolerance = 1e-12;
+
+/// @note Small LCG so the operands do not depend on the standard library's distributions.
+[[nodiscard]] std::vector<double> makeWholeCoeffs(std::size_t count, std::uint64_t seed) {
+    std::vector<double> coeffs;
+
+    for (std::size_t i = 0; i < count; i++) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        coeffs.push_back(static_cast<double>(static_cast<std::int64_t>(seed >> 54) - 512));
+    }
+
+    return coeffs;
+}
+
+[[nodiscard]] bool matchesSchoolbook(const std::vector<double>& lhs, const std::vector<double>& rhs, MyMulMethod method) {
+    return GeneralDeriver::Models::multiplyDenseWith(method, lhs, rhs) == GeneralDeriver::Models::multiplyDenseWith(MyMulMethod::schoolbook, lhs, rhs);
+}
+
+int main() {
+    const auto short_coeffs = makeWholeCoeffs(test_short_length, 1);
+    const auto long_coeffs = makeWholeCoeffs(test_long_length, 2);
+    const auto other_long_coeffs = makeWholeCoeffs(test_long_length, 3);
+
+    // Whole-number products stay far below 2^52 here, so every method must be exact.
+    if (!matchesSchoolbook(short_coeffs, long_coeffs, MyMulMethod::karatsuba) || !matchesSchoolbook(long_coeffs, other_long_coeffs, MyMulMethod::karatsuba)) {
+        std::cerr << "Unexpected Karatsuba product\n";
+        return 1;
+    }
+
+    if (GeneralDeriver::Models::pickMulMethod(long_coeffs, other_long_coeffs) != MyMulMethod::fft || !matchesSchoolbook(long_coeffs, other_long_coeffs, MyMulMethod::fft)) {
+        std::cerr << "Unexpected FFT product\n";
+        return 1;
+    }
+
+    // Coefficients 16 orders of magnitude apart would lose the small products under Karatsuba or FFT rounding.
+    std::vector<double> wide_coeffs(test_long_length, 1e-8);
+
+    for (std::size_t i = 0; i < wide_coeffs.size(); i += 2) {
+        wide_coeffs[i] = 1e8;
+    }
+
+    if (GeneralDeriver::Models::pickMulMethod(wide_coeffs, wide_coeffs) != MyMulMethod::schoolbook) {
+        std::cerr << "Unexpected fast method pick for wide-range coefficients\n";
+        return 1;
+    }
+
+    const std::vector<double> x_plus_one {1, 1};
+    const auto binomial = GeneralDeriver::Models::raiseDense(x_plus_one, test_binomial_power);
+    double expected = 1;
+
+    for (std::size_t k = 0; k <= test_binomial_power; k++) {
+        if (std::fabs(binomial[k] - expected) > test_binomial_tolerance * expected) {
+            std::cerr << std::format("Unexpected coefficient {} of (x + 1)^{}: {} vs. {}\n", k, test_binomial_power, binomial[k], expected);
+            return 1;
+        }
+
+        expected = expected * static_cast<double>(test_binomial_power - k) / static_cast<double>(k + 1);
+    }
+
+    const MyPoly expanded = GeneralDeriver::Models::raisePolynomial(MyPoly {{{1, 1}, {1, 0}}}, test_binomial_power);
+
+    if (expanded.getTerms().size() != test_binomial_power + 1 || expanded.getTerms().front().power != test_binomial_power) {
+        std::cerr << std::format("Unexpected terms of expanded (x + 1)^{}\n", test_binomial_power);
+        return 1;
+    }
+}
@@ -8,6 +8,8 @@
  * 
  */
 
+#include <array>
+#include <cmath>
 #include <iostream>
 #include <format>
 #include <vector>
@@ -16,11 +18,37 @@
 
 using MyPoly = GeneralDeriver::Models::Polynomial;
 using MyPolyTerm = GeneralDeriver::Models::PolynomialTerm;
+using MyPolyLayout = GeneralDeriver::Models::PolyLayout;
 
 static constexpr double eval_input_1 = 3.0; // test x-input value for foo function
 static constexpr double expected_output_1 = 16.0; // expected output of foo function
 static constexpr double eval_input_2 = 2.0; // test x-input value for deriv(foo)
 static constexpr double expected_output_2 = 6.0; // expected output of deriv(foo) function
+static constexpr double eval_input_3 = 1.0001; // test x-input value for the sparse & general polynomials
+static constexpr double eval_tolerance = 1e-12; // relative, as Horner's rule rounds differently than summing pow calls
+static constexpr std::array<double, 5> batch_inputs = {-2.0, 0.0, 0.5, 1.0001, 3.0};
+
+/// @note Checks evalAt & evalBatch against a sum of pow calls over the same terms.
+[[nodiscard]] bool matchesPowSum(const MyPoly& poly, const std::vector<MyPolyTerm>& terms) {
+    std::array<double, batch_inputs.size()> batch_out {};
+    poly.evalBatch(batch_inputs, batch_out);
+
+    for (std::size_t i = 0; i < batch_inputs.size(); i++) {
+        double expected = 0.0;
+
+        for (auto [coeff, power] : terms) {
+            expected += coeff * std::pow(batch_inputs[i], power);
+        }
+
+        const double allowed = eval_tolerance * std::fabs(expected);
+
+        if (std::fabs(poly.evalAt(batch_inputs[i]) - expected) > allowed || std::fabs(batch_out[i] - expected) > allowed) {
+            return false;
+        }
+    }
+
+    return true;
+}
 
 int main() {
     std::vector<MyPolyTerm> terms = {{1, 2}, {2, 1}, {1, 0}}; // for f(x) = x^2 + 2x + 1
@@ -48,4 +76,37 @@ int main() {
         std::cerr << std::format("Invalid output of foo: {} vs. expected {}\n", eval_output_2, expected_output_2) << '\n';
         return 1;
     }
-}
\ No newline at end of file
+
+    if (foo.getLayout() != MyPolyLayout::dense) {
+        std::cerr << "Unexpected layout of foo, expected dense\n";
+        return 1;
+    }
+
+    std::vector<MyPolyTerm> sparse_terms = {{1, 0}, {1, 10000}}; // x^10000 + 1, given out of order
+    MyPoly sparse_foo {sparse_terms};
+
+    if (sparse_foo.getLayout() != MyPolyLayout::sparse || sparse_foo.getTermCount() != 2 || sparse_foo.getTerms().front().power != 10000 || !matchesPowSum(sparse_foo, sparse_terms)) {
+        std::cerr << "Unexpected sparse polynomial for x^10000 + 1\n";
+        return 1;
+    }
+
+    MyPoly sparse_dx = sparse_foo.makeDerivative().unpackFunctionAny<MyPoly>();
+
+    if (sparse_dx.getTermCount() != 1 || std::fabs(sparse_dx.evalAt(eval_input_3) - 10000 * std::pow(eval_input_3, 9999)) > eval_tolerance * sparse_dx.evalAt(eval_input_3)) {
+        std::cerr << "Unexpected derivative of x^10000 + 1\n";
+        return 1;
+    }
+
+    std::vector<MyPolyTerm> general_terms = {{2, 0.5}, {-1, -1}, {3, 2}}; // 3x^2 + 2x^0.5 - x^-1
+    MyPoly general_foo {general_terms};
+
+    if (general_foo.getLayout() != MyPolyLayout::general || general_foo.evalAt(4.0) != 51.75) {
+        std::cerr << "Unexpected general polynomial for 3x^2 + 2x^0.5 - x^-1\n";
+        return 1;
+    }
+
+    if (!matchesPowSum(foo, terms)) {
+        std::cerr << "Unexpected batch output of foo\n";
+        return 1;
+    }
+}
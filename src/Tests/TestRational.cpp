@@ -0,0 +1,107 @@
+/**
+ * @file TestRational.cpp
+ * @author DrkWithT
+ * @brief Implements tests for polynomial GCDs and the rational normal form.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <cmath>
+#include <complex>
+#include <format>
+#include <iostream>
+#include <vector>
+#include "Models/Composite.hpp"
+#include "Models/PolyAlgebra.hpp"
+#include "Models/RationalFunction.hpp"
+#include "Frontend/Parser.hpp"
+#include "Backend/FuncEmitter.hpp"
+
+using MyCompFunc = GeneralDeriver::Models::Composite;
+using MyPoly = GeneralDeriver::Models::Polynomial;
+using MyRational = GeneralDeriver::Models::RationalFunction;
+using MyParser = GeneralDeriver::Frontend::Parser;
+using MyFuncEmitter = GeneralDeriver::Backend::FunctionEmitter;
+
+static constexpr const char* test_source_1 = "(x^2 - 1) / (x - 1)";
+static constexpr const char* test_source_2 = "1 / (x^2 + 1)";
+static constexpr const char* test_source_3 = "x / (x + 1) + 1 / (x + 1)";
+static constexpr int test_derivative_order = 6;
+static constexpr double test_x = 0.75;
+
+/// @note Unwraps the rational leaf of an emitted function, if the emitter made one.
+[[nodiscard]] const MyRational* findRational(const MyCompFunc& fn) {
+    return dynamic_cast<const MyRational*>(fn.getLeft().getStoragePtr());
+}
+
+int main() {
+    // gcd(x^3 - 2x^2 - x + 2, x^2 - 3x + 2) = (x - 1)(x - 2), as both share those roots.
+    auto common = GeneralDeriver::Models::gcdPolynomials(MyPoly::fromDense({2, -1, -2, 1}), MyPoly::fromDense({2, -3, 1}));
+
+    if (!common || common->getDenseCoeffs().size() != 3 || std::fabs(common->evalAt(1)) > 1e-12 || std::fabs(common->evalAt(2)) > 1e-12) {
+        std::cerr << "Unexpected GCD of (x - 1)(x - 2)(x + 1) and (x - 1)(x - 2)\n";
+        return 1;
+    }
+
+    auto coprime = GeneralDeriver::Models::gcdPolynomials(MyPoly::fromDense({1, 0, 1}), MyPoly::fromDense({-1, 1}));
+
+    if (!coprime || GeneralDeriver::Models::getConstantValue(*coprime) != 1.0) {
+        std::cerr << "Unexpected GCD of coprime x^2 + 1 and x - 1\n";
+        return 1;
+    }
+
+    MyParser parser;
+    MyFuncEmitter emitter;
+
+    // Cancelling the common x - 1 leaves a plain polynomial leaf.
+    MyCompFunc cancelled_1 = emitter.emitFunction(parser.parseAll(test_source_1).root);
+    const auto* cancelled_poly = dynamic_cast<const MyPoly*>(cancelled_1.getLeft().getStoragePtr());
+
+    if (!cancelled_poly || cancelled_poly->getDenseCoeffs().size() != 2 || std::fabs(cancelled_1.evalAt(test_x) - (test_x + 1)) > 1e-15) {
+        std::cerr << std::format("Unexpected normal form of f(x) = {}\n", test_source_1);
+        return 1;
+    }
+
+    MyCompFunc summed_3 = emitter.emitFunction(parser.parseAll(test_source_3).root);
+
+    if (std::fabs(summed_3.evalAt(test_x) - 1) > 1e-15 || findRational(summed_3)) {
+        std::cerr << std::format("Unexpected normal form of f(x) = {}\n", test_source_3);
+        return 1;
+    }
+
+    // Each derivative of 1 / (x^2 + 1) adds only the square-free x^2 + 1 to the denominator, so order n has degree 2(n + 1).
+    MyCompFunc fn_2 = emitter.emitFunction(parser.parseAll(test_source_2).root);
+
+    for (int order = 1; order <= test_derivative_order; order++) {
+        fn_2 = fn_2.makeDerivative().unpackFunctionAny<MyCompFunc>();
+        const auto* quotient = findRational(fn_2);
+
+        if (!quotient || quotient->getDenominator().getDenseCoeffs().size() != static_cast<std::size_t>(2 * (order + 1) + 1)) {
+            std::cerr << std::format("Unexpected denominator of d^{}/dx^{}({})\n", order, order, test_source_2);
+            return 1;
+        }
+
+        if (order == 2) {
+            const double expected = (6 * test_x * test_x - 2) / std::pow(test_x * test_x + 1, 3);
+
+            if (std::fabs(fn_2.evalAt(test_x) - expected) > 1e-14) {
+                std::cerr << std::format("Unexpected output of d2/dx2({}): {}\n", test_source_2, fn_2.evalAt(test_x));
+                return 1;
+            }
+        }
+    }
+
+    // 1 / (x^2 + 1) = (1 / (x - i) - 1 / (x + i)) / 2i, whose n-th derivatives are plain complex powers.
+    const std::complex<double> unit {0, 1};
+    const double factorial_6 = 720;
+    const double expected_6 = (factorial_6 * (std::pow(test_x - unit, -7.0) - std::pow(test_x + unit, -7.0)) / (2.0 * unit)).real();
+    std::vector<double> batch_out(1);
+    fn_2.evalBatch(std::vector<double> {test_x}, batch_out);
+
+    if (std::fabs(fn_2.evalAt(test_x) - expected_6) > 1e-9 * std::fabs(expected_6) || batch_out[0] != fn_2.evalAt(test_x)) {
+        std::cerr << std::format("Unexpected output of d^6/dx^6({}): {} vs {}\n", test_source_2, fn_2.evalAt(test_x), expected_6);
+        return 1;
+    }
+}
@@ -0,0 +1,28 @@
+/**
+ * @file TestSupport.cpp
+ * @author DrkWithT
+ * @brief Implements tolerance checks & source compiling shared by tests.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include "Tests/TestSupport.hpp"
+#include "Frontend/Parser.hpp"
+#include "Backend/FuncEmitter.hpp"
+
+namespace GeneralDeriver::Tests {
+    bool isClose(double actual, double expected, double tolerance) {
+        return std::fabs(actual - expected) <= tolerance * std::max(1.0, std::fabs(expected));
+    }
+
+    Models::Composite emitSource(const std::string& source) {
+        Frontend::Parser parser;
+        Backend::FunctionEmitter emitter;
+
+        return emitter.emitFunction(parser.parseAll(source).root);
+    }
+}
@@ -0,0 +1,102 @@
+/**
+ * @file TestTextWriter.cpp
+ * @author DrkWithT
+ * @brief Implements tests for the DAG-aware function to text serializer.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <array>
+#include <cmath>
+#include <format>
+#include <iostream>
+#include <string>
+#include "Models/Composite.hpp"
+#include "Models/Constant.hpp"
+#include "Models/Identity.hpp"
+#include "Models/Polynomial.hpp"
+#include "Models/TextWriter.hpp"
+#include "Tests/TestSupport.hpp"
+
+using MyCompFunc = GeneralDeriver::Models::Composite;
+using MyFunctionAny = GeneralDeriver::Models::FunctionAny;
+using MyConstant = GeneralDeriver::Models::Constant;
+using MyIdentity = GeneralDeriver::Models::Identity;
+using MyPoly = GeneralDeriver::Models::Polynomial;
+using MyOp = GeneralDeriver::Syntax::AstOpType;
+
+using GeneralDeriver::Tests::emitSource;
+using GeneralDeriver::Tests::isClose;
+
+static constexpr const char* test_round_trip_source = "x * sin(x - 1) - 2 / (x + 3) + cos(x)^3 - -x";
+static constexpr std::array<double, 4> test_xs = {0.25, 0.7, 1.5, 3.0};
+static constexpr int test_short_nesting = 8;
+static constexpr int test_long_nesting = 64;
+
+/// @note Builds sin(sin(...sin(x)...)) with the given depth, whose eager derivative shares each inner level between a cos factor & the next chain rule product.
+[[nodiscard]] std::string writeNestedDerivative(int depth) {
+    std::string source = "x";
+
+    for (int level = 0; level < depth; level++) {
+        source = std::format("sin({})", source);
+    }
+
+    MyCompFunc fn = emitSource(source);
+    MyFunctionAny derivative = fn.makeDerivative();
+
+    return GeneralDeriver::Models::writeText(*derivative.getStoragePtr());
+}
+
+int main() {
+    const auto poly_text = MyPoly::fromDense({7, -2, 0, 0, 3}).toText();
+
+    if (poly_text != "3*x^4 - 2*x + 7") {
+        std::cerr << std::format("Unexpected text of 3x^4 - 2x + 7: '{}'\n", poly_text);
+        return 1;
+    }
+
+    const auto negative_text = MyPoly::fromDense({-1, 0, -0.5}).toText();
+
+    if (negative_text != "-0.5*x^2 - 1") {
+        std::cerr << std::format("Unexpected text of -0.5x^2 - 1: '{}'\n", negative_text);
+        return 1;
+    }
+
+    if (MyPoly {}.toText() != "0") {
+        std::cerr << std::format("Unexpected text of the zero polynomial: '{}'\n", MyPoly {}.toText());
+        return 1;
+    }
+
+    // A sub-function reached through two handles gets written once, as a binding.
+    MyFunctionAny shared = MyCompFunc {MyOp::add, MyCompFunc {MyOp::sin, MyIdentity {}, {}}, MyConstant {1}};
+    const auto shared_text = MyCompFunc {MyOp::mul, shared, shared}.toText();
+
+    if (shared_text != "let t0 = sin(x) + 1;\nt0 * t0") {
+        std::cerr << std::format("Unexpected text of a shared sub-function: '{}'\n", shared_text);
+        return 1;
+    }
+
+    // Without sharing, writing only adds the parentheses precedence needs, so the text parses back to the same function.
+    MyCompFunc source_fn = emitSource(test_round_trip_source);
+    const auto source_text = source_fn.toText();
+    MyCompFunc reparsed_fn = emitSource(source_text);
+
+    for (double x : test_xs) {
+        if (!isClose(reparsed_fn.evalAt(x), source_fn.evalAt(x))) {
+            std::cerr << std::format("Text '{}' evaluates to {} vs {} at x = {}\n", source_text, reparsed_fn.evalAt(x), source_fn.evalAt(x), x);
+            return 1;
+        }
+    }
+
+    // Derivatives of nested calls share their inner levels, so the text grows linearly with nesting instead of quadratically.
+    const auto short_text = writeNestedDerivative(test_short_nesting);
+    const auto long_text = writeNestedDerivative(test_long_nesting);
+    const auto growth_bound = 2 * short_text.size() * (test_long_nesting / test_short_nesting);
+
+    if (long_text.size() > growth_bound) {
+        std::cerr << std::format("Derivative text grew from {} to {} chars, past the linear bound {}\n", short_text.size(), long_text.size(), growth_bound);
+        return 1;
+    }
+}
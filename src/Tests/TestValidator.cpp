@@ -8,20 +8,34 @@
  * 
  */
 
+#include <cmath>
 #include <iostream>
 #include "Syntax/AstNodes.hpp"
 #include "Frontend/Parser.hpp"
 #include "Backend/AstValidator.hpp"
+#include "Syntax/IAstNode.hpp"
 
 using MyParser = GeneralDeriver::Frontend::Parser;
 using MyParseResult = GeneralDeriver::Frontend::ParseResult;
 using MyAstNode = GeneralDeriver::Syntax::IAstNode;
 using MyValidator = GeneralDeriver::Backend::AstValidator;
+using MyConstant = GeneralDeriver::Syntax::Constant;
+using MyBinary = GeneralDeriver::Syntax::Binary;
+using MyNodeType = GeneralDeriver::Syntax::AstNodeType;
+
+/// @note Gives the folded value of a rewritten child, or NaN when it is not a Constant.
+[[nodiscard]] double getConstantValue(const std::unique_ptr<MyAstNode>& node) {
+    const auto* constant = dynamic_cast<const MyConstant*>(node.get());
+
+    return (constant != nullptr) ? constant->getValue() : std::nan("");
+}
 
 static constexpr const char* test_source_1 = "x - 1";
 static constexpr const char* test_source_2 = "x + 0^-1";
 static constexpr const char* test_source_3 = "x + 0^0";
 static constexpr const char* test_source_4 = "x + 0^(2 - 2)";
+static constexpr const char* test_source_5 = "x / (3 * 2 - 6)";
+static constexpr const char* test_source_6 = "(2 * 3 - 1) / 4 + x * (8 / 2)";
 
 int main() {
     MyParser parser;
@@ -57,4 +71,29 @@ int main() {
         std::cerr << "Unexpected validation for source 4.\n";
         return 1;
     }
-}
\ No newline at end of file
+
+    validator.clearState();
+
+    auto ast_5 = parser.parseAll(test_source_5);
+
+    if (!ast_5.ok || validator.foldAst(ast_5.root)) {
+        std::cerr << "Unexpected validation for source 5.\n";
+        return 1;
+    }
+
+    // (2 * 3 - 1) / 4 + x * (8 / 2) should fold into 1.25 + x * 4
+    auto ast_6 = parser.parseAll(test_source_6);
+
+    if (!ast_6.ok || !validator.foldAst(ast_6.root) || ast_6.root->getType() != MyNodeType::binary) {
+        std::cerr << "Unexpected fold failure for source 6.\n";
+        return 1;
+    }
+
+    const auto& sum = static_cast<const MyBinary&>(*ast_6.root);
+    const auto* product = dynamic_cast<const MyBinary*>(sum.getRight().get());
+
+    if (getConstantValue(sum.getLeft()) != 1.25 || product == nullptr || getConstantValue(product->getRight()) != 4.0) {
+        std::cerr << "Constant sub-trees of source 6 were not rewritten.\n";
+        return 1;
+    }
+}
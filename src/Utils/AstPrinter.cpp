@@ -58,7 +58,9 @@ namespace GeneralDeriver::Utils {
         printIndent();
         std::cout << "type: " << static_cast<int>(node.getType()) << '\n';
         printIndent();
-        std::cout << "meta-symbol: x\n";
+        std::cout << "meta-symbol: " << node.getName() << '\n';
+        printIndent();
+        std::cout << "slot: " << node.getSlot() << '\n';
 
         depth--;
 
@@ -0,0 +1,139 @@
+/**
+ * @file ExprGenerator.cpp
+ * @author DrkWithT
+ * @brief Implements seeded random expression generator.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <array>
+#include <format>
+#include "Utils/ExprGenerator.hpp"
+
+namespace GeneralDeriver::Utils {
+    static constexpr std::array<const char*, 4> named_variables = {"x", "y", "z", "w"};
+    static constexpr std::array<const char*, 5> function_names = {"sin", "cos", "exp", "ln", "sqrt"};
+    static constexpr double unit_scale = 0x1p-53;
+    static constexpr double variable_chance = 0.6;
+    static constexpr double decimal_chance = 0.25;
+    static constexpr std::size_t max_whole_digit = 9;
+
+    double ExprGenerator::drawUnit() {
+        return static_cast<double>(rng() >> 11) * unit_scale;
+    }
+
+    std::size_t ExprGenerator::drawBelow(std::size_t bound) {
+        return static_cast<std::size_t>(rng() % bound);
+    }
+
+    bool ExprGenerator::drawChance(double chance) {
+        return drawUnit() < chance;
+    }
+
+    void ExprGenerator::emitNumber() {
+        out += std::to_string(1 + drawBelow(max_whole_digit));
+
+        if (drawChance(decimal_chance)) {
+            out += '.';
+            out += std::to_string(drawBelow(10));
+        }
+    }
+
+    void ExprGenerator::emitVariable() {
+        std::size_t slot = drawBelow(config.variable_count);
+
+        if (slot < named_variables.size()) {
+            out += named_variables[slot];
+        } else {
+            out += std::format("v{}", slot);
+        }
+    }
+
+    void ExprGenerator::emitLiteral(std::size_t depth) {
+        if (depth < config.max_depth && drawChance(config.nest_chance)) {
+            if (drawChance(config.call_chance)) {
+                out += function_names[drawBelow(function_names.size())];
+            }
+
+            out += '(';
+            emitTerm(depth + 1);
+            out += ')';
+        } else if (drawChance(variable_chance)) {
+            emitVariable();
+        } else {
+            emitNumber();
+        }
+    }
+
+    void ExprGenerator::emitUnary(std::size_t depth) {
+        if (drawChance(config.negate_chance)) {
+            out += '-';
+        }
+
+        emitLiteral(depth);
+    }
+
+    void ExprGenerator::emitPower(std::size_t depth) {
+        emitUnary(depth);
+
+        if (config.max_exponent > 0 && drawChance(config.power_chance)) {
+            out += '^';
+            out += std::to_string(1 + drawBelow(config.max_exponent));
+
+            if (drawChance(config.half_exponent_chance)) {
+                out += ".5";
+            }
+        }
+    }
+
+    void ExprGenerator::emitFactor(std::size_t depth) {
+        // No draw for single factors, so corpora without products keep the same seeds.
+        const std::size_t operand_count = (config.max_factors > 1) ? 1 + drawBelow(config.max_factors) : 1;
+
+        emitPower(depth);
+
+        for (std::size_t i = 1; i < operand_count; i++) {
+            out += drawChance(0.5) ? " * " : " / ";
+            emitPower(depth);
+        }
+    }
+
+    void ExprGenerator::emitTerm(std::size_t depth) {
+        const std::size_t operand_count = 1 + drawBelow(std::max<std::size_t>(config.max_terms, 1));
+
+        emitFactor(depth);
+
+        for (std::size_t i = 1; i < operand_count; i++) {
+            out += drawChance(0.5) ? " + " : " - ";
+            emitFactor(depth);
+        }
+    }
+
+    ExprGenerator::ExprGenerator(const ExprGenConfig& config_)
+    : config {config_}, rng {config_.seed}, out {} {
+        if (config.variable_count == 0) {
+            config.variable_count = 1;
+        }
+    }
+
+    std::string ExprGenerator::generate() {
+        out.clear();
+        emitTerm(0);
+
+        return out;
+    }
+
+    std::vector<std::string> ExprGenerator::generateCorpus(std::size_t count) {
+        std::vector<std::string> corpus;
+        corpus.reserve(count);
+
+        for (std::size_t i = 0; i < count; i++) {
+            corpus.push_back(generate());
+        }
+
+        return corpus;
+    }
+}
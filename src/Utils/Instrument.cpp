@@ -0,0 +1,182 @@
+/**
+ * @file Instrument.cpp
+ * @author DrkWithT
+ * @brief Implements pipeline stage timers, statistics & Chrome trace export.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <format>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Utils/Instrument.hpp"
+
+namespace GeneralDeriver::Utils {
+    struct TraceEvent {
+        Stage stage;
+        std::uint64_t start_ns; // since the trace began
+        std::uint64_t duration_ns;
+        std::uint64_t thread_id;
+    };
+
+    static std::array<std::atomic<std::uint64_t>, stage_count> stage_calls {};
+    static std::array<std::atomic<std::uint64_t>, stage_count> stage_nanoseconds {};
+    static std::array<std::atomic<std::uint64_t>, stage_count> stage_allocations {};
+    static std::array<std::atomic<std::uint64_t>, stage_count> stage_alloc_bytes {};
+    static std::atomic<AllocReader> alloc_reader {nullptr};
+
+    static std::mutex trace_mutex;
+    static std::vector<TraceEvent> trace_events;
+    static std::chrono::steady_clock::time_point trace_start;
+    static std::atomic<bool> trace_on {false};
+
+    static AllocTotals readAllocTotals() {
+        const auto reader = alloc_reader.load(std::memory_order_relaxed);
+
+        return (reader != nullptr) ? reader() : AllocTotals {0, 0};
+    }
+
+    std::string_view getStageName(Stage stage) {
+        switch (stage) {
+        case Stage::lex:
+            return "lex";
+        case Stage::parse:
+            return "parse";
+        case Stage::validate:
+            return "validate";
+        case Stage::emit:
+            return "emit";
+        case Stage::derive:
+            return "derive";
+        case Stage::eval:
+            return "eval";
+        case Stage::other:
+        default:
+            return "other";
+        }
+    }
+
+    void setAllocReader(AllocReader reader) {
+        alloc_reader.store(reader, std::memory_order_relaxed);
+    }
+
+    StageTimer::StageTimer(Stage stage_)
+    : start {}, allocs_before {0, 0}, stage {stage_}, outer_stage {detail::current_stage} {
+        if constexpr (instrument_enabled) {
+            detail::current_stage = stage;
+            allocs_before = readAllocTotals();
+            start = std::chrono::steady_clock::now();
+        }
+    }
+
+    StageTimer::~StageTimer() {
+        if constexpr (instrument_enabled) {
+            const auto stop = std::chrono::steady_clock::now();
+            const auto index = static_cast<std::size_t>(stage);
+            const auto elapsed_ns = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+
+            stage_calls[index].fetch_add(1, std::memory_order_relaxed);
+            stage_nanoseconds[index].fetch_add(elapsed_ns, std::memory_order_relaxed);
+            const auto allocs_after = readAllocTotals();
+
+            stage_allocations[index].fetch_add(allocs_after.count - allocs_before.count, std::memory_order_relaxed);
+            stage_alloc_bytes[index].fetch_add(allocs_after.bytes - allocs_before.bytes, std::memory_order_relaxed);
+            detail::current_stage = outer_stage;
+
+            if (trace_on.load(std::memory_order_relaxed)) {
+                std::lock_guard lock {trace_mutex};
+                const auto start_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(start - trace_start).count();
+
+                trace_events.push_back({stage, static_cast<std::uint64_t>(std::max<std::int64_t>(start_ns, 0)), elapsed_ns, std::hash<std::thread::id> {}(std::this_thread::get_id())});
+            }
+        }
+    }
+
+    PipelineStats readStats() {
+        PipelineStats stats {};
+
+        for (std::size_t i = 0; i < stage_count; i++) {
+            stats.stages[i] = {
+                stage_calls[i].load(std::memory_order_relaxed),
+                stage_nanoseconds[i].load(std::memory_order_relaxed),
+                detail::node_counts[i].load(std::memory_order_relaxed),
+                stage_allocations[i].load(std::memory_order_relaxed),
+                stage_alloc_bytes[i].load(std::memory_order_relaxed)
+            };
+        }
+
+        stats.peak_tree_size = detail::peak_tree_size.load(std::memory_order_relaxed);
+
+        return stats;
+    }
+
+    void resetStats() {
+        for (std::size_t i = 0; i < stage_count; i++) {
+            stage_calls[i].store(0, std::memory_order_relaxed);
+            stage_nanoseconds[i].store(0, std::memory_order_relaxed);
+            stage_allocations[i].store(0, std::memory_order_relaxed);
+            stage_alloc_bytes[i].store(0, std::memory_order_relaxed);
+            detail::node_counts[i].store(0, std::memory_order_relaxed);
+        }
+
+        detail::peak_tree_size.store(0, std::memory_order_relaxed);
+
+        std::lock_guard lock {trace_mutex};
+        trace_events.clear();
+    }
+
+    void printStats(std::ostream& out, const PipelineStats& stats) {
+        if constexpr (!instrument_enabled) {
+            out << "stats: instrumentation compiled out (DO_INSTRUMENT=OFF)\n";
+            return;
+        }
+
+        out << std::format("{:<10}{:>8}{:>14}{:>12}{:>12}{:>14}\n", "stage", "calls", "time_us", "nodes", "allocs", "alloc_bytes");
+
+        for (std::size_t i = 0; i < stage_count; i++) {
+            const auto& stage = stats.stages[i];
+
+            if (stage.calls == 0 && stage.nodes == 0) {
+                continue;
+            }
+
+            out << std::format("{:<10}{:>8}{:>14.1f}{:>12}{:>12}{:>14}\n", getStageName(static_cast<Stage>(i)), stage.calls, static_cast<double>(stage.nanoseconds) / 1e3, stage.nodes, stage.allocations, stage.alloc_bytes);
+        }
+
+        out << std::format("peak tree size: {}\n", stats.peak_tree_size);
+    }
+
+    void startTrace() {
+        std::lock_guard lock {trace_mutex};
+        trace_events.clear();
+        trace_start = std::chrono::steady_clock::now();
+        trace_on.store(true, std::memory_order_relaxed);
+    }
+
+    /// @note Trace timestamps & durations are in microseconds, kept fractional so sub-microsecond stages still show up.
+    void writeChromeTrace(std::ostream& out) {
+        std::lock_guard lock {trace_mutex};
+
+        out << "{\"traceEvents\":[";
+
+        for (std::size_t i = 0; i < trace_events.size(); i++) {
+            const auto& event = trace_events[i];
+
+            out << std::format(
+                "{}{{\"name\":\"{}\",\"cat\":\"pipeline\",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":1,\"tid\":{}}}",
+                (i > 0) ? "," : "",
+                getStageName(event.stage),
+                static_cast<double>(event.start_ns) / 1e3,
+                static_cast<double>(event.duration_ns) / 1e3,
+                event.thread_id % 1000000
+            );
+        }
+
+        out << "],\"displayTimeUnit\":\"ns\"}\n";
+    }
+}
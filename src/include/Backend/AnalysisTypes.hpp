@@ -13,6 +13,7 @@ namespace GeneralDeriver::Backend {
         div,
         neg,
         power,
+        call,
         identity
     };
 
@@ -46,11 +47,14 @@ namespace GeneralDeriver::Backend {
 
         friend FoldResult operator+(const FoldResult& lhs, const FoldResult& rhs);
         friend FoldResult operator-(const FoldResult& lhs, const FoldResult& rhs);
+        friend FoldResult operator*(const FoldResult& lhs, const FoldResult& rhs);
+        friend FoldResult operator/(const FoldResult& lhs, const FoldResult& rhs);
         friend FoldResult doNegate(const FoldResult& target);
         friend FoldResult doPower(const FoldResult& lhs, const FoldResult& rhs);
+        friend FoldResult doFunction(Syntax::AstOpType op, const FoldResult& target);
     };
 
-    /// @brief for unary operation e.g negate
+    /// @brief for unary operation e.g negate or a function call like sin
     [[nodiscard]] FoldResult computeOp(Syntax::AstOpType op, const FoldResult& target);
 
     /// @brief for binary operation e.g M D A S
@@ -2,43 +2,36 @@
 #define AST_VALIDATOR_HPP
 
 #include <memory>
-#include <any>
-#include <optional>
-#include <stack>
 #include "Syntax/IAstNode.hpp"
-#include "Syntax/IAstVisitor.hpp"
 #include "Syntax/AstNodes.hpp"
 #include "Backend/AnalysisTypes.hpp"
 
 namespace GeneralDeriver::Backend {
     /**
-     * @brief AST visitor & walker for detecting any constant-folded NaN values.
+     * @brief Typed constant-folding pass over ASTs for detecting any constant-folded NaN values. Nodes are dispatched by a `switch` on their `AstNodeType`, so each visit returns its `FoldResult` directly instead of boxing it.
+     * @note `foldAst` also rewrites every maximal constant sub-tree into one `Syntax::Constant`, so the emitter gets a smaller tree and no constant arithmetic left to convert.
      */
-    class AstValidator : public Syntax::IAstVisitor<std::any> {
+    class AstValidator {
     private:
-        enum class OpStatus {
-            ok,
-            failed,
-            done,
-        };
+        [[nodiscard]] FoldResult checkNode(const Syntax::IAstNode& node) const;
 
-        std::stack<FoldResult> values;
-        std::stack<Syntax::AstOpType> ops;
+        /// @note Folds the node in `slot`, but leaves rewriting a numeric result to the parent, so only the top of each constant sub-tree gets replaced.
+        [[nodiscard]] FoldResult foldNode(std::unique_ptr<Syntax::IAstNode>& slot);
 
-        [[nodiscard]] OpStatus doStackOp();
+        static void rewriteConstant(std::unique_ptr<Syntax::IAstNode>& slot, const FoldResult& folded);
 
     public:
         AstValidator();
 
-        std::any visitConstant(const Syntax::Constant& node) override;
-        std::any visitVarStub(const Syntax::VarStub& node) override;
-        std::any visitUnary(const Syntax::Unary& node) override;
-        std::any visitBinary(const Syntax::Binary& node) override;
+        /// @note Checks only, leaving the tree as it is.
+        [[nodiscard]] bool validateAst(const std::unique_ptr<Syntax::IAstNode>& root) const;
 
-        [[nodiscard]] bool validateAst(const std::unique_ptr<Syntax::IAstNode>& root);
+        /// @note Checks like `validateAst`, and on success rewrites constant sub-trees in place.
+        [[nodiscard]] bool foldAst(std::unique_ptr<Syntax::IAstNode>& root);
 
+        /// @note The pass keeps no state between trees, so this is a no-op kept for existing callers.
         void clearState();
     };
 }
 
-#endif
\ No newline at end of file
+#endif
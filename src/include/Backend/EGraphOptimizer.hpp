@@ -0,0 +1,67 @@
+#ifndef E_GRAPH_OPTIMIZER_HPP
+#define E_GRAPH_OPTIMIZER_HPP
+
+#include <chrono>
+#include <cstddef>
+#include "Models/FunctionAny.hpp"
+
+namespace GeneralDeriver::Backend {
+    /// @brief Evaluation latencies in nanoseconds, per node or per op. The defaults come from `measureOpCosts` in a release build on an x86-64 Linux host.
+    struct OpCosts {
+        double dispatch = 2.1;        // virtual call through a `FunctionAny`, paid by every non-constant node
+        double add = 0.85;            // also sub & neg
+        double mul = 1.7;
+        double div = 5.6;
+        double pow = 42.0;
+        double int_power_step = 0.9;  // one squaring or multiply of `raiseToInteger`
+        double poly_term = 3.0;       // one Horner step
+        double sin = 15.0;
+        double cos = 18.0;
+        double exp = 15.5;
+        double ln = 18.5;
+        double sqrt = 8.4;
+        double opaque = 60.0;         // kinds the optimizer cannot see into e.g lazy derivatives
+    };
+
+    /// @brief Times dependent chains of each op on this machine, taking a few milliseconds. Leaves `opaque` at its default.
+    [[nodiscard]] OpCosts measureOpCosts();
+
+    struct EGraphOptions {
+        OpCosts costs {};
+        std::chrono::microseconds time_budget {5000};
+        std::size_t max_nodes = 20000; // stop growing the e-graph past this many e-nodes
+        std::size_t max_iterations = 16;
+    };
+
+    struct EGraphStats {
+        std::size_t classes;
+        std::size_t nodes;
+        std::size_t iterations;
+        double cost_before;      // estimated ns per evaluation of the input
+        double cost_after;
+        bool saturated;          // no rule found anything new before the limits hit
+    };
+
+    struct OptimizeResult {
+        Models::FunctionAny function;
+        EGraphStats stats;
+    };
+
+    /**
+     * @brief Equality saturation over the function model: the input goes into an e-graph, where hash-consing merges structurally equal sub-functions and every rewrite rule adds equivalent forms beside the existing ones instead of replacing them. Rules cover commutativity & associativity of `+` and `*`, identities of 0 & 1, double negation, constant folding, merging repeated factors into `IntPower`, pulling common factors out of sums & differences, `exp(a) * exp(b)`, and factoring polynomial leaves into `c * (x - r)^n` or `x^k * q` forms. Extraction then picks the cheapest tree per e-class under `OpCosts`.
+     * @note Growth stops at the time budget, the node limit or saturation, whichever comes first, and the input always stays one of the candidates, so the result never costs more by the model. Factoring may round differently than the input, like any algebraic rewrite, but division only becomes multiplication by exact reciprocals.
+     */
+    class EGraphOptimizer {
+    private:
+        EGraphOptions options;
+
+    public:
+        EGraphOptimizer();
+        explicit EGraphOptimizer(const EGraphOptions& options_);
+
+        /// @note Gives the input back unchanged when it is empty.
+        [[nodiscard]] OptimizeResult optimize(const Models::FunctionAny& fn) const;
+    };
+}
+
+#endif
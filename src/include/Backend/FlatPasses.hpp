@@ -0,0 +1,45 @@
+#ifndef FLAT_PASSES_HPP
+#define FLAT_PASSES_HPP
+
+#include <cstdint>
+#include <vector>
+#include "Syntax/FlatAst.hpp"
+#include "Backend/AnalysisTypes.hpp"
+#include "Models/Composite.hpp"
+
+namespace GeneralDeriver::Backend {
+    /**
+     * @brief `AstValidator` counterpart for `Syntax::FlatAst`: one forward loop folds every node from its already folded children.
+     * @note The per-node fold buffer is kept between calls, like the AST buffer itself.
+     */
+    class FlatValidator {
+    private:
+        std::vector<FoldResult> folds;
+
+        void foldNodes(const Syntax::FlatAst& ast);
+
+    public:
+        FlatValidator();
+
+        [[nodiscard]] bool validateAst(const Syntax::FlatAst& ast);
+
+        /// @note Also turns every maximal constant sub-tree into one constant node, in place.
+        [[nodiscard]] bool foldAst(Syntax::FlatAst& ast);
+    };
+
+    /**
+     * @brief `FunctionEmitter` counterpart for `Syntax::FlatAst`. Marks nodes reachable from the root in one backward loop, then emits those in one forward loop, so nodes orphaned by folding cost nothing.
+     */
+    class FlatEmitter {
+    private:
+        std::vector<Models::Composite> parts;
+        std::vector<std::uint8_t> live;
+
+    public:
+        FlatEmitter();
+
+        [[nodiscard]] Models::Composite emitFunction(const Syntax::FlatAst& ast);
+    };
+}
+
+#endif
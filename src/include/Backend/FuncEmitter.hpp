@@ -2,14 +2,33 @@
 #define FUNC_EMITTER_HPP
 
 #include <memory>
+#include <string>
 #include "Backend/AnalysisTypes.hpp"
 #include "Syntax/IAstVisitor.hpp"
 #include "Syntax/IAstNode.hpp"
 #include "Models/Composite.hpp"
 
 namespace GeneralDeriver::Backend {
+    /// @note Numbers become `Constant` leaves.
     [[nodiscard]] Models::Composite convertFoldResult(const FoldResult& folded_value);
 
+    /// @note x becomes an `Identity` leaf, which polynomial normal form still treats as `1x^1`. Other names become slot-reading Variable leaves.
+    [[nodiscard]] Models::Composite emitVariable(const std::string& name, std::size_t slot);
+
+    [[nodiscard]] Models::Composite emitUnaryOp(Syntax::AstOpType op, const Models::Composite& inside_fn);
+
+    /// @note Powers by a constant whole exponent become `IntPower` leaves. Other ops keep their plain Composite.
+    [[nodiscard]] Models::Composite emitBinaryOp(Syntax::AstOpType op, const Models::Composite& lhs_fn, const Models::Composite& rhs_fn);
+
+    /// @note Like `emitUnaryOp`, but negating a polynomial leaf gives the negated polynomial leaf.
+    [[nodiscard]] Models::Composite emitNormalUnaryOp(Syntax::AstOpType op, const Models::Composite& inside_fn);
+
+    /**
+     * @brief Emits a binary op, collapsing it into one canonical polynomial leaf when both operands are polynomial leaves.
+     * @note Covers `+`, `-`, `*`, division by a non-zero constant, and powers by a constant: whole exponents expand while the result fits `max_normal_terms` terms, and a single-term base takes any whole exponent (or any exponent for plain x). Larger or overflowing results fall back to `emitBinaryOp`.
+     */
+    [[nodiscard]] Models::Composite emitNormalBinaryOp(Syntax::AstOpType op, const Models::Composite& lhs_fn, const Models::Composite& rhs_fn);
+
     class FunctionEmitter : public Syntax::IAstVisitor<Models::Composite> {
 
     public:
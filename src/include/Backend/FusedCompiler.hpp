@@ -0,0 +1,73 @@
+#ifndef FUSED_COMPILER_HPP
+#define FUSED_COMPILER_HPP
+
+#include <initializer_list>
+#include <string>
+#include <vector>
+#include "Frontend/Token.hpp"
+#include "Frontend/Lexer.hpp"
+#include "Frontend/VariableTable.hpp"
+#include "Backend/AnalysisTypes.hpp"
+#include "Models/Composite.hpp"
+
+namespace GeneralDeriver::Backend {
+    /// @brief Fold state and emitted function of one sub-expression. The function is a constant leaf whenever the fold is numeric.
+    struct FoldedPart {
+        FoldResult folded;
+        Models::Composite fn;
+    };
+
+    [[nodiscard]] FoldedPart makeConstantPart(double value);
+
+    /// @note Slot 0 is x, which becomes an `Identity` leaf like in `FunctionEmitter`.
+    [[nodiscard]] FoldedPart makeVariablePart(const std::string& name, std::size_t slot);
+
+    /// @note Throws `std::domain_error` on a NaN fold.
+    [[nodiscard]] FoldedPart foldUnaryPart(Syntax::AstOpType op, const FoldedPart& inner);
+
+    /// @note Throws `std::domain_error` on a NaN fold.
+    [[nodiscard]] FoldedPart foldBinaryPart(Syntax::AstOpType op, const FoldedPart& lhs, const FoldedPart& rhs);
+
+    struct FusedResult {
+        Models::Composite function;
+        std::vector<std::string> variables; // names by slot
+        bool ok;
+    };
+
+    /**
+     * @brief Single-pass compiler from x-expression source to a validated, constant-folded Composite. Follows the same grammar as `Frontend::Parser`, but folds and emits during descent instead of building an AST for `AstValidator` and `FunctionEmitter` to walk.
+     * @note Any NaN fold e.g `0^0` or `0^-1` fails the whole compile, just like `AstValidator::validateAst`.
+     */
+    class FusedCompiler {
+    private:
+        using Partial = FoldedPart;
+
+        Frontend::Lexer lexer;
+        Frontend::VariableTable variables;
+        Frontend::Token current;
+        Frontend::Token previous;
+
+        const Frontend::Token& peekCurrent() const;
+        Frontend::Token advanceToken();
+        void consumeToken(std::initializer_list<Frontend::TokenType> expected);
+
+        [[nodiscard]] Partial compileLiteral();
+        [[nodiscard]] Partial compileUnary();
+        [[nodiscard]] Partial compilePower();
+        [[nodiscard]] Partial compileFactor();
+        [[nodiscard]] Partial compileTerm();
+
+    public:
+        FusedCompiler();
+
+        FusedCompiler(const FusedCompiler& other) = delete;
+        FusedCompiler& operator=(const FusedCompiler& other) = delete;
+
+        FusedCompiler(FusedCompiler&& x_other) = delete;
+        FusedCompiler& operator=(FusedCompiler&& x_other) = delete;
+
+        [[nodiscard]] FusedResult compileAll(const std::string& source_arg);
+    };
+}
+
+#endif
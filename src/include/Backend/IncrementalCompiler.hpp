@@ -0,0 +1,99 @@
+#ifndef INCREMENTAL_COMPILER_HPP
+#define INCREMENTAL_COMPILER_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Frontend/Token.hpp"
+#include "Frontend/VariableTable.hpp"
+#include "Backend/FusedCompiler.hpp"
+#include "Models/FunctionAny.hpp"
+#include "Models/Composite.hpp"
+
+namespace GeneralDeriver::Backend {
+    struct IncrementalResult {
+        Models::Composite function;
+        Models::FunctionAny derivative;
+        std::vector<std::string> variables; // names by slot, including names dropped by earlier edits
+        std::size_t reused_tokens; // tokens covered by sub-expressions reused from the previous compile
+        std::size_t combined_count; // unary & binary folds this compile had to run
+        bool ok;
+    };
+
+    /**
+     * @brief Compiler for repeatedly edited x-expressions. Each compile diffs the new source against the previous one by `Token` spans, re-lexes only the edited region, and reuses the folded function & derivative of every `power` sub-expression whose tokens did not change.
+     * @note `+`/`-` & `*`/`/` chains also keep their left fold after each operand, so a chain resumes from its last step before the edit. Chains fold to the left, so the steps after an edited operand get re-folded on top of it: appending to a long sum costs a few folds, but editing its first term re-folds all of them. The remaining bookkeeping is one in-place splice of the token & cache entries, a pass dropping stale steps before the edit, and shifting the spans of the tokens after it.
+     */
+    class IncrementalCompiler {
+    private:
+        /// @brief Compiled sub-expression: fold state, emitted function and its derivative.
+        struct Piece {
+            FoldedPart part;
+            Models::FunctionAny derivative;
+        };
+
+        /// @brief Left fold of a chain's operands up to one of them.
+        struct ChainStep {
+            Piece piece;
+            std::size_t token_count; // spanned tokens from the chain's start, not counting the lookahead token
+        };
+
+        /// @brief Cached `power` sub-expression and chain steps starting at the same token index.
+        struct CacheEntry {
+            Piece piece;
+            std::size_t token_count; // spanned tokens, not counting the lookahead token
+            bool filled;
+            std::vector<ChainStep> factor_steps;
+            std::vector<ChainStep> term_steps;
+        };
+
+        enum class ChainKind : std::uint8_t {
+            factor,
+            term
+        };
+
+        std::string source;
+        std::vector<Frontend::Token> tokens; // non-spacing tokens, always ending with eos
+        std::vector<CacheEntry> cache;       // parallel to tokens
+        Frontend::VariableTable variables;   // kept across compiles so cached pieces keep valid slots
+
+        std::size_t cursor;
+        std::size_t prefix_count;  // leading tokens unchanged by the latest edit
+        std::size_t suffix_begin;  // first index of trailing tokens unchanged by the latest edit
+        std::size_t reused_count;
+        std::size_t combined_count;
+
+        void relexEdit(const std::string& source_arg);
+        [[nodiscard]] bool isReusable(std::size_t token_pos, std::size_t token_count) const;
+
+        const Frontend::Token& peekCurrent() const;
+        void consumeToken();
+        void consumeToken(Frontend::TokenType expected);
+
+        [[nodiscard]] Piece combineUnary(Syntax::AstOpType op, const Piece& inner);
+        [[nodiscard]] Piece combineBinary(Syntax::AstOpType op, const Piece& lhs, const Piece& rhs);
+
+        [[nodiscard]] Piece compileLiteral();
+        [[nodiscard]] Piece compileUnary();
+        [[nodiscard]] Piece compilePower();
+        [[nodiscard]] Piece compileChain(ChainKind kind);
+        [[nodiscard]] Piece compileFactor();
+        [[nodiscard]] Piece compileTerm();
+
+    public:
+        IncrementalCompiler();
+
+        IncrementalCompiler(const IncrementalCompiler& other) = delete;
+        IncrementalCompiler& operator=(const IncrementalCompiler& other) = delete;
+
+        IncrementalCompiler(IncrementalCompiler&& x_other) = delete;
+        IncrementalCompiler& operator=(IncrementalCompiler&& x_other) = delete;
+
+        /// @note A failed compile drops all cached state, so the next compile starts from scratch.
+        [[nodiscard]] IncrementalResult compile(const std::string& source_arg);
+
+        void clearState();
+    };
+}
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef ALLOC_TRACKING_HPP
+#define ALLOC_TRACKING_HPP
+
+#include <cstdint>
+
+namespace GeneralDeriver::Benchmarks {
+    struct AllocStats {
+        std::uint64_t count;
+        std::uint64_t bytes;
+        std::uint64_t frees;
+    };
+
+    /**
+     * @brief Reads totals of the counting global `operator new` / `delete` replacement. Linking the `AllocTracking` library brings the replacement in, so every allocation of the program gets counted. Benchmarks & allocation budget tests link it, and `general_deriver` only does with `DO_INSTRUMENT`.
+     * @note Totals only grow: diff two reads to measure a stage.
+     */
+    [[nodiscard]] AllocStats readAllocStats();
+
+    /// @note Same totals, but only for allocations & frees made by the calling thread.
+    [[nodiscard]] AllocStats readThreadAllocStats();
+
+    /// @brief Makes every `Utils::StageTimer` add the calling thread's allocation count & bytes to its stage.
+    void attachStageAllocTracking();
+
+    /**
+     * @brief Counts allocations the calling thread makes from construction until each `read`, e.g to check a budget of zero allocations over a steady-state `evalAt`.
+     * @note Other threads' allocations never show up here.
+     */
+    class AllocScope {
+    private:
+        AllocStats before;
+
+    public:
+        AllocScope();
+
+        [[nodiscard]] AllocStats read() const;
+    };
+}
+
+#endif
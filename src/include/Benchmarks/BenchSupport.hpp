@@ -0,0 +1,12 @@
+#ifndef BENCH_SUPPORT_HPP
+#define BENCH_SUPPORT_HPP
+
+#include <cstdint>
+#include "Benchmarks/AllocTracking.hpp"
+
+namespace GeneralDeriver::Benchmarks {
+    /// @note Process-wide peak resident set size in KiB, from `getrusage`.
+    [[nodiscard]] std::uint64_t readPeakRssKb();
+}
+
+#endif
@@ -0,0 +1,121 @@
+#ifndef MICRO_BENCH_HPP
+#define MICRO_BENCH_HPP
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Benchmarks/PerfCounters.hpp"
+
+namespace GeneralDeriver::Benchmarks {
+    /// @note Keeps the compiler from dropping a benchmarked result as dead code.
+    template <typename Tp>
+    inline void doNotOptimize(const Tp& value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    struct BenchOptions {
+        std::size_t warmup_runs = 2;
+        std::size_t repetitions = 10;
+        double min_rep_seconds = 0.02; // batch length each repetition is calibrated to
+        std::string filter;            // only cases whose name contains this
+        std::string json_path;
+        std::string baseline_path;
+        double threshold = 0.10;       // allowed median slowdown vs. the baseline
+        bool perf = false;             // read hardware counters over one extra batch per case
+    };
+
+    struct BenchStats {
+        std::string name;
+        std::size_t iterations; // per repetition
+        std::size_t repetitions;
+        double min_ns;
+        double median_ns;
+        double mean_ns;
+        double stddev_ns;
+        PerfReading perf_per_op {};    // empty unless counters were requested & available
+        std::size_t nodes_per_op = 0;  // expression nodes one op walks, 0 if not meaningful
+    };
+
+    /// @note Accepts `--filter S`, `--reps N`, `--warmup N`, `--min-time SECONDS`, `--json PATH`, `--compare PATH` and `--threshold FRACTION` and `--perf 0|1`.
+    [[nodiscard]] bool parseBenchOptions(int argc, char* argv[], BenchOptions& options);
+
+    [[nodiscard]] BenchStats summarizeSamples(std::string_view name, std::size_t iterations, std::vector<double>& samples_ns);
+
+    /**
+     * @brief Runner for per-operation microbenchmarks. Each case is calibrated to a batch of iterations lasting about `min_rep_seconds`, warmed up, then timed for several repetitions whose ns/op samples get summarized.
+     * @note Medians are compared against baselines, as they shrug off the odd preempted repetition.
+     */
+    class MicroBench {
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        BenchOptions options;
+        std::vector<BenchStats> results;
+        std::unique_ptr<PerfCounters> counters;
+
+        template <typename Body>
+        static double timeBatch(Body& body, std::size_t iterations) {
+            const auto start = Clock::now();
+
+            for (std::size_t i = 0; i < iterations; i++) {
+                body();
+            }
+
+            return std::chrono::duration<double>(Clock::now() - start).count();
+        }
+
+    public:
+        explicit MicroBench(const BenchOptions& options_);
+
+        /// @note With `perf` set, counters cover one more batch after the timed repetitions, so reading them never skews the timings.
+        template <typename Body>
+        void run(std::string_view name, Body&& body, std::size_t nodes_per_op = 0) {
+            if (!options.filter.empty() && name.find(options.filter) == std::string_view::npos) {
+                return;
+            }
+
+            std::size_t iterations = 1;
+
+            while (timeBatch(body, iterations) < options.min_rep_seconds && iterations < (std::size_t {1} << 30)) {
+                iterations *= 2;
+            }
+
+            for (std::size_t i = 0; i < options.warmup_runs; i++) {
+                timeBatch(body, iterations);
+            }
+
+            std::vector<double> samples_ns;
+
+            for (std::size_t i = 0; i < options.repetitions; i++) {
+                samples_ns.push_back(timeBatch(body, iterations) * 1e9 / static_cast<double>(iterations));
+            }
+
+            auto stats = summarizeSamples(name, iterations, samples_ns);
+            stats.nodes_per_op = nodes_per_op;
+
+            if (counters != nullptr) {
+                counters->start();
+                timeBatch(body, iterations);
+                stats.perf_per_op = counters->stop().scaledBy(static_cast<double>(iterations));
+            }
+
+            results.push_back(stats);
+        }
+
+        [[nodiscard]] const std::vector<BenchStats>& getResults() const;
+
+        void printSummary() const;
+
+        /// @note Prints per-op counter averages plus cycles per node where the case gave a node count. Does nothing for runs without counters.
+        void printPerfSummary() const;
+
+        [[nodiscard]] bool writeJson() const;
+
+        /// @note Prints each case next to its baseline median and returns the count of cases slower than the threshold allows. Cases missing from either side are listed but not counted.
+        [[nodiscard]] std::size_t compareBaseline() const;
+    };
+}
+
+#endif
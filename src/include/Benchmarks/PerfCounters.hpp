@@ -0,0 +1,66 @@
+#ifndef PERF_COUNTERS_HPP
+#define PERF_COUNTERS_HPP
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace GeneralDeriver::Benchmarks {
+    enum class PerfCounter : std::uint8_t {
+        cycles,
+        instructions,
+        branch_misses,
+        l1d_misses,  // L1 data cache read misses
+        llc_misses   // last level cache read misses
+    };
+
+    inline constexpr std::size_t perf_counter_count = 5;
+
+    [[nodiscard]] std::string_view getPerfCounterName(PerfCounter counter);
+
+    /// @brief Counts of one measured region. Counters the CPU or kernel refused stay invalid.
+    struct PerfReading {
+        std::array<double, perf_counter_count> counts {};
+        std::array<bool, perf_counter_count> valid {};
+
+        [[nodiscard]] bool hasAny() const;
+
+        [[nodiscard]] double get(PerfCounter counter) const;
+
+        [[nodiscard]] bool has(PerfCounter counter) const;
+
+        /// @brief Divides every count, e.g by iterations for per-op counts.
+        [[nodiscard]] PerfReading scaledBy(double divisor) const;
+    };
+
+    /**
+     * @brief Linux `perf_event_open` counters for the calling thread, counting user-space events only so the default `perf_event_paranoid` level allows them.
+     * @note Each counter is opened on its own, so one the CPU lacks does not lose the others. Counts get scaled by enabled / running time when the kernel multiplexes them. On other systems, or when the kernel refuses every counter, `isAvailable` is false and readings come back empty.
+     */
+    class PerfCounters {
+    private:
+        std::array<int, perf_counter_count> fds;
+        std::string open_error;
+
+    public:
+        PerfCounters();
+        ~PerfCounters();
+
+        PerfCounters(const PerfCounters& other) = delete;
+        PerfCounters& operator=(const PerfCounters& other) = delete;
+        PerfCounters(PerfCounters&& x_other) = delete;
+        PerfCounters& operator=(PerfCounters&& x_other) = delete;
+
+        [[nodiscard]] bool isAvailable() const;
+
+        /// @note Reason the first refused counter gave, empty if all opened.
+        [[nodiscard]] const std::string& getOpenError() const;
+
+        void start();
+
+        [[nodiscard]] PerfReading stop();
+    };
+}
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef FLAT_PARSER_HPP
+#define FLAT_PARSER_HPP
+
+#include <initializer_list>
+#include <string>
+#include "Frontend/Lexer.hpp"
+#include "Frontend/VariableTable.hpp"
+#include "Syntax/FlatAst.hpp"
+
+namespace GeneralDeriver::Frontend {
+    /**
+     * @brief Recursive descent parser with the same grammar as `Parser`, but appending nodes to a caller-owned `Syntax::FlatAst` instead of allocating one heap object per node.
+     * @note Parse errors are reported like `Parser::parseAll` does. The buffer's contents are unspecified after a failed parse.
+     */
+    class FlatParser {
+    private:
+        Lexer lexer;
+        VariableTable variables;
+        Token current;
+        Token previous;
+        Syntax::FlatAst* target;
+
+        const Token& peekCurrent() const;
+        Token advanceToken();
+        void consumeToken(std::initializer_list<TokenType> expected);
+
+        [[nodiscard]] Syntax::FlatIndex parseLiteral();
+        [[nodiscard]] Syntax::FlatIndex parseUnary();
+        [[nodiscard]] Syntax::FlatIndex parsePower();
+        [[nodiscard]] Syntax::FlatIndex parseFactor();
+        [[nodiscard]] Syntax::FlatIndex parseTerm();
+
+    public:
+        FlatParser();
+
+        FlatParser(const FlatParser& other) = delete;
+        FlatParser& operator=(const FlatParser& other) = delete;
+
+        FlatParser(FlatParser&& x_other) = delete;
+        FlatParser& operator=(FlatParser&& x_other) = delete;
+
+        /// @note Clears `buffer` first, keeping its capacity.
+        [[nodiscard]] bool parseAll(const std::string& source_arg, Syntax::FlatAst& buffer);
+    };
+}
+
+#endif
@@ -2,13 +2,20 @@
 #define LEXER_HPP
 
 #include "Frontend/Token.hpp"
+#include "Syntax/IAstNode.hpp"
 #include <string>
+#include <string_view>
 
 namespace GeneralDeriver::Frontend {
     [[nodiscard]] bool isSpacing(char s);
 
     [[nodiscard]] bool isNumeric(char s);
 
+    [[nodiscard]] bool isAlphabetic(char s);
+
+    /// @note Maps a `func_name` lexeme e.g "sin" to its op, or gives `AstOpType::none` for non-function words.
+    [[nodiscard]] Syntax::AstOpType getFunctionOp(std::string_view name);
+
     class Lexer {
     private:
         std::string source;
@@ -20,6 +27,7 @@ namespace GeneralDeriver::Frontend {
         Token lexSingle(TokenType type);
         Token lexSpacing();
         Token lexNumber();
+        Token lexWord();
 
     public:
         Lexer();
@@ -36,6 +44,9 @@ namespace GeneralDeriver::Frontend {
 
         const std::string& getSource() const;
 
+        /// @note Resumes lexing from a known token boundary, e.g for re-lexing only an edited region of the source.
+        void seekTo(std::size_t pos_);
+
         [[nodiscard]] Token lexNext();
     };
 }
@@ -4,7 +4,9 @@
 #include <initializer_list>
 #include <string>
 #include <memory>
+#include <vector>
 #include "Frontend/Lexer.hpp"
+#include "Frontend/VariableTable.hpp"
 #include "Syntax/IAstNode.hpp"
 
 namespace GeneralDeriver::Frontend {
@@ -20,13 +22,14 @@ namespace GeneralDeriver::Frontend {
 
     struct ParseResult {
         std::unique_ptr<Syntax::IAstNode> root;
+        std::vector<std::string> variables; // names by slot
         bool ok;
     };
 
-    /// TODO: implement parseFactor later on.
     class Parser {
     private:
         Lexer lexer;
+        VariableTable variables;
         Token current;
         Token previous;
 
@@ -38,7 +41,7 @@ namespace GeneralDeriver::Frontend {
         [[nodiscard]] std::unique_ptr<Syntax::IAstNode> parseLiteral();
         [[nodiscard]] std::unique_ptr<Syntax::IAstNode> parseUnary();
         [[nodiscard]] std::unique_ptr<Syntax::IAstNode> parsePower();
-        // [[nodiscard]] std::unique_ptr<Syntax::IAstNode> parseFactor();
+        [[nodiscard]] std::unique_ptr<Syntax::IAstNode> parseFactor();
         [[nodiscard]] std::unique_ptr<Syntax::IAstNode> parseTerm();
 
     public:
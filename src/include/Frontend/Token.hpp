@@ -5,16 +5,16 @@
 #include <string>
 
 namespace GeneralDeriver::Frontend {
-    /// TODO: enable times and slash operator support later.
     enum class TokenType : uint8_t {
         eos,
         spacing,
         number,
         variable,
+        func_name,
         op_plus,
         op_minus,
-        // op_times,
-        // op_slash,
+        op_times,
+        op_slash,
         op_power,
         l_paren,
         r_paren,
@@ -0,0 +1,28 @@
+#ifndef VARIABLE_TABLE_HPP
+#define VARIABLE_TABLE_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace GeneralDeriver::Frontend {
+    /**
+     * @brief Maps variable names to evaluation slots in order of first appearance. Slot 0 is always "x", so single-variable evaluation and d/dx keep working on multi-variable functions.
+     */
+    class VariableTable {
+    private:
+        std::vector<std::string> names;
+
+    public:
+        VariableTable();
+
+        /// @note Adds the name with the next free slot if it is new.
+        [[nodiscard]] std::size_t getSlot(std::string_view name);
+
+        [[nodiscard]] const std::vector<std::string>& getNames() const;
+
+        void clearState();
+    };
+}
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef COMPOSITE_HPP
 #define COMPOSITE_HPP
 
+#include <optional>
+#include "Models/DerivativeBudget.hpp"
 #include "Models/IFunction.hpp"
 #include "Models/FunctionAny.hpp"
 #include "Syntax/IAstNode.hpp"
@@ -20,7 +22,13 @@ namespace GeneralDeriver::Models {
     private:
         FunctionAny lhs_subject;     // "inner left" function
         FunctionAny rhs_subject;     // "inner right" function
+        double lhs_constant;         // value of a constant left child, cached to skip its virtual call
+        double rhs_constant;         // value of a constant right child
         Syntax::AstOpType op; // top operation of composite
+        bool lhs_is_constant;
+        bool rhs_is_constant;
+
+        [[nodiscard]] double applyOp(double lhs_val, double rhs_val) const;
 
     public:
         Composite();
@@ -37,13 +45,29 @@ namespace GeneralDeriver::Models {
 
         Syntax::AstOpType getOp() const;
         [[nodiscard]] CompositeArity getArity() const;
+        [[nodiscard]] const FunctionAny& getLeft() const;
+        [[nodiscard]] const FunctionAny& getRight() const;
+
+        /// @note Lets callers check a derivative against a `DerivativeBudget` before building it.
+        [[nodiscard]] FunctionCost estimateCost() const;
 
         FuncType getType() const override;
         double evalAt(double x) const override;
+        double evalAtPoint(std::span<const double> point) const override;
+        void evalBatch(std::span<const double> xs, std::span<double> out) const override;
         FunctionAny makeDerivative() const override;
         std::string toText() const override;
     };
 
+    /// @brief Gives the value of a constant leaf: a `Constant`, a polynomial of only a constant term, or either wrapped in `none` Composites.
+    [[nodiscard]] std::optional<double> getConstantLeaf(const FunctionAny& fn);
+
+    /// @note Applies the derivative rule of a binary op given already derived children, so callers holding cached child derivatives skip re-deriving them.
+    FunctionAny assembleDerivative(Syntax::AstOpType top_op, const FunctionAny& first_child, const FunctionAny& second_child, const FunctionAny& first_derived, const FunctionAny& second_derived);
+
+    /// @note Applies the derivative rule of a unary op given the already derived child. Function ops e.g sin use the chain rule, so they also take the child itself.
+    FunctionAny assembleDerivative(Syntax::AstOpType top_op, const FunctionAny& inner_child, const FunctionAny& inner_derived);
+
     /// @note This overload is for binary Composites e.g EMDAS arithmetic ops.
     FunctionAny deriveComposite(Syntax::AstOpType top_op, const FunctionAny& first_child, const FunctionAny& second_child);
 
@@ -0,0 +1,31 @@
+#ifndef CONSTANT_HPP
+#define CONSTANT_HPP
+
+#include "Models/IFunction.hpp"
+#include "Models/FunctionAny.hpp"
+
+namespace GeneralDeriver::Models {
+    /**
+     * @brief Leaf function of one fixed value, e.g `2` in `2 * sin(x)`.
+     * @note `Composite` reads constant children straight from `getValue` when built, so evaluating them costs no virtual call.
+     */
+    class Constant : public IFunction {
+    private:
+        double value;
+
+    public:
+        Constant();
+        explicit Constant(double value_);
+
+        [[nodiscard]] double getValue() const;
+
+        FuncType getType() const override;
+        double evalAt(double x) const override;
+        double evalAtPoint(std::span<const double> point) const override;
+        void evalBatch(std::span<const double> xs, std::span<double> out) const override;
+        FunctionAny makeDerivative() const override;
+        std::string toText() const override;
+    };
+}
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef DERIVATIVE_BUDGET_HPP
+#define DERIVATIVE_BUDGET_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "Models/IFunction.hpp"
+#include "Models/FunctionAny.hpp"
+#include "Models/Tape.hpp"
+
+namespace GeneralDeriver::Models {
+    /**
+     * @brief Size estimate of a function and of its eager symbolic derivative, found in one walk over the function's distinct nodes.
+     * @note `makeDerivative` re-derives a shared sub-function once per handle, so `derivative_nodes` counts shared nodes the same way. That keeps the estimate an upper bound for DAG-shaped inputs, whose eager derivatives can grow much faster than they do.
+     */
+    struct FunctionCost {
+        std::size_t node_count;       // distinct nodes of the function
+        std::size_t bytes;            // heap bytes of those nodes
+        std::size_t derivative_nodes; // nodes an eager `makeDerivative` allocates
+        std::size_t derivative_bytes;
+    };
+
+    /// @note Limits what one expression may allocate for its symbolic derivative. The defaults pass any hand-written formula, but not generated monsters e.g deep power towers.
+    struct DerivativeBudget {
+        std::size_t max_derivative_nodes = 1 << 16;
+        std::size_t max_derivative_bytes = 16 << 20;
+    };
+
+    enum class DerivativeStrategy : std::uint8_t {
+        symbolic,   // eager derivative tree from `makeDerivative`
+        dual_number // forward-mode evaluation of the source per point
+    };
+
+    struct BudgetedDerivative {
+        FunctionAny derivative;
+        FunctionCost cost;
+        DerivativeStrategy strategy;
+    };
+
+    [[nodiscard]] FunctionCost estimateCost(const IFunction& fn);
+
+    [[nodiscard]] bool fitsBudget(const FunctionCost& cost, const DerivativeBudget& budget);
+
+    /// @brief Derives symbolically when the estimate fits the budget, or else gives a `DualDerivative` of `fn`, which allocates nothing up front.
+    [[nodiscard]] BudgetedDerivative deriveWithinBudget(const FunctionAny& fn, const DerivativeBudget& budget);
+
+    /**
+     * @brief Numeric derivative strategy: evaluates f' by carrying value & slope through the source's `Tape` together, as dual numbers, so each point costs about two evaluations of f and no derivative nodes exist at all. The tape keeps shared sub-functions shared, so the sweep stays linear in distinct nodes even where the symbolic derivative would blow up.
+     * @note Unlike `LazyDerivative`, batches never materialize anything either, so memory stays at one tape. Sources without a tape fall back to `evalWithSlope`. Copies share the source & tape, and each thread reuses its own sweep buffer.
+     */
+    class DualDerivative : public IFunction {
+    private:
+        FunctionAny source;
+        std::shared_ptr<const Tape> tape; // null when the source has no tape
+
+    public:
+        DualDerivative();
+        explicit DualDerivative(const FunctionAny& source_);
+
+        [[nodiscard]] const FunctionAny& getSource() const;
+
+        FuncType getType() const override;
+        double evalAt(double x) const override;
+        double evalAtPoint(std::span<const double> point) const override;
+        void evalBatch(std::span<const double> xs, std::span<double> out) const override;
+
+        /// @note Gives an empty function, as the numeric strategy only covers first derivatives.
+        FunctionAny makeDerivative() const override;
+        std::string toText() const override;
+    };
+}
+
+#endif
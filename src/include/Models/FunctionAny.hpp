@@ -15,7 +15,7 @@ namespace GeneralDeriver::Models {
      * @tparam Tp 
      */
     template <typename Tp>
-    using naked_t = std::remove_reference_t<std::remove_cv_t<Tp>>;
+    using naked_t = std::remove_cvref_t<Tp>;
 
     /**
      * @brief Homemade, type-erasure based container for any algebraic function instance.
@@ -35,7 +35,7 @@ namespace GeneralDeriver::Models {
             using plain_func_t = naked_t<Tp>;
             std::shared_ptr<IFunction> ptr;
 
-            Storage(Tp& func) : ptr(std::make_shared<Tp>(func)) {}
+            Storage(const Tp& func) : ptr(std::make_shared<Tp>(func)) {}
 
             Storage(Tp&& x_func) : ptr(std::make_shared<Tp>(x_func)) {}
 
@@ -92,7 +92,8 @@ namespace GeneralDeriver::Models {
     public:
         constexpr FunctionAny() : storage_ptr {nullptr} {}
 
-        template <typename Tp>
+        /// @note Constrained so that copies from non-const FunctionAny lvalues still pick the copy constructor.
+        template <typename Tp> requires (!std::is_same_v<naked_t<Tp>, FunctionAny>)
         FunctionAny(Tp&& any_func) : storage_ptr(std::make_shared<Storage<naked_t<Tp>>>(any_func)) {}
 
         FunctionAny(const FunctionAny& other) {
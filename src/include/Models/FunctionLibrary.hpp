@@ -0,0 +1,156 @@
+#ifndef FUNCTION_LIBRARY_HPP
+#define FUNCTION_LIBRARY_HPP
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Models/FunctionAny.hpp"
+#include "Models/Polynomial.hpp"
+#include "Models/Tape.hpp"
+
+namespace GeneralDeriver::Models {
+    inline constexpr std::uint32_t library_version = 1;
+
+    /**
+     * @brief One function node of a library image. Operands are indices within the same function's node range, and always come earlier in it.
+     * @note `lhs` holds the constant pool index of a constant, the slot of a variable, or the first pool term of a polynomial. `rhs` holds the term count of a polynomial, or the exponent of an int_power as a two's complement `int32_t`.
+     */
+    struct LibraryNode {
+        std::uint32_t lhs;
+        std::uint32_t rhs;
+        TapeOp op;
+        std::uint8_t padding[3];
+    };
+
+    /**
+     * @brief File layout of a library image, all offsets counted from the file start so the image works at any mapping address:
+     *  - `LibraryHeader`
+     *  - `LibraryEntry` table, sorted by name
+     *  - constant pool of `double`, each distinct value once
+     *  - term pool of `PolynomialTerm`
+     *  - `LibraryNode` pool, each function's nodes in one run
+     *  - name bytes, without terminators
+     * @note Fields are host-endian. `byte_order` lets a reader on a different-endian host refuse the image.
+     */
+    struct LibraryHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t byte_order;
+        std::uint32_t entry_count;
+        std::uint32_t constant_count;
+        std::uint32_t term_count;
+        std::uint32_t node_count;
+        std::uint32_t name_bytes;
+        std::uint32_t reserved;
+        std::uint64_t entries_offset;
+        std::uint64_t constants_offset;
+        std::uint64_t terms_offset;
+        std::uint64_t nodes_offset;
+        std::uint64_t names_offset;
+    };
+
+    struct LibraryEntry {
+        std::uint32_t name_offset;
+        std::uint32_t name_length;
+        std::uint32_t slot_count;
+        std::uint32_t function_first; // first node in the node pool
+        std::uint32_t function_count;
+        std::uint32_t derivative_first;
+        std::uint32_t derivative_count; // 0 when there is no derivative rule
+        std::uint32_t reserved;
+    };
+
+    /**
+     * @brief View of one compiled function inside a library image. Evaluates straight from the image with one forward sweep, like `AdjointEvaluator` over a `Tape`.
+     * @note Only valid while its library stays open.
+     */
+    class LibraryFunction {
+    private:
+        std::span<const LibraryNode> nodes;
+        std::span<const double> constants;
+        std::span<const PolynomialTerm> terms;
+
+    public:
+        LibraryFunction();
+        LibraryFunction(std::span<const LibraryNode> nodes_, std::span<const double> constants_, std::span<const PolynomialTerm> terms_);
+
+        [[nodiscard]] bool isEmpty() const;
+
+        /// @note Scratch buffers for `evalAt` must hold at least this many values.
+        [[nodiscard]] std::size_t getNodeCount() const;
+
+        /// @note `point` must hold the entry's slot count of values. Gives 0 for an empty function.
+        [[nodiscard]] double evalAt(std::span<const double> point, std::span<double> scratch) const;
+    };
+
+    struct LibraryItem {
+        LibraryFunction function;
+        LibraryFunction derivative; // empty when there was no derivative rule
+        std::size_t slot_count;
+    };
+
+    /**
+     * @brief Collects named functions & their derivatives, then writes them as one library image. Each function goes through a `Tape` first, so shared sub-functions stay shared in the image.
+     * @note `addFunction` throws `std::invalid_argument` like `Tape` for function kinds without a tape op.
+     */
+    class LibraryWriter {
+    private:
+        struct PendingEntry {
+            std::string name;
+            Tape function;
+            Tape derivative;
+            bool has_derivative;
+        };
+
+        std::vector<PendingEntry> entries;
+
+    public:
+        LibraryWriter();
+
+        /// @note A later entry with the same name replaces the earlier one.
+        void addFunction(std::string_view name, const IFunction& fn, const FunctionAny& derivative);
+
+        [[nodiscard]] std::size_t getEntryCount() const;
+
+        [[nodiscard]] bool writeFile(const std::string& path) const;
+    };
+
+    /**
+     * @brief Read-only `mmap` of a library image. Opening checks only the header & section bounds, so its cost does not grow with the library. A lookup binary searches the sorted entry table and checks just the found function's links before handing out views.
+     * @note Move-only, since it owns the mapping.
+     */
+    class MappedLibrary {
+    private:
+        const std::byte* base;
+        std::size_t size;
+
+        [[nodiscard]] const LibraryHeader& getHeader() const;
+        [[nodiscard]] std::span<const LibraryEntry> getEntries() const;
+        [[nodiscard]] std::string_view getEntryName(const LibraryEntry& entry) const;
+        [[nodiscard]] std::optional<LibraryFunction> viewFunction(std::uint32_t first, std::uint32_t count, std::uint32_t slot_count) const;
+
+        MappedLibrary(const std::byte* base_, std::size_t size_);
+
+    public:
+        /// @brief Gives nothing for a missing file, a foreign or newer image, or section bounds past the file end.
+        [[nodiscard]] static std::optional<MappedLibrary> open(const std::string& path);
+
+        ~MappedLibrary();
+
+        MappedLibrary(const MappedLibrary& other) = delete;
+        MappedLibrary& operator=(const MappedLibrary& other) = delete;
+
+        MappedLibrary(MappedLibrary&& x_other) noexcept;
+        MappedLibrary& operator=(MappedLibrary&& x_other) noexcept;
+
+        [[nodiscard]] std::size_t getEntryCount() const;
+
+        /// @note Gives nothing for an unknown name or an entry with broken links.
+        [[nodiscard]] std::optional<LibraryItem> find(std::string_view name) const;
+    };
+}
+
+#endif
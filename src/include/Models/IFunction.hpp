@@ -1,16 +1,24 @@
 #ifndef I_FUNCTION_HPP
 #define I_FUNCTION_HPP
 
+#include <span>
 #include <string>
 
 namespace GeneralDeriver::Models {
     enum class FuncType {
         polynomial,
+        constant,
         identity,
+        int_power,
+        rational_function,
+        lazy_derivative,
+        dual_derivative,
         summation,
         difference,
         product,
         rational,
+        elementary,
+        variable,
         none
     };
 
@@ -18,7 +26,7 @@ namespace GeneralDeriver::Models {
     class FunctionAny;
 
     /**
-     * @brief Interface for common x-function operations.
+     * @brief Interface for common x-function operations. Functions of several variables get x as slot 0 of an evaluation point, and derivatives are always d/dx.
      */
     class IFunction {
     public:
@@ -26,6 +34,12 @@ namespace GeneralDeriver::Models {
 
         virtual FuncType getType() const = 0;
         virtual double evalAt(double x) const = 0;
+
+        /// @note Evaluates at a point holding one value per variable slot, where slot 0 is x. `evalAt(x)` is the same as this with the point `{x}`.
+        virtual double evalAtPoint(std::span<const double> point) const = 0;
+
+        /// @note Evaluates at every x of `xs` into the same index of `out`, which must be at least as long. Lets implementations amortize dispatch across many points.
+        virtual void evalBatch(std::span<const double> xs, std::span<double> out) const = 0;
         virtual FunctionAny makeDerivative() const = 0;
         virtual std::string toText() const = 0;
     };
@@ -0,0 +1,22 @@
+#ifndef IDENTITY_HPP
+#define IDENTITY_HPP
+
+#include "Models/IFunction.hpp"
+#include "Models/FunctionAny.hpp"
+
+namespace GeneralDeriver::Models {
+    /// @brief Leaf function f(x) = x, which emitters use for x instead of the polynomial `1x^1`.
+    class Identity : public IFunction {
+    public:
+        Identity();
+
+        FuncType getType() const override;
+        double evalAt(double x) const override;
+        double evalAtPoint(std::span<const double> point) const override;
+        void evalBatch(std::span<const double> xs, std::span<double> out) const override;
+        FunctionAny makeDerivative() const override;
+        std::string toText() const override;
+    };
+}
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef INT_POWER_HPP
+#define INT_POWER_HPP
+
+#include <cstdint>
+#include "Models/IFunction.hpp"
+#include "Models/FunctionAny.hpp"
+
+namespace GeneralDeriver::Models {
+    /// @brief Tells whether a constant exponent is whole and fits `IntPower`, leaving room for the `n - 1` of its derivative.
+    [[nodiscard]] bool isIntPowerExponent(double exponent);
+
+    /// @brief Raises a value to a whole power by repeated squaring. Negative exponents take the reciprocal of the positive power.
+    [[nodiscard]] double raiseToInteger(double base, std::int32_t exponent);
+
+    [[nodiscard]] float raiseToInteger(float base, std::int32_t exponent);
+
+    /**
+     * @brief Function u(x)^n for a constant whole n, e.g `sin(x)^3`. Evaluates by repeated squaring instead of `std::pow`.
+     * @note Derives to `n * u^(n - 1) * u'` without the exponent sub-tree a general power derivative needs.
+     */
+    class IntPower : public IFunction {
+    private:
+        FunctionAny base;
+        std::int32_t exponent;
+
+    public:
+        IntPower();
+        IntPower(const FunctionAny& base_, std::int32_t exponent_);
+
+        [[nodiscard]] const FunctionAny& getBase() const;
+        [[nodiscard]] std::int32_t getExponent() const;
+
+        /// @brief Applies the power rule given the already derived base, so callers holding it skip re-deriving the base.
+        [[nodiscard]] FunctionAny deriveWith(const FunctionAny& base_derived) const;
+
+        FuncType getType() const override;
+        double evalAt(double x) const override;
+        double evalAtPoint(std::span<const double> point) const override;
+        void evalBatch(std::span<const double> xs, std::span<double> out) const override;
+        FunctionAny makeDerivative() const override;
+        std::string toText() const override;
+    };
+}
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef LAZY_DERIVATIVE_HPP
+#define LAZY_DERIVATIVE_HPP
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include "Models/IFunction.hpp"
+#include "Models/FunctionAny.hpp"
+
+namespace GeneralDeriver::Models {
+    struct ValueSlope {
+        double value;
+        double slope;
+    };
+
+    /// @brief Forward-mode walk giving f and f' at one point together, as a dual number, without allocating any derivative node.
+    [[nodiscard]] ValueSlope evalWithSlope(const IFunction& fn, std::span<const double> point);
+
+    /// @brief Gives the derivative of a function, deferring every Composite & `IntPower` node behind a `LazyDerivative`. Leaves still derive right away, since their derivatives are no bigger than they are and the product rule needs to see their constant slopes.
+    [[nodiscard]] FunctionAny makeLazyDerivative(const FunctionAny& fn);
+
+    /**
+     * @brief Stands for "derivative of node N" until something reaches it. The first batch evaluation, `toText`, `getDerived` or compile to a `Tape` applies N's derivative rule once, over lazy derivatives of N's children, and caches that one level.
+     * @note Single-point evaluations before then walk N forward-mode, carrying each node's value & slope together, so one f'(x) costs about two evaluations of f and builds no derivative nodes at all. Copies share the cache, which is filled at most once even across threads.
+     */
+    class LazyDerivative : public IFunction {
+    private:
+        struct Cache {
+            std::once_flag filled;
+            std::atomic<bool> ready {false};
+            FunctionAny derived;
+        };
+
+        FunctionAny source;
+        std::shared_ptr<Cache> cache;
+
+    public:
+        LazyDerivative();
+        explicit LazyDerivative(const FunctionAny& source_);
+
+        [[nodiscard]] const FunctionAny& getSource() const;
+
+        /// @note Materializes one level on first call. Empty when the source has no derivative rule.
+        [[nodiscard]] const FunctionAny& getDerived() const;
+
+        [[nodiscard]] bool isMaterialized() const;
+
+        FuncType getType() const override;
+
+        /// @note Like an invalid Composite, a materialized derivative without a rule evaluates to 0.
+        double evalAt(double x) const override;
+        double evalAtPoint(std::span<const double> point) const override;
+        void evalBatch(std::span<const double> xs, std::span<double> out) const override;
+
+        /// @note Stays lazy: materializes this level only, then defers the next derivative's nodes the same way.
+        FunctionAny makeDerivative() const override;
+        std::string toText() const override;
+    };
+}
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef MATH_KERNELS_HPP
+#define MATH_KERNELS_HPP
+
+#include <span>
+
+namespace GeneralDeriver::Models {
+    /**
+     * @brief Batch kernels for elementary functions. Each one does range reduction plus a fixed polynomial on SIMD lanes (GCC / Clang vector extensions) instead of a libm call per x.
+     * @note Max. error vs. the C++ standard library, as checked by TestKernels:
+     *  - `expBatch`: 1 ULP for normal results; subnormal results lose precision like any scaled exp.
+     *  - `lnBatch`: 1 ULP for all positive inputs, subnormals included.
+     *  - `sinBatch` & `cosBatch`: 1 ULP for |x| <= 100, 2 ULP for |x| <= 1e6 from rounding in the pi/2 reduction. Lanes beyond 1e6 fall back to `std::sin` / `std::cos` since the 3-part reduction runs out of bits.
+     *  - `sqrtBatch`: 0 ULP, as IEEE square root is already one correctly rounded instruction.
+     * `out` must be at least as long as `xs`, and may be the same span.
+     */
+    void sinBatch(std::span<const double> xs, std::span<double> out);
+
+    void cosBatch(std::span<const double> xs, std::span<double> out);
+
+    void expBatch(std::span<const double> xs, std::span<double> out);
+
+    void lnBatch(std::span<const double> xs, std::span<double> out);
+
+    void sqrtBatch(std::span<const double> xs, std::span<double> out);
+
+    /// @note Single precision overloads of the above, correctly rounded from the double kernels' results except in rare double-rounding cases.
+    void sinBatch(std::span<const float> xs, std::span<float> out);
+
+    void cosBatch(std::span<const float> xs, std::span<float> out);
+
+    void expBatch(std::span<const float> xs, std::span<float> out);
+
+    void lnBatch(std::span<const float> xs, std::span<float> out);
+
+    void sqrtBatch(std::span<const float> xs, std::span<float> out);
+}
+
+#endif
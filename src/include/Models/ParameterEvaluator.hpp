@@ -0,0 +1,68 @@
+#ifndef PARAMETER_EVALUATOR_HPP
+#define PARAMETER_EVALUATOR_HPP
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Models/Tape.hpp"
+
+namespace GeneralDeriver::Models {
+    /// @brief Gives a parameter's index within a parameter block, from slot names as `Parser::parseAll` lists them. Slot 0 is x, so parameter i is slot i + 1.
+    [[nodiscard]] std::optional<std::size_t> findParameter(std::span<const std::string> slot_names, std::string_view name);
+
+    /// @brief Scalar type for a compiled function's evaluation, picked per function. Single precision halves the memory traffic & doubles the lanes of plain arithmetic, for callers that tolerate about 7 significant digits.
+    enum class Precision : std::uint8_t {
+        f32,
+        f64
+    };
+
+    /**
+     * @brief Late-bound evaluation of one compiled function over many parameter sets. Every variable slot past x is a parameter, e.g `a`, `b` & `c` of `a*(x - b)^2 + c`, so one tape of f and one of f' serve every set without parsing, emitting or deriving again. A parameter block holds `getParameterCount()` values for slots 1, 2, ... in order.
+     * @tparam Scalar `float` or `double`. Tape constants & polynomial terms get rounded to it once, at construction, and every op after that runs in it.
+     * @note Batches sweep the tape one block of lanes at a time, running each node across all lanes before the next, so dispatch costs once per node & block instead of per node & point, and elementary ops go through the SIMD batch kernels. Owns its sweep buffers, so calls do not allocate. Not for concurrent use: give each thread its own evaluator over a shared tape.
+     */
+    template <typename Scalar>
+    class BasicParameterEvaluator {
+    private:
+        struct ScalarTerm {
+            Scalar coeff;
+            double power;
+        };
+
+        const Tape* tape;
+        std::vector<Scalar> constants; // per node, so constant rows need no conversion per sweep
+        std::vector<ScalarTerm> terms;
+        std::vector<Scalar> values;    // node-major, one row of `lane_width` lanes per node
+        std::size_t parameter_count;
+
+        void sweepLanes(std::span<const Scalar> xs, std::span<const Scalar> params, std::size_t param_stride, std::size_t lane_begin, std::size_t lane_count);
+        void sweepAll(std::span<const Scalar> xs, std::span<const Scalar> params, std::size_t param_stride, std::span<Scalar> out);
+
+    public:
+        static constexpr std::size_t lane_width = 64;
+
+        /// @note The block may hold more parameters than the tape reads, so f & f' can share one block layout even when f' lost some of them. Throws `std::invalid_argument` when it holds fewer.
+        BasicParameterEvaluator(const Tape& tape_, std::size_t parameter_count_);
+
+        [[nodiscard]] std::size_t getParameterCount() const;
+
+        [[nodiscard]] Scalar evalAt(Scalar x, std::span<const Scalar> params);
+
+        /// @note Evaluates at every x of `xs` with one parameter block into the same index of `out`, which must be at least as long.
+        void evalBatch(std::span<const Scalar> xs, std::span<const Scalar> params, std::span<Scalar> out);
+
+        /// @note Evaluates at `xs[i]` with the i-th parameter set into `out[i]`. `param_sets` holds `xs.size()` blocks back to back.
+        void evalSets(std::span<const Scalar> xs, std::span<const Scalar> param_sets, std::span<Scalar> out);
+    };
+
+    extern template class BasicParameterEvaluator<float>;
+    extern template class BasicParameterEvaluator<double>;
+
+    using ParameterEvaluator = BasicParameterEvaluator<double>;
+    using SingleParameterEvaluator = BasicParameterEvaluator<float>;
+}
+
+#endif
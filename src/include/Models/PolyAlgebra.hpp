@@ -0,0 +1,56 @@
+#ifndef POLY_ALGEBRA_HPP
+#define POLY_ALGEBRA_HPP
+
+#include <optional>
+#include <vector>
+#include "Models/Polynomial.hpp"
+
+namespace GeneralDeriver::Models {
+    /**
+     * @brief Sorts terms by descending power, merges like powers and drops zero coefficients, which `Polynomial` construction already does. The zero polynomial lists one `0x^0` term.
+     * @note Every helper below returns its result in this canonical form, working on dense coefficients directly whenever the layouts allow.
+     */
+    [[nodiscard]] Polynomial normalizePolynomial(std::vector<PolynomialTerm> terms);
+
+    /// @brief Gives the value of a polynomial with no x-dependent terms, if it is one.
+    [[nodiscard]] std::optional<double> getConstantValue(const Polynomial& poly);
+
+    /// @brief Gives the degree of a polynomial whose powers are all whole and non-negative, i.e one that fits a dense coefficient list.
+    [[nodiscard]] std::optional<std::size_t> getDenseDegree(const Polynomial& poly);
+
+    [[nodiscard]] Polynomial addPolynomials(const Polynomial& lhs, const Polynomial& rhs);
+
+    [[nodiscard]] Polynomial subtractPolynomials(const Polynomial& lhs, const Polynomial& rhs);
+
+    [[nodiscard]] Polynomial negatePolynomial(const Polynomial& poly);
+
+    /// @note Divides each coefficient instead of multiplying by `1 / divisor`, so `x / 3` rounds like the unexpanded quotient.
+    [[nodiscard]] Polynomial dividePolynomial(const Polynomial& poly, double divisor);
+
+    /// @note Operands with dense degrees go through the `PolyKernels` multiply, which picks schoolbook, Karatsuba or FFT by length. Others multiply term by term.
+    [[nodiscard]] Polynomial multiplyPolynomials(const Polynomial& lhs, const Polynomial& rhs);
+
+    /// @note Expands by repeated squaring, densely when the base has a dense degree.
+    [[nodiscard]] Polynomial raisePolynomial(const Polynomial& base, unsigned int exponent);
+
+    [[nodiscard]] Polynomial derivePolynomial(const Polynomial& poly);
+
+    struct PolyDivision {
+        Polynomial quotient;
+        Polynomial remainder;
+    };
+
+    /// @note Long division, so both operands need dense degrees and the divisor must not be zero.
+    [[nodiscard]] std::optional<PolyDivision> dividePolynomials(const Polynomial& dividend, const Polynomial& divisor);
+
+    /// @brief Gives the quotient when the division leaves no remainder, up to rounding relative to the dividend's coefficients.
+    [[nodiscard]] std::optional<Polynomial> divideExactly(const Polynomial& dividend, const Polynomial& divisor);
+
+    /**
+     * @brief Gives the monic GCD of two polynomials with dense degrees by Euclid's algorithm, so coprime operands give 1.
+     * @note Each remainder is rescaled to monic and coefficients within rounding of zero get dropped, since floating remainders are never exactly zero. The GCD is only kept if it divides both operands exactly, otherwise the operands count as coprime, which is always a safe answer.
+     */
+    [[nodiscard]] std::optional<Polynomial> gcdPolynomials(const Polynomial& lhs, const Polynomial& rhs);
+}
+
+#endif
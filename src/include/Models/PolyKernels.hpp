@@ -0,0 +1,30 @@
+#ifndef POLY_KERNELS_HPP
+#define POLY_KERNELS_HPP
+
+#include <span>
+#include <vector>
+
+namespace GeneralDeriver::Models {
+    enum class MulMethod {
+        schoolbook, // O(n * m) term pairs, best for short operands
+        karatsuba,  // O(n^1.58) split products
+        fft         // O(n log n) complex convolution, only when its rounding error stays small
+    };
+
+    /**
+     * @brief Picks the multiplication method for dense coefficient lists by operand length and coefficient range.
+     * @note Karatsuba and FFT errors scale with the largest coefficients, so they are only picked when the coefficient ranges are narrow enough for every result coefficient to stay accurate, or when whole-number inputs make them exact. Wide ranges like the binomial coefficients of `(x + 1)^200` fall back to schoolbook.
+     */
+    [[nodiscard]] MulMethod pickMulMethod(std::span<const double> lhs, std::span<const double> rhs);
+
+    /// @brief Multiplies dense coefficient lists, where index i holds the coefficient of x^i. The result holds `lhs.size() + rhs.size() - 1` coefficients, or none if either operand is empty.
+    [[nodiscard]] std::vector<double> multiplyDense(std::span<const double> lhs, std::span<const double> rhs);
+
+    /// @note Forces one method regardless of size, mainly for tests and benchmarks. Forced FFT runs skip the accuracy guard.
+    [[nodiscard]] std::vector<double> multiplyDenseWith(MulMethod method, std::span<const double> lhs, std::span<const double> rhs);
+
+    /// @brief Raises a dense coefficient list to a whole power by repeated squaring, so only O(log exponent) products are taken.
+    [[nodiscard]] std::vector<double> raiseDense(std::span<const double> base, unsigned int exponent);
+}
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef POLYNOMIAL_HPP
 #define POLYNOMIAL_HPP
 
+#include <cstdint>
+#include <span>
 #include <vector>
 #include "Models/IFunction.hpp"
 #include "Models/FunctionAny.hpp"
@@ -11,21 +13,67 @@ namespace GeneralDeriver::Models {
         double power;
     };
 
+    enum class PolyLayout {
+        dense,   // coeffs[i] is the coefficient of x^i
+        sparse,  // whole non-negative powers, descending, as parallel int32 powers & coeffs
+        general  // any other powers e.g x^0.5 or x^-1, descending as PolynomialTerm
+    };
+
+    /**
+     * @brief Represents a sum of c * x^p terms. Construction merges like powers, drops zero coefficients and picks the storage layout: dense when the powers are whole, non-negative and mostly filled in, sparse when they are also mostly gaps e.g `x^10000 + 1`, and general otherwise.
+     * @note Dense evaluation is Horner's rule, and sparse evaluation is Horner's rule stepping over the gaps by repeated squaring.
+     */
     class Polynomial : public IFunction {
     private:
-        std::vector<PolynomialTerm> terms;
+        std::vector<double> coeffs;        // dense: by power; sparse: parallel to powers
+        std::vector<std::int32_t> powers;  // sparse only
+        std::vector<PolynomialTerm> terms; // general only
+        PolyLayout layout;
+
+        void adoptTerms(std::vector<PolynomialTerm>& terms_);
+        void adoptDense(std::vector<double>& coeffs_);
 
     public:
+        /// @brief Tells whether a whole-power polynomial of this degree & non-zero term count is cheaper dense than sparse.
+        [[nodiscard]] static bool prefersDense(std::size_t degree, std::size_t term_count);
+
+        /// @note Takes dense coefficients by power, but still switches to sparse when they are mostly zero.
+        [[nodiscard]] static Polynomial fromDense(std::vector<double> coeffs_);
+
         Polynomial();
 
         Polynomial(std::vector<PolynomialTerm>& terms_);
 
         Polynomial(std::vector<PolynomialTerm>&& x_terms_);
 
+        [[nodiscard]] PolyLayout getLayout() const;
+
+        /// @brief Counts non-zero terms. The zero polynomial has none.
+        [[nodiscard]] std::size_t getTermCount() const;
+
+        /// @note Empty unless the layout is dense.
+        [[nodiscard]] std::span<const double> getDenseCoeffs() const;
+
+        /// @note Empty unless the layout is sparse.
+        [[nodiscard]] std::span<const std::int32_t> getSparsePowers() const;
+
+        /// @note Empty unless the layout is sparse.
+        [[nodiscard]] std::span<const double> getSparseCoeffs() const;
+
+        /// @brief Lists the non-zero terms by descending power, whatever the layout. The zero polynomial gives one `0x^0` term.
+        [[nodiscard]] std::vector<PolynomialTerm> getTerms() const;
+
         FuncType getType() const override;
 
         [[nodiscard]] double evalAt(double x) const override;
 
+        [[nodiscard]] double evalAtPoint(std::span<const double> point) const override;
+
+        /// @brief Evaluates the derivative at x without building it.
+        [[nodiscard]] double evalSlopeAt(double x) const;
+
+        void evalBatch(std::span<const double> xs, std::span<double> out) const override;
+
         [[nodiscard]] FunctionAny makeDerivative() const override;
 
         std::string toText() const override;
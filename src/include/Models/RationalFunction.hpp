@@ -0,0 +1,43 @@
+#ifndef RATIONAL_FUNCTION_HPP
+#define RATIONAL_FUNCTION_HPP
+
+#include <optional>
+#include "Models/IFunction.hpp"
+#include "Models/FunctionAny.hpp"
+#include "Models/Polynomial.hpp"
+
+namespace GeneralDeriver::Models {
+    /**
+     * @brief Quotient of two polynomials in lowest terms, e.g `1 / (x^2 + 1)`. Both sides have whole non-negative powers and the denominator is monic, so equal quotients get equal coefficients.
+     * @note Derives by the square-free quotient rule: with g = gcd(D, D'), (N / D)' = (N'(D / g) - N(D' / g)) / (D(D / g)). Each order then grows the denominator by its square-free part instead of squaring it, so e.g the n-th derivative of `1 / (x^2 + 1)` has degree 2(n + 1) and not 2^(n + 1).
+     */
+    class RationalFunction : public IFunction {
+    private:
+        Polynomial numerator;
+        Polynomial denominator;
+
+    public:
+        /// @brief Cancels the GCD of both sides and makes the denominator monic. Gives nothing for a zero denominator or powers that are not whole & non-negative.
+        [[nodiscard]] static std::optional<RationalFunction> fromQuotient(const Polynomial& numerator_, const Polynomial& denominator_);
+
+        RationalFunction();
+
+        /// @note Takes both sides as given, so callers with unreduced sides go through `fromQuotient`.
+        RationalFunction(const Polynomial& numerator_, const Polynomial& denominator_);
+
+        [[nodiscard]] const Polynomial& getNumerator() const;
+        [[nodiscard]] const Polynomial& getDenominator() const;
+
+        /// @brief Tells whether the denominator reduced to 1, leaving just the numerator.
+        [[nodiscard]] bool isPolynomial() const;
+
+        FuncType getType() const override;
+        double evalAt(double x) const override;
+        double evalAtPoint(std::span<const double> point) const override;
+        void evalBatch(std::span<const double> xs, std::span<double> out) const override;
+        FunctionAny makeDerivative() const override;
+        std::string toText() const override;
+    };
+}
+
+#endif
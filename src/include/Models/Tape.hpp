@@ -0,0 +1,82 @@
+#ifndef TAPE_HPP
+#define TAPE_HPP
+
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "Models/IFunction.hpp"
+#include "Models/Polynomial.hpp"
+
+namespace GeneralDeriver::Models {
+    enum class TapeOp : std::uint8_t {
+        constant,
+        variable,
+        polynomial,
+        add,
+        sub,
+        mul,
+        div,
+        power,
+        int_power,
+        neg,
+        sin,
+        cos,
+        exp,
+        ln,
+        sqrt
+    };
+
+    /// @brief One tape instruction. Operands always come earlier on the tape.
+    struct TapeNode {
+        double value;       // constant value, or exponent of an int_power
+        std::uint32_t lhs;  // first operand, slot of a variable, or first term of a polynomial
+        std::uint32_t rhs;  // second operand, or term count of a polynomial
+        TapeOp op;
+    };
+
+    /**
+     * @brief Flat, topologically ordered copy of a function tree. Sub-functions shared by `FunctionAny` handles, as in emitted derivatives, get one node.
+     * @note Polynomial leaves stay whole as x-polynomials over a shared term pool instead of expanding into power & add nodes.
+     */
+    class Tape {
+    private:
+        std::vector<TapeNode> nodes;
+        std::vector<PolynomialTerm> terms;
+        std::size_t slot_count;
+
+    public:
+        Tape();
+
+        /// @note Throws `std::invalid_argument` for a function kind without a tape op.
+        explicit Tape(const IFunction& root);
+
+        [[nodiscard]] const std::vector<TapeNode>& getNodes() const;
+        [[nodiscard]] const std::vector<PolynomialTerm>& getTerms() const;
+
+        /// @note Evaluation points must hold at least this many values.
+        [[nodiscard]] std::size_t getSlotCount() const;
+    };
+
+    /**
+     * @brief Reverse-mode (adjoint) evaluator over a `Tape`. One forward sweep stores every node value, then one backward sweep pushes each node's adjoint to its operands, so the full gradient costs a small constant times one evaluation no matter how many variables there are.
+     * @note Owns its sweep buffers, so repeated calls do not allocate. Not for concurrent use: give each thread its own evaluator over a shared tape.
+     */
+    class AdjointEvaluator {
+    private:
+        const Tape* tape;
+        std::vector<double> values;
+        std::vector<double> adjoints;
+
+        void sweepForward(std::span<const double> point);
+
+    public:
+        explicit AdjointEvaluator(const Tape& tape_);
+
+        [[nodiscard]] double evalAt(std::span<const double> point);
+
+        /// @note Writes df/d(slot i) into `gradient[i]`, which must hold `getSlotCount()` values, and returns f at the point.
+        double gradientAt(std::span<const double> point, std::span<double> gradient);
+    };
+}
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef TEXT_WRITER_HPP
+#define TEXT_WRITER_HPP
+
+#include <string>
+#include "Models/IFunction.hpp"
+
+namespace GeneralDeriver::Models {
+    /**
+     * @brief Writes a function as infix text in time & space linear in its distinct nodes. Every non-leaf node reached through more than one `FunctionAny` handle, as in derivatives of nested powers, is written once as a `let tN = ...;` line before the final expression, which then names it.
+     * @note The output buffer gets reserved to an upper bound of the text length up front, so writing never reallocates. Numbers are written by `std::to_chars` in shortest round-trip form, and parentheses only appear where precedence needs them.
+     */
+    [[nodiscard]] std::string writeText(const IFunction& root);
+}
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef VARIABLE_HPP
+#define VARIABLE_HPP
+
+#include <string>
+#include "Models/IFunction.hpp"
+#include "Models/FunctionAny.hpp"
+
+namespace GeneralDeriver::Models {
+    /**
+     * @brief Leaf function reading one slot of the evaluation point, e.g `y` in `x^2 + y`. Slot 0 is x itself, although emitters use the `Identity` leaf for that.
+     * @note Single-x evaluation has no value for other slots, so it yields NaN for them. Derivatives are d/dx, so any slot but 0 derives to 0.
+     */
+    class Variable : public IFunction {
+    private:
+        std::string name;
+        std::size_t slot;
+
+    public:
+        Variable();
+        Variable(const std::string& name_, std::size_t slot_);
+
+        [[nodiscard]] const std::string& getName() const;
+        [[nodiscard]] std::size_t getSlot() const;
+
+        FuncType getType() const override;
+        double evalAt(double x) const override;
+        double evalAtPoint(std::span<const double> point) const override;
+        void evalBatch(std::span<const double> xs, std::span<double> out) const override;
+        FunctionAny makeDerivative() const override;
+        std::string toText() const override;
+    };
+}
+
+#endif
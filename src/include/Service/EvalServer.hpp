@@ -0,0 +1,108 @@
+#ifndef EVAL_SERVER_HPP
+#define EVAL_SERVER_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Models/Composite.hpp"
+#include "Models/DerivativeBudget.hpp"
+#include "Models/FunctionAny.hpp"
+
+namespace GeneralDeriver::Service {
+    struct ServiceStats {
+        std::uint64_t requests;
+        std::uint64_t evaluations;
+        std::uint64_t batches;       // evalBatch runs, one per distinct formula per loop pass
+        std::uint64_t largest_batch;
+        std::uint64_t errors;
+        std::uint64_t numeric_derivatives; // compiles that went over the derivative budget & fell back to dual numbers
+        std::size_t cached_formulas;
+        double p50_us;               // percentiles over the most recent request latencies
+        double p90_us;
+        double p99_us;
+        double max_us;
+    };
+
+    /**
+     * @brief Evaluation service on a Unix domain stream socket, driven by one epoll loop. Clients send newline-terminated requests and get one reply line per request, in request order:
+     *  - `eval X EXPR` replies `ok F DF` with f(X) & f'(X) to 17 significant digits, or `error REASON`. `DF` is `nan` for functions without a derivative rule.
+     *  - `stats` replies `ok` followed by `key=value` pairs of `ServiceStats`.
+     * @note Each distinct formula text goes through parse, validate, emit & derive once and stays cached. Formulas whose symbolic derivative would go over the server's `DerivativeBudget` get a `DualDerivative` instead, so one pathological request cannot stall the loop. Every loop pass first reads all ready connections, then evaluates the pass's `eval` requests grouped by formula with one `evalBatch` call per group, so concurrent clients asking for the same function share the dispatch cost.
+     */
+    class EvalServer {
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct CompiledFormula {
+            Models::Composite function;
+            Models::FunctionAny derivative;
+            std::string error; // empty on success
+        };
+
+        struct Connection {
+            std::string input;
+            std::string output;
+            std::vector<std::string> replies; // slots of this loop pass, filled in request order or by batching
+            std::uint32_t interest;           // epoll events currently registered
+            bool closing;                     // peer is done sending or broke the protocol
+        };
+
+        struct PendingEval {
+            int fd;
+            std::size_t reply_slot;
+            double x;
+            const CompiledFormula* formula;
+            Clock::time_point received;
+        };
+
+        std::string socket_path;
+        Models::DerivativeBudget derivative_budget;
+        std::unordered_map<std::string, CompiledFormula> formulas;
+        std::unordered_map<int, Connection> connections;
+        std::vector<PendingEval> pending;
+        std::vector<double> latency_samples_us; // ring of recent latencies
+        std::size_t latency_next;
+        ServiceStats stats;
+        int listen_fd;
+        int epoll_fd;
+        int stop_fd; // eventfd, so stopping is safe from other threads & signal handlers
+
+        [[nodiscard]] const CompiledFormula& compileFormula(std::string_view source);
+
+        void acceptClients();
+        void readClient(int fd, Connection& conn, Clock::time_point now);
+        void handleLine(int fd, Connection& conn, std::string_view line, Clock::time_point now);
+        void runBatches();
+        void noteLatency(Clock::time_point received);
+        void flushClient(int fd, Connection& conn);
+        void closeClient(int fd);
+
+        [[nodiscard]] std::string formatStats() const;
+
+    public:
+        explicit EvalServer(std::string socket_path_, Models::DerivativeBudget derivative_budget_ = {});
+        ~EvalServer();
+
+        EvalServer(const EvalServer& other) = delete;
+        EvalServer& operator=(const EvalServer& other) = delete;
+        EvalServer(EvalServer&& x_other) = delete;
+        EvalServer& operator=(EvalServer&& x_other) = delete;
+
+        /// @brief Binds & listens on the socket path, replacing a stale socket file there. Gives false with `errno` set on failure.
+        [[nodiscard]] bool start();
+
+        /// @brief Serves clients until `requestStop`, then returns the final statistics.
+        [[nodiscard]] ServiceStats run();
+
+        /// @note Async-signal-safe, and callable from any thread.
+        void requestStop();
+
+        /// @note Loop thread only, e.g after `run` returns.
+        [[nodiscard]] ServiceStats readStats() const;
+    };
+}
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <any>
 #include <memory>
+#include <string>
 #include "Syntax/IAstNode.hpp"
 
 namespace GeneralDeriver::Syntax {
@@ -22,9 +23,18 @@ namespace GeneralDeriver::Syntax {
         Models::Composite acceptVisitor(IAstVisitor<Models::Composite>& visitor) const override;
     };
 
+    /// @brief Named variable. The slot indexes its value within an evaluation point, with "x" always at slot 0.
     class VarStub : public IAstNode {
+    private:
+        std::string name;
+        std::size_t slot;
+
     public:
-        VarStub() = default;
+        VarStub();
+        VarStub(const std::string& name_, std::size_t slot_);
+
+        [[nodiscard]] const std::string& getName() const;
+        [[nodiscard]] std::size_t getSlot() const;
 
         AstNodeType getType() const override;
         AstOpType getOp() const override;
@@ -42,6 +52,7 @@ namespace GeneralDeriver::Syntax {
         Unary(AstOpType op_, std::unique_ptr<IAstNode>&& x_inner);
 
         const std::unique_ptr<IAstNode>& getInnerPtr() const;
+        std::unique_ptr<IAstNode>& getInnerPtr();
 
         AstNodeType getType() const override;
         AstOpType getOp() const override;
@@ -61,6 +72,8 @@ namespace GeneralDeriver::Syntax {
 
         const std::unique_ptr<IAstNode>& getLeft() const;
         const std::unique_ptr<IAstNode>& getRight() const;
+        std::unique_ptr<IAstNode>& getLeft();
+        std::unique_ptr<IAstNode>& getRight();
 
         AstNodeType getType() const override;
         AstOpType getOp() const override;
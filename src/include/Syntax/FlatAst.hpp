@@ -0,0 +1,68 @@
+#ifndef FLAT_AST_HPP
+#define FLAT_AST_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Syntax/IAstNode.hpp"
+
+namespace GeneralDeriver::Syntax {
+    enum class FlatTag : uint8_t {
+        constant,
+        variable,
+        unary,
+        binary
+    };
+
+    using FlatIndex = std::uint32_t;
+
+    /**
+     * @brief Structure-of-arrays AST: node i is `(tags[i], ops[i], lefts[i], rights[i])`, with number values in a separate pool. Nodes are appended in post-order, so every child index is below its parent's and passes run as plain forward loops.
+     * @note `clear` keeps every array's capacity, so one buffer reused across parses stops allocating once it has seen its largest expression.
+     */
+    class FlatAst {
+    private:
+        std::vector<FlatTag> tags;
+        std::vector<AstOpType> ops;
+        std::vector<FlatIndex> lefts;  // first child, constant pool index, or variable slot
+        std::vector<FlatIndex> rights; // second child of binary nodes
+        std::vector<double> constants;
+        std::vector<std::string> variable_names; // names by slot
+
+        FlatIndex pushNode(FlatTag tag, AstOpType op, FlatIndex left, FlatIndex right);
+
+    public:
+        FlatAst();
+
+        FlatIndex addConstant(double value);
+        FlatIndex addVariable(std::size_t slot);
+        FlatIndex addUnary(AstOpType op, FlatIndex inner);
+        FlatIndex addBinary(AstOpType op, FlatIndex lhs, FlatIndex rhs);
+
+        /// @note Turns a node into a constant in place. Its former children stay in the arrays, but nothing reaches them anymore.
+        void rewriteConstant(FlatIndex node, double value);
+
+        void setVariableNames(const std::vector<std::string>& names);
+
+        [[nodiscard]] std::size_t getSize() const;
+        [[nodiscard]] bool isEmpty() const;
+
+        /// @note Node slots the arrays can hold before reallocating.
+        [[nodiscard]] std::size_t getCapacity() const;
+
+        /// @note The root is always the last node.
+        [[nodiscard]] FlatIndex getRoot() const;
+
+        [[nodiscard]] FlatTag getTag(FlatIndex node) const;
+        [[nodiscard]] AstOpType getOp(FlatIndex node) const;
+        [[nodiscard]] FlatIndex getLeft(FlatIndex node) const;
+        [[nodiscard]] FlatIndex getRight(FlatIndex node) const;
+        [[nodiscard]] double getConstant(FlatIndex node) const;
+        [[nodiscard]] std::size_t getSlot(FlatIndex node) const;
+        [[nodiscard]] const std::vector<std::string>& getVariableNames() const;
+
+        void clear();
+    };
+}
+
+#endif
@@ -2,6 +2,7 @@
 #define I_AST_NODE_HPP
 
 #include <any>
+#include <cstdint>
 #include "Syntax/IAstVisitor.hpp"
 
 namespace GeneralDeriver::Models {
@@ -17,9 +18,19 @@ namespace GeneralDeriver::Syntax {
         mul,
         div,
         power,
+        sin,
+        cos,
+        exp,
+        ln,
+        sqrt,
         none
     };
 
+    /// @note Elementary function calls are unary ops taking their argument as the sole child.
+    [[nodiscard]] constexpr bool isFunctionOp(AstOpType op) {
+        return op == AstOpType::sin || op == AstOpType::cos || op == AstOpType::exp || op == AstOpType::ln || op == AstOpType::sqrt;
+    }
+
     /// @note Denotes only types of expressions e.g constants.
     enum class AstNodeType : uint8_t {
         literal,
@@ -0,0 +1,15 @@
+#ifndef TEST_SUPPORT_HPP
+#define TEST_SUPPORT_HPP
+
+#include <string>
+#include "Models/Composite.hpp"
+
+namespace GeneralDeriver::Tests {
+    /// @note Relative to `expected`, but absolute once its magnitude drops below 1, so values near zero still compare.
+    [[nodiscard]] bool isClose(double actual, double expected, double tolerance = 1e-12);
+
+    /// @note Parses & emits a test source known to be valid, without validation.
+    [[nodiscard]] Models::Composite emitSource(const std::string& source);
+}
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef EXPR_GENERATOR_HPP
+#define EXPR_GENERATOR_HPP
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace GeneralDeriver::Utils {
+    /// @brief Shape knobs for generated expressions. Chances are in [0, 1].
+    struct ExprGenConfig {
+        std::uint64_t seed = 42;
+        std::size_t max_depth = 3;         // max. nesting of parentheses & calls
+        std::size_t max_terms = 4;         // max. `+` / `-` operands per term
+        std::size_t max_factors = 1;       // max. `*` / `/` operands per factor
+        std::size_t variable_count = 1;    // 1 uses only x, then y, z, w, v4, v5...
+        double nest_chance = 0.3;          // literal becomes a parenthesized term or call
+        double call_chance = 0.5;          // nested literal is a call instead of parentheses
+        double negate_chance = 0.1;
+        double power_chance = 0.4;         // power gets an exponent
+        std::uint32_t max_exponent = 5;    // exponents are in [1, max_exponent]
+        double half_exponent_chance = 0.1; // exponent gets a .5 added
+    };
+
+    /**
+     * @brief Seeded generator of random expressions that follow Grammar.md, for benchmark corpora.
+     * @note Draws plain `std::mt19937_64` output without standard distributions, whose results differ between standard libraries, so a seed gives the same corpus everywhere. Generated text is always grammatical, but constant-only sub-expressions like `ln(2 - 5)` can still fail validation.
+     */
+    class ExprGenerator {
+    private:
+        ExprGenConfig config;
+        std::mt19937_64 rng;
+        std::string out;
+
+        [[nodiscard]] double drawUnit();
+        [[nodiscard]] std::size_t drawBelow(std::size_t bound);
+        [[nodiscard]] bool drawChance(double chance);
+
+        void emitNumber();
+        void emitVariable();
+        void emitLiteral(std::size_t depth);
+        void emitUnary(std::size_t depth);
+        void emitPower(std::size_t depth);
+        void emitFactor(std::size_t depth);
+        void emitTerm(std::size_t depth);
+
+    public:
+        explicit ExprGenerator(const ExprGenConfig& config_);
+
+        [[nodiscard]] std::string generate();
+
+        [[nodiscard]] std::vector<std::string> generateCorpus(std::size_t count);
+    };
+}
+
+#endif
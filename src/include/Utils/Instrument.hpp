@@ -0,0 +1,113 @@
+#ifndef INSTRUMENT_HPP
+#define INSTRUMENT_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+
+namespace GeneralDeriver::Utils {
+    /// @note Builds configured with `-DDO_INSTRUMENT=OFF` compile every probe below to nothing.
+#ifdef GD_INSTRUMENT
+    inline constexpr bool instrument_enabled = true;
+#else
+    inline constexpr bool instrument_enabled = false;
+#endif
+
+    enum class Stage : std::uint8_t {
+        lex,
+        parse,
+        validate,
+        emit,
+        derive,
+        eval,
+        other // nodes made outside any timed stage
+    };
+
+    inline constexpr std::size_t stage_count = 7;
+
+    [[nodiscard]] std::string_view getStageName(Stage stage);
+
+    struct StageStats {
+        std::uint64_t calls;       // finished timers
+        std::uint64_t nanoseconds; // wall time summed over calls
+        std::uint64_t nodes;       // tokens, AST nodes or function nodes created
+        std::uint64_t allocations; // only counted once `setAllocReader` is given a reader
+        std::uint64_t alloc_bytes;
+    };
+
+    struct PipelineStats {
+        std::array<StageStats, stage_count> stages;
+        std::uint64_t peak_tree_size;
+    };
+
+    namespace detail {
+        inline std::array<std::atomic<std::uint64_t>, stage_count> node_counts {};
+        inline std::atomic<std::uint64_t> peak_tree_size {0};
+        inline thread_local Stage current_stage = Stage::other;
+    }
+
+    /// @note Called by node constructors, so the count lands on whichever stage the calling thread is timing.
+    inline void noteNodes(std::uint64_t count) {
+        if constexpr (instrument_enabled) {
+            detail::node_counts[static_cast<std::size_t>(detail::current_stage)].fetch_add(count, std::memory_order_relaxed);
+        }
+    }
+
+    /// @brief Keeps the largest tree size noted so far, e.g the node count of an emitted function or its derivative.
+    inline void noteTreeSize(std::uint64_t size) {
+        if constexpr (instrument_enabled) {
+            auto peak = detail::peak_tree_size.load(std::memory_order_relaxed);
+
+            while (size > peak && !detail::peak_tree_size.compare_exchange_weak(peak, size, std::memory_order_relaxed)) {}
+        }
+    }
+
+    struct AllocTotals {
+        std::uint64_t count;
+        std::uint64_t bytes;
+    };
+
+    /// @brief Source of the calling thread's running allocation totals, e.g from a counting `operator new`. The library has none of its own, since replacing `operator new` is the program's call.
+    using AllocReader = AllocTotals (*)();
+
+    void setAllocReader(AllocReader reader);
+
+    /**
+     * @brief Scoped timer of one pipeline stage. Adds its wall time, allocation count & bytes to the stage's totals when it ends, and records a trace event while tracing is on.
+     * @note Nested timers count inclusively, and nodes noted inside a nested timer go to the inner stage.
+     */
+    class StageTimer {
+    private:
+        std::chrono::steady_clock::time_point start;
+        AllocTotals allocs_before;
+        Stage stage;
+        Stage outer_stage;
+
+    public:
+        explicit StageTimer(Stage stage_);
+        ~StageTimer();
+
+        StageTimer(const StageTimer& other) = delete;
+        StageTimer& operator=(const StageTimer& other) = delete;
+        StageTimer(StageTimer&& x_other) = delete;
+        StageTimer& operator=(StageTimer&& x_other) = delete;
+    };
+
+    [[nodiscard]] PipelineStats readStats();
+
+    /// @note Also drops recorded trace events.
+    void resetStats();
+
+    void printStats(std::ostream& out, const PipelineStats& stats);
+
+    /// @brief Starts recording one complete ("X" phase) trace event per finished `StageTimer`.
+    void startTrace();
+
+    /// @brief Writes recorded events as Chrome trace-event JSON, loadable by `chrome://tracing` or Perfetto.
+    void writeChromeTrace(std::ostream& out);
+}
+
+#endif